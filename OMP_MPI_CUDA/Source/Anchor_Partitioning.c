@@ -0,0 +1,327 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "Anchor_Partitioning.h"
+//Base of the rolling hash of the k-mers
+#define KMER_BASE 1099511628211ull
+
+/**
+ * @brief A k-mer of the hash table, with its occurrences in the two strings.
+ */
+typedef struct {
+    uint64_t hash;  /**< Rolling hash of the k-mer. */
+    int pos1;       /**< Last position in the first string. */
+    int pos2;       /**< Last position in the second string. */
+    int count1;     /**< Occurrences in the first string. */
+    int count2;     /**< Occurrences in the second string (0 if the slot is empty). */
+} KmerEntry;
+
+/**
+ * @brief A pair of positions of the same unique k-mer in the two strings.
+ */
+typedef struct {
+    int pos1;
+    int pos2;
+} Anchor;
+
+/**
+ * @brief Mixes the rolling hash of a k-mer into the slot of the table.
+ */
+static inline uint64_t mixHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * @brief Returns the slot of a k-mer: its entry, or the empty slot where it would be inserted.
+ */
+static KmerEntry* findKmer(KmerEntry* table, size_t mask, uint64_t hash) {
+    size_t slot = mixHash(hash) & mask;
+    while (table[slot].count2 != 0 && table[slot].hash != hash)
+        slot = (slot + 1) & mask;
+    return &table[slot];
+}
+
+/**
+ * @brief Proportional cut point of a string, as partitioning() computes it.
+ */
+static int proportionalCut(int len, int id, int n_id) {
+    int local_len = len / n_id;
+    int remaining = len % n_id;
+    return id * local_len + ((id < remaining) ? id : remaining);
+}
+
+/**
+ * @brief Collects the k-mers that occur exactly once in each string, in increasing order on the first string.
+ *
+ * @return The number of anchors, -1 if memory allocation fails.
+ */
+static int uniqueAnchors(const char* str1, int len1, const char* str2, int len2, Anchor** anchors) {
+    int n_kmers2 = len2 - ANCHOR_KMER + 1;
+    size_t capacity = 1;
+    while (capacity < 2 * (size_t)n_kmers2)
+        capacity *= 2;
+
+    KmerEntry* table = (KmerEntry*)calloc(capacity, sizeof(KmerEntry));
+    if (table == NULL)
+        return -1;
+
+    // Weight of the character that leaves the window
+    uint64_t top = 1;
+    for (int i = 1; i < ANCHOR_KMER; i++)
+        top *= KMER_BASE;
+
+    // Count the k-mers of the second string
+    uint64_t hash = 0;
+    for (int i = 0; i < len2; i++) {
+        if (i >= ANCHOR_KMER)
+            hash -= top * (unsigned char)str2[i - ANCHOR_KMER];
+        hash = hash * KMER_BASE + (unsigned char)str2[i];
+        if (i >= ANCHOR_KMER - 1) {
+            KmerEntry* entry = findKmer(table, capacity - 1, hash);
+            entry->hash = hash;
+            entry->pos2 = i - ANCHOR_KMER + 1;
+            entry->count2++;
+        }
+    }
+
+    // Count the occurrences of the same k-mers in the first string
+    hash = 0;
+    for (int i = 0; i < len1; i++) {
+        if (i >= ANCHOR_KMER)
+            hash -= top * (unsigned char)str1[i - ANCHOR_KMER];
+        hash = hash * KMER_BASE + (unsigned char)str1[i];
+        if (i >= ANCHOR_KMER - 1) {
+            KmerEntry* entry = findKmer(table, capacity - 1, hash);
+            if (entry->count2 != 0) {
+                entry->pos1 = i - ANCHOR_KMER + 1;
+                entry->count1++;
+            }
+        }
+    }
+
+    // Keep the k-mers unique in both strings (the characters are compared, against collisions of the hash)
+    *anchors = (Anchor*)malloc(((size_t)n_kmers2 + 1) * sizeof(Anchor));
+    if (*anchors == NULL) {
+        free(table);
+        return -1;
+    }
+    int n_anchors = 0;
+    for (size_t s = 0; s < capacity; s++) {
+        KmerEntry* entry = &table[s];
+        if (entry->count1 == 1 && entry->count2 == 1 && memcmp(str1 + entry->pos1, str2 + entry->pos2, ANCHOR_KMER) == 0) {
+            (*anchors)[n_anchors].pos1 = entry->pos1;
+            (*anchors)[n_anchors].pos2 = entry->pos2;
+            n_anchors++;
+        }
+    }
+    free(table);
+
+    // Order the anchors on the first string, with a counting sort on the positions
+    int* first = (int*)malloc(((size_t)len1 + 1) * sizeof(int));
+    Anchor* sorted = (Anchor*)malloc(((size_t)n_anchors + 1) * sizeof(Anchor));
+    if (first == NULL || sorted == NULL) {
+        free(first);
+        free(sorted);
+        free(*anchors);
+        return -1;
+    }
+    for (int i = 0; i <= len1; i++)
+        first[i] = -1;
+    for (int a = 0; a < n_anchors; a++)
+        first[(*anchors)[a].pos1] = a;
+    int n_sorted = 0;
+    for (int i = 0; i <= len1; i++)
+        if (first[i] >= 0)
+            sorted[n_sorted++] = (*anchors)[first[i]];
+    free(first);
+    free(*anchors);
+    *anchors = sorted;
+
+    return n_anchors;
+}
+
+/**
+ * @brief Keeps the longest chain of anchors increasing on both strings, removing the ones that cross it.
+ *
+ * The anchors are already in increasing order on the first string: the chain is the longest
+ * increasing subsequence of their positions on the second string (patience sorting).
+ *
+ * @return The number of anchors of the chain, moved to the beginning of the array; -1 if memory allocation fails.
+ */
+static int chainAnchors(Anchor* anchors, int n_anchors) {
+    int* tails = (int*)malloc((n_anchors + 1) * sizeof(int));
+    int* previous = (int*)malloc((n_anchors + 1) * sizeof(int));
+    if (tails == NULL || previous == NULL) {
+        free(tails);
+        free(previous);
+        return -1;
+    }
+
+    // tails[l] is the anchor that ends the chain of length l + 1 with the smallest position on the second string
+    int length = 0;
+    for (int a = 0; a < n_anchors; a++) {
+        int low = 0, high = length;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (anchors[tails[middle]].pos2 < anchors[a].pos2)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        previous[a] = (low > 0) ? tails[low - 1] : -1;
+        tails[low] = a;
+        if (low == length)
+            length++;
+    }
+
+    // Walk the chain back from its last anchor (the indexes only decrease, so it can be compacted in place)
+    int a = (length > 0) ? tails[length - 1] : -1;
+    for (int l = length - 1; l >= 0; l--) {
+        anchors[l] = anchors[a];
+        a = previous[a];
+    }
+
+    free(tails);
+    free(previous);
+    return length;
+}
+
+/**
+ * @brief Calculates the cut points of the partitions of two strings at shared unique k-mers.
+ *
+ * The cuts of the first string stay within ANCHOR_WINDOW partition lengths of the proportional
+ * ones (so the partitions keep about the same size). A cut without an anchor in the window
+ * keeps its proportional position on the first string, and its position on the second one is
+ * interpolated between the anchors around it (or the ends of the strings): without anchors the
+ * cuts are the ones of partitioning().
+ *
+ * @param str1    The first input string.
+ * @param len1    The length of the first string.
+ * @param str2    The second input string.
+ * @param len2    The length of the second string.
+ * @param n_parts The number of partitions.
+ * @param cuts1   Output parameter: n_parts + 1 cut points of the first string (0, ..., len1).
+ * @param cuts2   Output parameter: n_parts + 1 cut points of the second string (0, ..., len2).
+ *
+ * @return        The number of cuts placed on an anchor, -1 if memory allocation fails (the
+ *                cuts are then the proportional ones).
+ */
+int anchorCuts(const char* str1, int len1, const char* str2, int len2, int n_parts, int* cuts1, int* cuts2) {
+    // Start from the proportional cuts
+    for (int c = 0; c <= n_parts; c++) {
+        cuts1[c] = proportionalCut(len1, c, n_parts);
+        cuts2[c] = proportionalCut(len2, c, n_parts);
+    }
+    if (n_parts <= 1 || len1 < ANCHOR_KMER || len2 < ANCHOR_KMER)
+        return 0;
+
+    Anchor* anchors = NULL;
+    int n_anchors = uniqueAnchors(str1, len1, str2, len2, &anchors);
+    if (n_anchors < 0) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+    n_anchors = chainAnchors(anchors, n_anchors);
+    if (n_anchors < 0) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(anchors);
+        return -1;
+    }
+    if (n_anchors == 0) {
+        free(anchors);
+        return 0;
+    }
+
+    int anchored = 0;
+    double window = ANCHOR_WINDOW * len1 / n_parts;
+    for (int c = 1; c < n_parts; c++) {
+        int target = cuts1[c];
+
+        // First anchor of the chain after the proportional cut
+        int low = 0, high = n_anchors;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (anchors[middle].pos1 < target)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        // Closest anchors of the chain before and after the proportional cut (the ends of the strings if there are none)
+        Anchor before = (low > 0) ? anchors[low - 1] : (Anchor){ 0, 0 };
+        Anchor after = (low < n_anchors) ? anchors[low] : (Anchor){ len1, len2 };
+        const Anchor* closest = (low == n_anchors || (low > 0 && target - before.pos1 < after.pos1 - target)) ? &anchors[low - 1] : &anchors[low];
+
+        if (abs(closest->pos1 - target) <= window && closest->pos1 >= cuts1[c - 1] && closest->pos2 >= cuts2[c - 1]) {
+            cuts1[c] = closest->pos1;
+            cuts2[c] = closest->pos2;
+            anchored++;
+            continue;
+        }
+
+        // Interpolate the position on the second string between the anchors around the cut
+        long long cut2 = before.pos2;
+        if (after.pos1 > before.pos1)
+            cut2 += (long long)(target - before.pos1) * (after.pos2 - before.pos2) / (after.pos1 - before.pos1);
+        cuts1[c] = target;
+        cuts2[c] = (cut2 < cuts2[c - 1]) ? cuts2[c - 1] : (cut2 > len2) ? len2 : (int)cut2;
+    }
+
+    free(anchors);
+    return anchored;
+}
+
+/**
+ * @brief Copies a partition of a string between two cut points computed by anchorCuts().
+ *
+ * @param str  The entire string.
+ * @param cuts The cut points of the string.
+ * @param id   The index of the partition.
+ *
+ * @return     A dynamically allocated char array containing the characters from cuts[id] to
+ *             cuts[id + 1]. It is the responsibility of the caller to free it using free().
+ */
+char* anchorPartition(const char* str, const int* cuts, int id) {
+    int local_len = cuts[id + 1] - cuts[id];
+
+    // Allocate memory for the local substring
+    char* local_str = (char*)malloc((local_len + 1) * sizeof(char));
+    if (local_str == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Copy the partitioned substring into the allocated memory
+    memcpy(local_str, str + cuts[id], local_len);
+    local_str[local_len] = '\0';
+
+    return local_str;
+}
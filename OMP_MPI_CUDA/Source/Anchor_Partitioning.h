@@ -0,0 +1,79 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef ANCHOR_PARTITIONING_H
+#define ANCHOR_PARTITIONING_H
+
+//Length of the k-mers used as anchors
+#define ANCHOR_KMER 12
+//Largest distance of an anchor from the proportional cut, as a fraction of the length of a partition
+#define ANCHOR_WINDOW 0.5
+
+/*
+ * Anchor-aligned partitioning of two strings. The proportional cuts of partitioning() split
+ * both strings at the same offsets: when an insertion or a deletion shifts a string with respect
+ * to the other, each cut separates characters that the alignment matches, and the sum of the
+ * distances of the partitions overestimates the distance. Here the cuts are moved to k-mers that
+ * occur exactly once in each string (anchors): the k-mers of both strings are counted in a hash
+ * table, the unique shared ones are chained in increasing order on both strings (longest
+ * increasing subsequence), and each cut is placed on the anchor closest to its proportional
+ * position, so the partitions of the two strings start at the same character of the alignment.
+ */
+
+/**
+ * @brief Calculates the cut points of the partitions of two strings at shared unique k-mers.
+ *
+ * The cuts of the first string stay within ANCHOR_WINDOW partition lengths of the proportional
+ * ones (so the partitions keep about the same size). A cut without an anchor in the window
+ * keeps its proportional position on the first string, and its position on the second one is
+ * interpolated between the anchors around it (or the ends of the strings): without anchors the
+ * cuts are the ones of partitioning().
+ *
+ * @param str1    The first input string.
+ * @param len1    The length of the first string.
+ * @param str2    The second input string.
+ * @param len2    The length of the second string.
+ * @param n_parts The number of partitions.
+ * @param cuts1   Output parameter: n_parts + 1 cut points of the first string (0, ..., len1).
+ * @param cuts2   Output parameter: n_parts + 1 cut points of the second string (0, ..., len2).
+ *
+ * @return        The number of cuts placed on an anchor, -1 if memory allocation fails (the
+ *                cuts are then the proportional ones).
+ */
+int anchorCuts(const char* str1, int len1, const char* str2, int len2, int n_parts, int* cuts1, int* cuts2);
+
+/**
+ * @brief Copies a partition of a string between two cut points computed by anchorCuts().
+ *
+ * @param str  The entire string.
+ * @param cuts The cut points of the string.
+ * @param id   The index of the partition.
+ *
+ * @return     A dynamically allocated char array containing the characters from cuts[id] to
+ *             cuts[id + 1]. It is the responsibility of the caller to free it using free().
+ */
+char* anchorPartition(const char* str, const int* cuts, int id);
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include "Arena.h"
+//Size of a huge page
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/**
+ * @brief Rounds a size up to the alignment of the arena allocations.
+ */
+size_t arenaBytes(size_t bytes) {
+    return (bytes + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Maps the memory of an arena.
+ *
+ * Explicit huge pages are tried first; if none are reserved, normal pages are mapped and
+ * transparent huge pages are requested for them.
+ *
+ * @param arena The arena to initialize.
+ * @param size  The capacity of the arena in bytes.
+ *
+ * @return      0 on success, -1 if the memory cannot be mapped.
+ */
+int arenaInit(Arena* arena, size_t size) {
+    // Whole huge pages
+    size = (size + HUGE_PAGE_SIZE - 1) & ~(size_t)(HUGE_PAGE_SIZE - 1);
+    if (size == 0)
+        size = HUGE_PAGE_SIZE;
+
+    arena->size = size;
+    arena->used = 0;
+    arena->huge_pages = 1;
+
+    void* base = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+
+    // Fall back to normal pages, merged in huge pages by the kernel when possible
+    if (base == MAP_FAILED) {
+        arena->huge_pages = 0;
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            perror("ERROR during the arena mapping.");
+            arena->base = NULL;
+            arena->size = 0;
+            return -1;
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(base, size, MADV_HUGEPAGE);
+#endif
+    }
+
+    arena->base = (char*)base;
+
+    return 0;
+}
+
+/**
+ * @brief Allocates a cache-line-aligned block from an arena.
+ *
+ * @param arena The arena.
+ * @param bytes The size of the block.
+ *
+ * @return      The block, NULL if the arena is full.
+ */
+void* arenaAlloc(Arena* arena, size_t bytes) {
+    bytes = arenaBytes(bytes);
+
+    // Check if the block fits in the arena
+    if (bytes > arena->size - arena->used) {
+        fprintf(stderr, "ERROR in arena allocation: %zu bytes requested, %zu available.\n", bytes, arena->size - arena->used);
+        return NULL;
+    }
+
+    void* block = arena->base + arena->used;
+    arena->used += bytes;
+
+    return block;
+}
+
+/**
+ * @brief Releases all the blocks of an arena, keeping its memory for the next unit of work.
+ */
+void arenaReset(Arena* arena) {
+    arena->used = 0;
+}
+
+/**
+ * @brief Unmaps the memory of an arena.
+ */
+void arenaFree(Arena* arena) {
+    if (arena->base != NULL)
+        munmap(arena->base, arena->size);
+    arena->base = NULL;
+    arena->size = 0;
+    arena->used = 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+//Alignment of the arena allocations (a cache line)
+#define ARENA_ALIGNMENT 64
+
+/**
+ * @brief A bump allocator over one memory mapping, backed by huge pages when available.
+ *
+ * The allocations are only released all together by arenaReset(), so a thread can reuse the
+ * same memory for each unit of work without calling malloc in its loop.
+ */
+typedef struct {
+    char* base;      /**< First byte of the mapping. */
+    size_t size;     /**< Size of the mapping in bytes. */
+    size_t used;     /**< Bytes allocated since the last reset. */
+    int huge_pages;  /**< 1 if the mapping uses explicit huge pages, 0 otherwise. */
+} Arena;
+
+/**
+ * @brief Rounds a size up to the alignment of the arena allocations.
+ */
+size_t arenaBytes(size_t bytes);
+
+/**
+ * @brief Maps the memory of an arena.
+ *
+ * Explicit huge pages are tried first; if none are reserved, normal pages are mapped and
+ * transparent huge pages are requested for them.
+ *
+ * @param arena The arena to initialize.
+ * @param size  The capacity of the arena in bytes.
+ *
+ * @return      0 on success, -1 if the memory cannot be mapped.
+ */
+int arenaInit(Arena* arena, size_t size);
+
+/**
+ * @brief Allocates a cache-line-aligned block from an arena.
+ *
+ * @param arena The arena.
+ * @param bytes The size of the block.
+ *
+ * @return      The block, NULL if the arena is full.
+ */
+void* arenaAlloc(Arena* arena, size_t bytes);
+
+/**
+ * @brief Releases all the blocks of an arena, keeping its memory for the next unit of work.
+ */
+void arenaReset(Arena* arena);
+
+/**
+ * @brief Unmaps the memory of an arena.
+ */
+void arenaFree(Arena* arena);
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Batch_Levenshtein.h"
+
+/**
+ * @brief Minimum of each lane of two vectors.
+ */
+static inline BatchVector batchMin(BatchVector a, BatchVector b) {
+    BatchVector less = a < b;
+    return (a & less) | (b & ~less);
+}
+
+/**
+ * @brief Bytes of arena needed by batchLevenshtein() for problems up to the given lengths.
+ *
+ * @param max_len1 The longest first string.
+ * @param max_len2 The longest second string.
+ *
+ * @return         The size to pass to arenaInit().
+ */
+size_t batchArenaBytes(int max_len1, int max_len2) {
+    // Transposed characters of both strings and a row of the DP
+    return arenaBytes((size_t)max_len1 * sizeof(BatchVector)) + arenaBytes((size_t)max_len2 * sizeof(BatchVector)) +
+           arenaBytes((size_t)(max_len2 + 1) * sizeof(BatchVector));
+}
+
+/**
+ * @brief Calculates the Levenshtein distances of many small problems, BATCH_LANES at a time.
+ *
+ * @param arena      Arena of at least batchArenaBytes() bytes, reset before returning.
+ * @param str1       The first strings.
+ * @param len1       The lengths of the first strings (at most BATCH_MAX_LENGTH).
+ * @param str2       The second strings.
+ * @param len2       The lengths of the second strings (at most BATCH_MAX_LENGTH).
+ * @param n_problems The number of problems.
+ * @param results    Output parameter: the distance of each problem.
+ *
+ * @return           0 on success, -1 if the arena is too small or a string too long.
+ */
+int batchLevenshtein(Arena* arena, const char* const* str1, const int* len1, const char* const* str2, const int* len2,
+                     int n_problems, int* results) {
+    for (int first = 0; first < n_problems; first += BATCH_LANES) {
+        int lanes = (n_problems - first < BATCH_LANES) ? n_problems - first : BATCH_LANES;
+
+        // Longest strings of the batch
+        int max_len1 = 0;
+        int max_len2 = 0;
+        for (int l = 0; l < lanes; l++) {
+            if (len1[first + l] > max_len1)
+                max_len1 = len1[first + l];
+            if (len2[first + l] > max_len2)
+                max_len2 = len2[first + l];
+        }
+        if (max_len1 > BATCH_MAX_LENGTH || max_len2 > BATCH_MAX_LENGTH) {
+            fprintf(stderr, "ERROR the strings of the batch are longer than %d characters.\n", BATCH_MAX_LENGTH);
+            return -1;
+        }
+
+        BatchVector* chars1 = (BatchVector*)arenaAlloc(arena, max_len1 * sizeof(BatchVector));
+        BatchVector* chars2 = (BatchVector*)arenaAlloc(arena, max_len2 * sizeof(BatchVector));
+        BatchVector* row = (BatchVector*)arenaAlloc(arena, (max_len2 + 1) * sizeof(BatchVector));
+        if ((max_len1 > 0 && chars1 == NULL) || (max_len2 > 0 && chars2 == NULL) || row == NULL) {
+            fprintf(stderr, "ERROR in memory allocation.\n");
+            arenaReset(arena);
+            return -1;
+        }
+
+        // Transpose the strings: one lane for each problem, padded with zeros
+        memset(chars1, 0, max_len1 * sizeof(BatchVector));
+        memset(chars2, 0, max_len2 * sizeof(BatchVector));
+        for (int l = 0; l < lanes; l++) {
+            for (int i = 0; i < len1[first + l]; i++)
+                chars1[i][l] = (unsigned char)str1[first + l][i];
+            for (int j = 0; j < len2[first + l]; j++)
+                chars2[j][l] = (unsigned char)str2[first + l][j];
+        }
+
+        // First row: insertions only
+        BatchVector one = {0};
+        one += 1;
+        for (int j = 0; j <= max_len2; j++) {
+            BatchVector column = {0};
+            row[j] = column + (int16_t)j;
+        }
+        for (int l = 0; l < lanes; l++) {
+            if (len1[first + l] == 0)
+                results[first + l] = len2[first + l];
+        }
+
+        // The rows of all the problems in lock-step
+        for (int i = 1; i <= max_len1; i++) {
+            BatchVector a = chars1[i - 1];
+            BatchVector diag = row[0];
+            BatchVector left = diag + one;
+            row[0] = left;
+            for (int j = 1; j <= max_len2; j++) {
+                BatchVector up = row[j];
+                BatchVector substitution = diag + ((a != chars2[j - 1]) & one);
+                left = batchMin(substitution, batchMin(up, left) + one);
+                row[j] = left;
+                diag = up;
+            }
+
+            // The problems whose first string ends here take their last cell
+            for (int l = 0; l < lanes; l++) {
+                if (len1[first + l] == i)
+                    results[first + l] = row[len2[first + l]][l];
+            }
+        }
+
+        arenaReset(arena);
+    }
+
+    return 0;
+}
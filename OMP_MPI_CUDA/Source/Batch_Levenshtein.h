@@ -0,0 +1,87 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef BATCH_LEVENSHTEIN_H
+#define BATCH_LEVENSHTEIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Arena.h"
+
+//Problems advanced together, one for each 16 bit lane of the widest vector registers
+#ifndef BATCH_LANES
+#if defined(__AVX512BW__)
+#define BATCH_LANES 32
+#elif defined(__AVX2__)
+#define BATCH_LANES 16
+#else
+#define BATCH_LANES 8
+#endif
+#endif
+//Longest string of a problem (the cells are 16 bit signed integers)
+#define BATCH_MAX_LENGTH 32766
+
+/**
+ * @brief A vector of one 16 bit cell for each problem of a batch.
+ */
+typedef int16_t BatchVector __attribute__((vector_size(BATCH_LANES * sizeof(int16_t))));
+
+/*
+ * Batch kernel of many small independent Levenshtein distances. BATCH_LANES problems are
+ * stored as a structure of arrays, character i of all the first strings in one vector and
+ * character j of all the second strings in another, and the DP rows of all of them are
+ * advanced in lock-step with vector operations, one problem for each lane. The lanes of the
+ * shorter problems keep computing padding cells, which are ignored: the distance of a lane is
+ * taken from its own last row and column. The problems of a batch should have similar lengths,
+ * as the partitions of a string do.
+ */
+
+/**
+ * @brief Bytes of arena needed by batchLevenshtein() for problems up to the given lengths.
+ *
+ * @param max_len1 The longest first string.
+ * @param max_len2 The longest second string.
+ *
+ * @return         The size to pass to arenaInit().
+ */
+size_t batchArenaBytes(int max_len1, int max_len2);
+
+/**
+ * @brief Calculates the Levenshtein distances of many small problems, BATCH_LANES at a time.
+ *
+ * @param arena      Arena of at least batchArenaBytes() bytes, reset before returning.
+ * @param str1       The first strings.
+ * @param len1       The lengths of the first strings (at most BATCH_MAX_LENGTH).
+ * @param str2       The second strings.
+ * @param len2       The lengths of the second strings (at most BATCH_MAX_LENGTH).
+ * @param n_problems The number of problems.
+ * @param results    Output parameter: the distance of each problem.
+ *
+ * @return           0 on success, -1 if the arena is too small or a string too long.
+ */
+int batchLevenshtein(Arena* arena, const char* const* str1, const int* len1, const char* const* str2, const int* len2,
+                     int n_problems, int* results);
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include "Diagonal_Transition.h"
+#include "Pattern_Search.h"
+#include "Progress.h"
+//Row of the diagonals not reached yet
+#define UNREACHED (INT_MIN / 2)
+
+/**
+ * @brief Slides along the matching characters of a diagonal.
+ *
+ * On little-endian machines 8 characters are compared at a time, and the first mismatch of a
+ * word is found with the trailing zeros of the XOR of the two words.
+ *
+ * @param str1 The first input string.
+ * @param i    Row of the start.
+ * @param len1 The length of the first string.
+ * @param str2 The second input string.
+ * @param j    Column of the start.
+ * @param len2 The length of the second string.
+ *
+ * @return     Row of the first mismatch (or of the end of a string).
+ */
+static inline int extendMatch(const char* str1, int i, int len1, const char* str2, int j, int len2) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while (i + 8 <= len1 && j + 8 <= len2) {
+        uint64_t a, b;
+        memcpy(&a, str1 + i, sizeof(uint64_t));
+        memcpy(&b, str2 + j, sizeof(uint64_t));
+        if (a != b)
+            return i + __builtin_ctzll(a ^ b) / 8;
+        i += 8;
+        j += 8;
+    }
+#endif
+    while (i < len1 && j < len2 && str1[i] == str2[j]) {
+        i++;
+        j++;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Levenshtein distance computed with the diagonal-transition waves, up to a maximum cost.
+ *
+ * The matches are extended 8 bytes at a time; the diagonals of the waves with at least
+ * MIN_PARALLEL_DIAGONALS diagonals are computed by the OpenMP threads.
+ *
+ * @param str1         The first input string.
+ * @param len1         The length of the first string.
+ * @param str2         The second input string.
+ * @param len2         The length of the second string.
+ * @param max_distance The largest cost computed.
+ *
+ * @return             The Levenshtein distance, max_distance + 1 if it is larger than max_distance,
+ *                     -1 if memory allocation fails.
+ */
+int diagonalLevenshtein(const char* str1, int len1, const char* str2, int len2, int max_distance) {
+    // Diagonals from -len1 to len2, with one more on each side for the neighbours of the edges
+    int n_diagonals = len1 + len2 + 3;
+    int* waves = (int*)malloc(2 * (size_t)n_diagonals * sizeof(int));
+    if (waves == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+    for (int k = 0; k < 2 * n_diagonals; k++)
+        waves[k] = UNREACHED;
+    int* previous = waves + len1 + 1;
+    int* current = waves + n_diagonals + len1 + 1;
+
+    // Wave of cost 0: the common prefix
+    int target = len2 - len1;
+    current[0] = extendMatch(str1, 0, len1, str2, 0, len2);
+    if (target == 0 && current[0] >= len1) {
+        free(waves);
+        return 0;
+    }
+
+    int distance = max_distance + 1;
+    for (int d = 1; d <= max_distance; d++) {
+        int* swap = previous;
+        previous = current;
+        current = swap;
+
+        int low = (d < len1) ? -d : -len1;
+        int high = (d < len2) ? d : len2;
+
+        #pragma omp parallel for schedule(static) if (high - low + 1 >= MIN_PARALLEL_DIAGONALS)
+        for (int k = low; k <= high; k++) {
+            // Substitution on the diagonal, insertion from k - 1, deletion from k + 1
+            int i = previous[k] + 1;
+            if (previous[k - 1] > i)
+                i = previous[k - 1];
+            if (previous[k + 1] + 1 > i)
+                i = previous[k + 1] + 1;
+
+            // Stay inside the matrix, then slide along the matches
+            if (i > len1)
+                i = len1;
+            if (i > len2 - k)
+                i = len2 - k;
+            current[k] = extendMatch(str1, i, len1, str2, i + k, len2);
+        }
+
+        if (target >= low && target <= high && current[target] >= len1) {
+            distance = d;
+            break;
+        }
+    }
+
+    free(waves);
+
+    return distance;
+}
+
+/**
+ * @brief Levenshtein distance for near-duplicate strings, with the bit-parallel kernel as fallback.
+ *
+ * The waves cost about d^2 diagonal steps up to the cost d, while the bit-parallel kernel always
+ * costs len2 * ceil(len1 / 64) words: the waves stop when they reach DIAGONAL_BUDGET of that,
+ * and the distance is computed with the bit-parallel kernel.
+ *
+ * @param str1 The first input string.
+ * @param len1 The length of the first string.
+ * @param str2 The second input string.
+ * @param len2 The length of the second string.
+ *
+ * @return     The Levenshtein distance, -1 if memory allocation fails.
+ */
+int similarLevenshtein(const char* str1, int len1, const char* str2, int len2) {
+    if (len1 == 0 || len2 == 0)
+        return len1 + len2;
+
+    // The shorter string is the pattern of the bit-parallel kernel
+    if (len1 > len2) {
+        const char* str = str1;
+        str1 = str2;
+        str2 = str;
+        int len = len1;
+        len1 = len2;
+        len2 = len;
+    }
+
+    double words = (double)len2 * ((len1 + 63) / 64);
+    int max_distance = (int)sqrt(DIAGONAL_BUDGET * words);
+    int distance = diagonalLevenshtein(str1, len1, str2, len2, max_distance);
+
+    if (distance > max_distance) {
+        PatternMask mask;
+        if (compilePattern(str1, len1, &mask) != 0)
+            return -1;
+        distance = levenshteinBitParallel(&mask, str2, len2);
+        freePattern(&mask);
+    }
+    progressAdd((long long)len1 * len2, 0);
+
+    return distance;
+}
@@ -0,0 +1,76 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef DIAGONAL_TRANSITION_H
+#define DIAGONAL_TRANSITION_H
+
+//Smallest wave whose diagonals are computed in parallel
+#define MIN_PARALLEL_DIAGONALS 4096
+//Fraction of the cost of the bit-parallel kernel spent on the waves before falling back to it
+#define DIAGONAL_BUDGET 0.25
+
+/*
+ * Diagonal-transition kernel (Landau-Vishkin, Myers O(nd)) of the Levenshtein distance. The
+ * wave of cost d holds, for each diagonal k = j - i of the DP, the furthest row reached with
+ * cost d; the wave of cost d + 1 takes one edit from the wave of cost d on the same or on the
+ * adjacent diagonals, then slides along the matching characters. The distance is the first cost
+ * whose wave reaches the last cell, so the time is O((len1 + len2) * d) in place of
+ * O(len1 * len2), and near-duplicate strings cost little more than a comparison.
+ */
+
+/**
+ * @brief Levenshtein distance computed with the diagonal-transition waves, up to a maximum cost.
+ *
+ * The matches are extended 8 bytes at a time; the diagonals of the waves with at least
+ * MIN_PARALLEL_DIAGONALS diagonals are computed by the OpenMP threads.
+ *
+ * @param str1         The first input string.
+ * @param len1         The length of the first string.
+ * @param str2         The second input string.
+ * @param len2         The length of the second string.
+ * @param max_distance The largest cost computed.
+ *
+ * @return             The Levenshtein distance, max_distance + 1 if it is larger than max_distance,
+ *                     -1 if memory allocation fails.
+ */
+int diagonalLevenshtein(const char* str1, int len1, const char* str2, int len2, int max_distance);
+
+/**
+ * @brief Levenshtein distance for near-duplicate strings, with the bit-parallel kernel as fallback.
+ *
+ * The waves cost about d^2 diagonal steps up to the cost d, while the bit-parallel kernel always
+ * costs len2 * ceil(len1 / 64) words: the waves stop when they reach DIAGONAL_BUDGET of that,
+ * and the distance is computed with the bit-parallel kernel.
+ *
+ * @param str1 The first input string.
+ * @param len1 The length of the first string.
+ * @param str2 The second input string.
+ * @param len2 The length of the second string.
+ *
+ * @return     The Levenshtein distance, -1 if memory allocation fails.
+ */
+int similarLevenshtein(const char* str1, int len1, const char* str2, int len2);
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "Random_String_Generator.h"
+#include "Edit_Distance_Kernels.h"
+#include "Diagonal_Transition.h"
+#include "Anchor_Partitioning.h"
+#include "Top_K_Search.h"
+//Smallest length of a partition of the first string in the first upper bound
+#define ANYTIME_MIN_PARTITION 256
+//Bound of the first banded pass (if the lower bound is smaller)
+#define ANYTIME_MIN_BAND 16
+//Predicted growth of the time of a pass with respect to the previous one of the same kind
+#define ANYTIME_GROWTH 2.0
+
+/**
+ * @brief Upper bound of the edit distance: the sum of the distances of the partitions.
+ *
+ * The strings are cut at the shared unique k-mers of Anchor_Partitioning and each pair of
+ * partitions is computed exactly by the diagonal-transition kernel, in parallel by the OpenMP
+ * threads. The alignments of the partitions put together are an alignment of the strings, so
+ * the sum is never smaller than the distance, and it is the distance with one partition.
+ *
+ * @param str1    The first input string.
+ * @param len1    The length of the first string.
+ * @param str2    The second input string.
+ * @param len2    The length of the second string.
+ * @param n_parts The number of partitions.
+ *
+ * @return        The sum of the distances of the partitions, -1 if memory allocation fails.
+ */
+int partitionSum(const char* str1, int len1, const char* str2, int len2, int n_parts) {
+    int* cuts1 = (int*)malloc((n_parts + 1) * sizeof(int));
+    int* cuts2 = (int*)malloc((n_parts + 1) * sizeof(int));
+
+    // Check for memory allocation failure
+    if (cuts1 == NULL || cuts2 == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(cuts1);
+        free(cuts2);
+        return -1;
+    }
+
+    // Cut both strings at the anchors (the same offsets when there are none)
+    anchorCuts(str1, len1, str2, len2, n_parts, cuts1, cuts2);
+
+    // Sum the distances of the partitions, the largest ones are not left to the end
+    int sum = 0;
+    int failed = 0;
+    #pragma omp parallel for schedule(dynamic) reduction(+:sum) reduction(|:failed)
+    for (int p = 0; p < n_parts; p++) {
+        int distance = similarLevenshtein(str1 + cuts1[p], cuts1[p + 1] - cuts1[p], str2 + cuts2[p], cuts2[p + 1] - cuts2[p]);
+        if (distance < 0)
+            failed = 1;
+        else
+            sum += distance;
+    }
+
+    free(cuts1);
+    free(cuts2);
+
+    return failed ? -1 : sum;
+}
+
+/**
+ * @brief Prints the bounds reached by a pass and flushes them, so a reader of the output gets
+ * each refinement as soon as it is computed.
+ *
+ * @param pass      Name of the pass.
+ * @param parameter Partitions of the upper bound pass, bound of the banded pass.
+ * @param lower     Current lower bound of the distance.
+ * @param upper     Current upper bound of the distance.
+ * @param time      Seconds elapsed since the start of the computation.
+ */
+void printBounds(const char* pass, int parameter, int lower, int upper, double time) {
+    printf("%s;%d;%d;%d;%06f\n", pass, parameter, lower, upper, time);
+    fflush(stdout);
+}
+
+/**
+ * @brief Main function for the anytime Edit Distance program.
+ *
+ * This program generates two random strings (or a string and a near-duplicate of it with
+ * n_edits random edits) and brackets their distance between a lower and an upper bound that
+ * are tightened until the deadline. The first line is printed before any kernel runs: the
+ * largest of the length difference and of the q-gram count bound of Top_K_Search, and the
+ * longer length. The second adds the sum of the distances of the anchored partitions of at
+ * least ANYTIME_MIN_PARTITION characters. Then two kinds of passes refine them: a partition
+ * pass halves the partitions (an upper bound, exact with one partition), a banded pass runs the
+ * bounded kernel with a bound that doubles each time (it either finds the distance or proves
+ * that it is above the bound). The next pass is the one predicted to be cheaper, if it ends
+ * before the deadline: a partition pass costs ANYTIME_GROWTH times the previous one, a banded
+ * pass n_characters * (2 * bound + 1) cells at the time per cell of the last pass that was
+ * measured (the partition pass until a banded pass runs). A pass is never interrupted, so the
+ * deadline can only be exceeded by the error of the prediction. Each pass prints "pass;parameter;lower;upper;time", the last line
+ * contains the best bounds and whether they converged to the distance.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    // Check if the correct number of command line arguments is provided
+    if (argc < 6 || argc > 7) {
+        fprintf(stderr, "Usage: %s <n_characters> <seed1> <seed2> <deadline_s> <n_threads> [n_edits]\n", argv[0]);
+        return 1;
+    }
+
+    // Parse command line arguments
+    int n_characters = atoi(argv[1]);
+    int seed1 = atoi(argv[2]);
+    int seed2 = atoi(argv[3]);
+    double deadline = atof(argv[4]);
+    int n_threads = atoi(argv[5]);
+    int n_edits = (argc == 7) ? atoi(argv[6]) : -1;
+    omp_set_num_threads(n_threads);
+
+    // Generate random strings, or a string and a near-duplicate of it
+    char* X = generateRandomString(n_characters, seed1);
+    char* Y;
+    int y_characters = n_characters;
+    if (n_edits >= 0)
+        Y = mutateString(X, n_characters, n_edits, seed2, &y_characters);
+    else
+        Y = generateRandomString(n_characters, seed2);
+
+    unsigned short* histogram = (unsigned short*)malloc(QGRAM_BUCKETS * sizeof(unsigned short));
+    unsigned short* scratch = (unsigned short*)calloc(QGRAM_BUCKETS, sizeof(unsigned short));
+    if (histogram == NULL || scratch == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+
+    double start = omp_get_wtime();
+
+    // Lower bound: the length difference and the shared q-grams, printed before any kernel runs
+    int lower = (n_characters > y_characters) ? n_characters - y_characters : y_characters - n_characters;
+    qgramHistogram(X, n_characters, histogram);
+    int qgram = qgramLowerBound(histogram, n_characters, Y, y_characters, scratch);
+    if (qgram > lower)
+        lower = qgram;
+    int upper = (n_characters > y_characters) ? n_characters : y_characters;
+    printBounds("Qgram", QGRAM_LENGTH, lower, upper, omp_get_wtime() - start);
+
+    // Upper bound: the sum of the partitions, the largest power of two of them that are long enough
+    int n_parts = 1;
+    while (n_parts * 2 * ANYTIME_MIN_PARTITION <= n_characters)
+        n_parts *= 2;
+    double pass_start = omp_get_wtime();
+    int sum = partitionSum(X, n_characters, Y, y_characters, n_parts);
+    if (sum < 0)
+        return 1;
+    double partition_time = omp_get_wtime() - pass_start;
+    if (sum < upper)
+        upper = sum;
+    if (n_parts == 1)
+        lower = upper;
+    printBounds("Partitions", n_parts, lower, upper, omp_get_wtime() - start);
+
+    // Time of a DP cell, from the partition pass until a banded pass is measured
+    double cell_time = partition_time / ((double)n_characters * y_characters / n_parts);
+
+    // Refine the bounds with the cheaper pass that ends before the deadline
+    int band = (lower > ANYTIME_MIN_BAND) ? lower : ANYTIME_MIN_BAND;
+    double band_time = 0.0;
+    int passes = 1;
+    while (lower < upper) {
+        // A banded pass computes at most n_characters * (2 * bound + 1) cells
+        int bound = (band < upper - 1) ? band : upper - 1;
+        double remaining = deadline - (omp_get_wtime() - start);
+        double band_predicted = cell_time * n_characters * (2.0 * bound + 1);
+        if (band_predicted < band_time * ANYTIME_GROWTH)
+            band_predicted = band_time * ANYTIME_GROWTH;
+        double partition_predicted = (n_parts > 1) ? partition_time * ANYTIME_GROWTH : remaining + 1.0;
+        int banded = (band_predicted <= partition_predicted);
+        if ((banded ? band_predicted : partition_predicted) > remaining)
+            break;
+
+        pass_start = omp_get_wtime();
+        if (banded) {
+            // Banded pass: the distance if it is within the bound, else the bound + 1 is a lower bound
+            int distance = boundedLevenshtein(X, n_characters, Y, y_characters, bound);
+            if (distance < 0)
+                return 1;
+            band_time = omp_get_wtime() - pass_start;
+            cell_time = band_time / ((double)n_characters * (2.0 * bound + 1));
+            if (distance <= bound)
+                upper = distance;
+            if (distance > lower)
+                lower = distance;
+            band *= 2;
+            printBounds("Banded", bound, lower, upper, omp_get_wtime() - start);
+        } else {
+            // Partition pass: half the partitions, each twice as long
+            n_parts /= 2;
+            sum = partitionSum(X, n_characters, Y, y_characters, n_parts);
+            if (sum < 0)
+                return 1;
+            partition_time = omp_get_wtime() - pass_start;
+            if (sum < upper)
+                upper = sum;
+            if (n_parts == 1)
+                lower = upper;
+            printBounds("Partitions", n_parts, lower, upper, omp_get_wtime() - start);
+        }
+        passes++;
+    }
+
+    // Print the best bounds and whether they are the distance
+    printf("Anytime;%d;%d;%d;%d;%s;%d;%06f\n", n_characters, n_threads, lower, upper, (lower == upper) ? "converged" : "bounded", passes,
+           omp_get_wtime() - start);
+
+    // Free allocated memory
+    free(X);
+    free(Y);
+    free(histogram);
+    free(scratch);
+
+    return 0;
+}
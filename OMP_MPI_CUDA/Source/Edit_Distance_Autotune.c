@@ -0,0 +1,427 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include <mpi.h>
+#include <math.h>
+#include "Random_String_Generator.h"
+#include "Edit_Distance_Tuning.h"
+#include "Four_Russians.h"
+//Seeds of the strings of the trials (the same of the makefile)
+#define SEED1 18723
+#define SEED2 1
+//Maximum number of timed trials of a configuration
+#define TRIALS 3
+//A configuration slower than the best one by this factor is dropped after its first trial
+#define EARLY_STOP 1.25
+//Range of the tile widths of the tiled backend
+#define MIN_TILE 64
+#define MAX_TILE 16384
+//Maximum memory of the distance matrices of a node, in bytes
+#define MATRIX_MEMORY_LIMIT (1024.0 * 1024.0 * 1024.0)
+
+/**
+ * @brief Calculates the Levenshtein distance between two strings.
+ *
+ * The Levenshtein distance is the minimum number of single-character edits 
+ * (insertions, deletions, or substitutions) required to change one word into another.
+ *
+ * @param str1 The first input string.
+ * @param str2 The second input string.
+ * 
+ * @return     The Levenshtein distance between the two input strings.
+ *             Returns -1 if memory allocation fails during distance matrix creation.
+ */
+int levenshteinDistance(const char* str1, const char* str2) {
+    // Lengths of input strings plus one for the null terminator
+    int m = strlen(str1) + 1;
+    int n = strlen(str2) + 1;
+
+    // Allocate memory for the distance matrix
+    int* distance = (int*)malloc(m * n * sizeof(int));
+
+    // Check for memory allocation failure
+    if (distance == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+
+    // Populate the distance matrix using the Levenshtein distance algorithm
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if (i == 0) {
+                distance[i * n + j] = j;
+            } else if (j == 0) {
+                distance[i * n + j] = i;
+            } else if (str1[i - 1] == str2[j - 1]) {
+                distance[i * n + j] = distance[(i - 1) * n + (j - 1)];
+            } else {
+                distance[i * n + j] = 1 + fmin(fmin(distance[(i - 1) * n + j], distance[i * n + (j - 1)]),
+                                                distance[(i - 1) * n + (j - 1)]);
+            }
+        }
+    }
+
+    // Store the result and free the allocated memory
+    int result = distance[m * n - 1];
+    free(distance);
+
+    return result;
+}
+
+/**
+ * @brief Calculates the partitioned substring based on the given parameters.
+ *
+ * @param str   The entire string to be partitioned.
+ * @param id    The index of the partition.
+ * @param n_id  The total number of partitions.
+ *
+ * @return      A dynamically allocated char array containing the partitioned substring.
+ *              It is the responsibility of the caller to free the allocated memory using free().
+ */
+char* partitioning(const char* str, int id, int n_id) {
+    int len = strlen(str);
+
+    // Calculate the lengths and starting points of local sections of work
+    int local_len = len / n_id; 
+    int remaining = len % n_id; 
+    int local_start = id * local_len + fmin(id, remaining); 
+    local_len += (id < remaining) ? 1 : 0; 
+
+    // Allocate memory for the local substring
+    char* local_str = (char*)malloc((local_len + 1) * sizeof(char));
+    
+    // Copy the partitioned substring into the allocated memory
+    strncpy(local_str, str + local_start, local_len);
+    local_str[local_len] = '\0';
+
+    return local_str;
+}
+
+/**
+ * @brief Calculates the distance of the partition of a process with a candidate configuration.
+ *
+ * @param str1      The partition of the first string.
+ * @param str2      The partition of the second string.
+ * @param candidate The configuration to use.
+ *
+ * @return          The sum of the distances of the partitions of the threads.
+ */
+int threadPartitioning(const char* str1, const char* str2, const TuningEntry* candidate) {
+    int n_threads = candidate->omp_threads;
+
+    // Array to store individual thread results
+    int results[n_threads];
+
+    // OpenMP parallel region
+    #pragma omp parallel num_threads(n_threads)
+    {
+        // Get the thread ID
+        int tid = omp_get_thread_num();
+
+        // Partition the input strings for each thread
+        char* local_str1 = partitioning(str1, tid, n_threads);
+        char* local_str2 = partitioning(str2, tid, n_threads);
+
+        // Calculate Levenshtein distance for each thread with the backend of the candidate
+        if (candidate->backend != BACKEND_MATRIX)
+            results[tid] = tunedLevenshtein(local_str1, local_str2, candidate);
+        else
+            results[tid] = levenshteinDistance(local_str1, local_str2);
+
+        // Free allocated memory for local strings
+        free(local_str1);
+        free(local_str2);
+    }
+
+    // Combine individual thread results
+    int local_result = 0;
+    for (int i = 0; i < n_threads; i++)
+        local_result += results[i];
+
+    return local_result;
+}
+
+/**
+ * @brief Times one run of the partitioned computation with a candidate configuration.
+ *
+ * Every process takes part in the timing, but only the processes of the active communicator
+ * compute; the time measured by rank 0 is shared with all of them, so they all take the same
+ * decisions.
+ *
+ * @param str1      The first string.
+ * @param str2      The second string.
+ * @param candidate The configuration to time.
+ * @param active    The communicator of the candidate->mpi_process processes (MPI_COMM_NULL outside).
+ *
+ * @return          The time of the run in seconds.
+ */
+double timeTrial(const char* str1, const char* str2, const TuningEntry* candidate, MPI_Comm active) {
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = MPI_Wtime();
+
+    if (active != MPI_COMM_NULL) {
+        int rank, size;
+        MPI_Comm_rank(active, &rank);
+        MPI_Comm_size(active, &size);
+
+        // Partition strings and calculate Edit Distance in parallel
+        char* local_str1 = partitioning(str1, rank, size);
+        char* local_str2 = partitioning(str2, rank, size);
+        int local_result = threadPartitioning(local_str1, local_str2, candidate);
+
+        // Sum the partial results
+        int ED;
+        MPI_Reduce(&local_result, &ED, 1, MPI_INT, MPI_SUM, 0, active);
+
+        free(local_str1);
+        free(local_str2);
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double time = MPI_Wtime() - start;
+    MPI_Bcast(&time, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+    return time;
+}
+
+/**
+ * @brief Times a candidate configuration with up to TRIALS runs, keeping the best one.
+ *
+ * The runs stop early when the candidate is clearly slower than the best configuration.
+ *
+ * @param str1      The first string.
+ * @param str2      The second string.
+ * @param candidate The configuration to time; its time field is set to the best run.
+ * @param active    The communicator of the processes of the candidate.
+ * @param best      The time of the best configuration so far, 0 if there is none.
+ */
+void timeCandidate(const char* str1, const char* str2, TuningEntry* candidate, MPI_Comm active, double best) {
+    candidate->time = 0;
+
+    for (int trial = 0; trial < TRIALS; trial++) {
+        double time = timeTrial(str1, str2, candidate, active);
+        if (trial == 0 || time < candidate->time)
+            candidate->time = time;
+
+        // Early stopping
+        if (best > 0 && candidate->time > best * EARLY_STOP)
+            break;
+    }
+}
+
+/**
+ * @brief Searches the best configuration for one input size.
+ *
+ * The number of processes grows in powers of two up to the processes of the run, and for each
+ * one the number of threads grows in powers of two up to the cores of the node. For each pair
+ * the matrix backend is timed (if the matrices fit in memory), then the tiled backend with both
+ * cell widths and growing tiles, then the Four-Russians and the diagonal-transition backends.
+ * A dimension stops growing as soon as it gets slower.
+ *
+ * @param n_characters The input size.
+ *
+ * @return             The best configuration.
+ */
+TuningEntry tuneSize(int n_characters) {
+    int world_rank, world_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+    int cores = omp_get_num_procs();
+
+    // Generate the strings of the trials
+    char* str1 = generateRandomString(n_characters, SEED1);
+    char* str2 = generateRandomString(n_characters, SEED2);
+
+    TuningEntry best = {n_characters, BACKEND_MATRIX, 0, 32, 1, 1, 0};
+
+    for (int n_process = 1; n_process <= world_size; n_process *= 2) {
+        // Communicator of the processes of the trials
+        MPI_Comm active;
+        MPI_Comm_split(MPI_COMM_WORLD, (world_rank < n_process) ? 0 : MPI_UNDEFINED, world_rank, &active);
+
+        double previous_threads = 0;
+        for (int n_threads = 1; n_threads == 1 || n_threads * n_process <= cores; n_threads *= 2) {
+            TuningEntry candidate = {n_characters, BACKEND_MATRIX, 0, 32, n_threads, n_process, 0};
+            double threads_best = 0;
+
+            // Whole distance matrix, if the matrices of the node fit in memory
+            double side = (double)n_characters / (n_process * n_threads) + 1;
+            if (side * side * sizeof(int) * n_process * n_threads <= MATRIX_MEMORY_LIMIT) {
+                timeCandidate(str1, str2, &candidate, active, best.time);
+                threads_best = candidate.time;
+                if (best.time == 0 || candidate.time < best.time)
+                    best = candidate;
+            }
+
+            // Tiled backend, with growing tiles for each cell width
+            candidate.backend = BACKEND_TILED;
+            for (int cell_width = 16; cell_width <= 32; cell_width *= 2) {
+                double previous_tile = 0;
+                for (int tile = MIN_TILE; tile <= MAX_TILE && tile <= n_characters; tile *= 2) {
+                    candidate.tile = tile;
+                    candidate.cell_width = cell_width;
+                    timeCandidate(str1, str2, &candidate, active, best.time);
+
+                    if (threads_best == 0 || candidate.time < threads_best)
+                        threads_best = candidate.time;
+                    if (best.time == 0 || candidate.time < best.time)
+                        best = candidate;
+
+                    // Larger tiles stop once they get slower
+                    if (previous_tile > 0 && candidate.time > previous_tile)
+                        break;
+                    previous_tile = candidate.time;
+                }
+            }
+
+            // Four-Russians backend, a lookup for each block of 3 x 3 cells
+            candidate.backend = BACKEND_RUSSIANS;
+            candidate.tile = 0;
+            candidate.cell_width = 32;
+            timeCandidate(str1, str2, &candidate, active, best.time);
+            if (threads_best == 0 || candidate.time < threads_best)
+                threads_best = candidate.time;
+            if (best.time == 0 || candidate.time < best.time)
+                best = candidate;
+
+            // Diagonal-transition backend, falling back to the bit-parallel kernel on distant strings
+            candidate.backend = BACKEND_DIAGONAL;
+            timeCandidate(str1, str2, &candidate, active, best.time);
+            if (threads_best == 0 || candidate.time < threads_best)
+                threads_best = candidate.time;
+            if (best.time == 0 || candidate.time < best.time)
+                best = candidate;
+
+            // More threads stop once they get slower
+            if (previous_threads > 0 && threads_best > previous_threads)
+                break;
+            previous_threads = threads_best;
+        }
+
+        if (active != MPI_COMM_NULL)
+            MPI_Comm_free(&active);
+    }
+
+    free(str1);
+    free(str2);
+
+    return best;
+}
+
+/**
+ * @brief Main function of the autotuner of the OMP+MPI Edit Distance.
+ *
+ * For each input size from min_characters to max_characters (doubling), it times short trials
+ * of the partitioned computation with different numbers of processes and threads, kernel
+ * backends, tile widths and cell widths, and writes the best configuration of each size to
+ * the configuration of the host (Tuning/<hostname>.csv by default), which the OMP+MPI Edit
+ * Distance loads when it is run with the "tuned" argument. The entries of the other sizes already in the file are kept.
+ * It must be launched with the maximum number of processes per node to try.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char** argv) {
+    // MPI Initialization
+    MPI_Init(&argc, &argv);
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    // Check if the correct number of command line arguments is provided
+    if (argc != 3 && argc != 4) {
+        if (rank == 0) {
+            fprintf(stderr, "Usage: %s <min_characters> <max_characters> [config_file]\n", argv[0]);
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Build the lookup table of the Four-Russians backend before the trials
+    fourRussiansInit();
+
+    // Parse command line arguments
+    int min_characters = atoi(argv[1]);
+    int max_characters = atoi(argv[2]);
+    char path[300];
+    if (argc == 4)
+        snprintf(path, sizeof(path), "%s", argv[3]);
+    else
+        tuningConfigPath(path, sizeof(path));
+
+    // Keep the entries of the other sizes
+    TuningConfig config;
+    loadTuningConfig(path, &config);
+
+    int result = 0;
+    for (int n_characters = (min_characters > 0) ? min_characters : 1; ; n_characters *= 2) {
+        if (n_characters > max_characters)
+            n_characters = max_characters;
+
+        TuningEntry best = tuneSize(n_characters);
+
+        if (rank == 0) {
+            printf("%d;%s;%d;%d;%d;%d;%06f\n", best.n_characters, tuningBackendName(best.backend),
+                   best.tile, best.cell_width, best.omp_threads, best.mpi_process, best.time);
+
+            // Replace the entry of the same size, or add a new one
+            int e = 0;
+            while (e < config.n_entries && config.entries[e].n_characters != n_characters)
+                e++;
+            if (e == config.n_entries) {
+                TuningEntry* entries = (TuningEntry*)realloc(config.entries, (config.n_entries + 1) * sizeof(TuningEntry));
+                if (entries != NULL) {
+                    config.entries = entries;
+                    config.n_entries++;
+                } else {
+                    fprintf(stderr, "ERROR in memory allocation.\n");
+                    result = 1;
+                }
+            }
+            if (e < config.n_entries)
+                config.entries[e] = best;
+        }
+
+        if (n_characters >= max_characters)
+            break;
+    }
+
+    // Write the configuration of the host
+    if (rank == 0 && result == 0 && saveTuningConfig(path, &config) != 0)
+        result = 1;
+
+    freeTuningConfig(&config);
+
+    // MPI Finalization
+    MPI_Finalize();
+
+    return result;
+}
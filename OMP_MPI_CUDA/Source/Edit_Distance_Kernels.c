@@ -0,0 +1,195 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Edit_Distance_Kernels.h"
+
+// One instantiation per cost model
+DEFINE_EDIT_DISTANCE_KERNEL(levenshteinUnitCost, UNIT_SUBSTITUTION, UNIT_INSERTION, UNIT_DELETION, UNIT_TRANSPOSITION, 0)
+DEFINE_EDIT_DISTANCE_KERNEL(levenshteinWeighted, WEIGHTED_SUBSTITUTION, WEIGHTED_INSERTION, WEIGHTED_DELETION, WEIGHTED_TRANSPOSITION, 0)
+DEFINE_EDIT_DISTANCE_KERNEL(damerauUnitCost, UNIT_SUBSTITUTION, UNIT_INSERTION, UNIT_DELETION, UNIT_TRANSPOSITION, 1)
+DEFINE_EDIT_DISTANCE_KERNEL(damerauWeighted, WEIGHTED_SUBSTITUTION, WEIGHTED_INSERTION, WEIGHTED_DELETION, WEIGHTED_TRANSPOSITION, 1)
+
+/**
+ * @brief Initializes a cost model with unit costs for every operation.
+ *
+ * @param costs The cost model to initialize.
+ */
+void initUnitCosts(EditCosts* costs) {
+    for (int a = 0; a < 256; ++a)
+        for (int b = 0; b < 256; ++b)
+            costs->substitution[a][b] = (a == b) ? 0 : 1;
+
+    costs->insertion = 1;
+    costs->deletion = 1;
+    costs->transposition = 1;
+}
+
+/**
+ * @brief Loads a weighted cost model from a file.
+ *
+ * The model starts from unit costs, then each line of the file overrides one of them:
+ * "a;b;cost" sets the substitution of the character a with b (and of b with a),
+ * while "insertion;cost", "deletion;cost" and "transposition;cost" set the other operations.
+ *
+ * @param path  Path of the cost file.
+ * @param costs The cost model to fill.
+ *
+ * @return      0 on success, -1 if the file cannot be opened.
+ */
+int loadEditCosts(const char* path, EditCosts* costs) {
+    initUnitCosts(costs);
+
+    // Open the cost file
+    FILE* fp = fopen(path, "r");
+
+    // Check if the file can be opened
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", path);
+        return -1;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char* first = strtok(line, ";\n");
+        char* second = strtok(NULL, ";\n");
+        char* third = strtok(NULL, ";\n");
+
+        if (first == NULL || second == NULL)
+            continue;
+
+        // Substitution between two characters (symmetric)
+        if (third != NULL && strlen(first) == 1 && strlen(second) == 1) {
+            unsigned char a = (unsigned char)first[0];
+            unsigned char b = (unsigned char)second[0];
+            costs->substitution[a][b] = atoi(third);
+            costs->substitution[b][a] = atoi(third);
+        } else if (strcmp(first, "insertion") == 0) {
+            costs->insertion = atoi(second);
+        } else if (strcmp(first, "deletion") == 0) {
+            costs->deletion = atoi(second);
+        } else if (strcmp(first, "transposition") == 0) {
+            costs->transposition = atoi(second);
+        }
+    }
+
+    fclose(fp);
+
+    return 0;
+}
+
+/**
+ * @brief Levenshtein distance with unit costs, bounded by a maximum value.
+ *
+ * Only the diagonal band of width 2 * bound + 1 is computed, and the computation stops as
+ * soon as every cell of a row exceeds the bound. Use it when only distances up to the bound
+ * are of interest.
+ *
+ * @param str1  The first input string.
+ * @param len1  The length of the first string.
+ * @param str2  The second input string.
+ * @param len2  The length of the second string.
+ * @param bound The maximum distance of interest.
+ *
+ * @return      The distance if it is at most bound, bound + 1 otherwise.
+ *              Returns -1 if memory allocation fails.
+ */
+int boundedLevenshtein(const char* str1, int len1, const char* str2, int len2, int bound) {
+    // Value used for every cell that exceeds the bound
+    int outside = bound + 1;
+
+    // The length difference alone is a lower bound of the distance
+    if (len1 - len2 > bound || len2 - len1 > bound)
+        return outside;
+
+    // Allocate memory for two rows of the distance matrix
+    int n = len2 + 1;
+    int* rows = (int*)malloc(2 * n * sizeof(int));
+
+    // Check for memory allocation failure
+    if (rows == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+    int* previous = rows;
+    int* current = rows + n;
+
+    // First row, clamped to the bound
+    for (int j = 0; j < n; ++j)
+        previous[j] = (j <= bound) ? j : outside;
+
+    for (int i = 1; i <= len1; ++i) {
+        // Columns of the band for this row
+        int low = (i - bound > 1) ? i - bound : 1;
+        int high = (i + bound < len2) ? i + bound : len2;
+
+        current[0] = (i <= bound) ? i : outside;
+        if (low > 1)
+            current[low - 1] = outside;
+
+        int row_min = (low == 1) ? current[0] : outside;
+
+        for (int j = low; j <= high; ++j) {
+            int value;
+            if (str1[i - 1] == str2[j - 1]) {
+                value = previous[j - 1];
+            } else {
+                value = previous[j - 1];
+                if (previous[j] < value)
+                    value = previous[j];
+                if (current[j - 1] < value)
+                    value = current[j - 1];
+                value += 1;
+            }
+            if (value > outside)
+                value = outside;
+            current[j] = value;
+            if (value < row_min)
+                row_min = value;
+        }
+
+        // The cell right of the band is read by the next row
+        if (high < len2)
+            current[high + 1] = outside;
+
+        // Every path goes through this row: stop if all of it exceeds the bound
+        if (row_min > bound) {
+            free(rows);
+            return outside;
+        }
+
+        int* swap = previous;
+        previous = current;
+        current = swap;
+    }
+
+    // Store the result and free the allocated memory
+    int result = previous[len2];
+    free(rows);
+
+    return result;
+}
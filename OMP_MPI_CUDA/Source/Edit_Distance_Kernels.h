@@ -0,0 +1,195 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#ifndef EDIT_DISTANCE_KERNELS_H
+#define EDIT_DISTANCE_KERNELS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Cost model of the generalised edit distance kernels.
+ *
+ * The substitution matrix is indexed by the two characters (as unsigned char); substituting
+ * a character with itself is always free, whatever the value on the diagonal.
+ */
+typedef struct {
+    int substitution[256][256];  /**< Cost of replacing the first character with the second. */
+    int insertion;               /**< Cost of inserting a character. */
+    int deletion;                /**< Cost of deleting a character. */
+    int transposition;           /**< Cost of swapping two adjacent characters (Damerau only). */
+} EditCosts;
+
+/*
+ * Cost expressions used to instantiate the kernels. The unit versions are compile-time
+ * constants, so the unit-cost kernels contain no cost lookups at all.
+ */
+#define UNIT_SUBSTITUTION(costs, a, b) 1
+#define UNIT_INSERTION(costs) 1
+#define UNIT_DELETION(costs) 1
+#define UNIT_TRANSPOSITION(costs) 1
+
+#define WEIGHTED_SUBSTITUTION(costs, a, b) ((costs)->substitution[(unsigned char)(a)][(unsigned char)(b)])
+#define WEIGHTED_INSERTION(costs) ((costs)->insertion)
+#define WEIGHTED_DELETION(costs) ((costs)->deletion)
+#define WEIGHTED_TRANSPOSITION(costs) ((costs)->transposition)
+
+/**
+ * @brief Defines an edit distance kernel specialised for one cost model.
+ *
+ * Each row of the DP is computed in two passes: the first one takes the vertical, diagonal
+ * and (if DAMERAU is 1) transposition moves, which only depend on the previous rows and can be
+ * vectorised; the second one propagates the horizontal moves along the row. Only three rows
+ * are kept in memory.
+ *
+ * The generated function has the signature
+ * int NAME(const char* str1, int len1, const char* str2, int len2, const EditCosts* costs)
+ * and returns -1 if memory allocation fails.
+ *
+ * @param NAME          Name of the generated function.
+ * @param SUBSTITUTION  Cost expression of a substitution, with parameters (costs, a, b).
+ * @param INSERTION     Cost expression of an insertion, with parameter (costs).
+ * @param DELETION      Cost expression of a deletion, with parameter (costs).
+ * @param TRANSPOSITION Cost expression of an adjacent transposition, with parameter (costs).
+ * @param DAMERAU       1 to enable the restricted Damerau (adjacent transposition) move, 0 otherwise.
+ */
+#define DEFINE_EDIT_DISTANCE_KERNEL(NAME, SUBSTITUTION, INSERTION, DELETION, TRANSPOSITION, DAMERAU)      \
+int NAME(const char* str1, int len1, const char* str2, int len2, const EditCosts* costs) {              \
+    int n = len2 + 1;                                                                                   \
+    (void)costs;                                                                                        \
+                                                                                                        \
+    /* Allocate the three rows of the DP (the oldest one is only read by Damerau) */                    \
+    int* rows = (int*)malloc(3 * n * sizeof(int));                                                      \
+    if (rows == NULL) {                                                                                 \
+        fprintf(stderr, "ERROR in memory allocation.\n");                                               \
+        return -1;                                                                                      \
+    }                                                                                                   \
+    int* before = rows;                                                                                 \
+    int* previous = rows + n;                                                                           \
+    int* current = rows + 2 * n;                                                                        \
+                                                                                                        \
+    /* First row: insertions only */                                                                    \
+    previous[0] = 0;                                                                                    \
+    for (int j = 1; j < n; ++j)                                                                         \
+        previous[j] = previous[j - 1] + INSERTION(costs);                                               \
+                                                                                                        \
+    for (int i = 1; i <= len1; ++i) {                                                                   \
+        char a = str1[i - 1];                                                                           \
+        char a_before = (i > 1) ? str1[i - 2] : 0;                                                      \
+        current[0] = previous[0] + DELETION(costs);                                                     \
+                                                                                                        \
+        /* Moves from the previous rows (no dependency along the row) */                                \
+        for (int j = 1; j < n; ++j) {                                                                   \
+            char b = str2[j - 1];                                                                       \
+            int up = previous[j] + DELETION(costs);                                                     \
+            int diagonal = previous[j - 1] + ((a == b) ? 0 : SUBSTITUTION(costs, a, b));                \
+            int best = (up < diagonal) ? up : diagonal;                                                 \
+            if (DAMERAU && i > 1 && j > 1 && a == str2[j - 2] && a_before == b) {                       \
+                int swap = before[j - 2] + TRANSPOSITION(costs);                                        \
+                best = (swap < best) ? swap : best;                                                     \
+            }                                                                                           \
+            current[j] = best;                                                                          \
+        }                                                                                               \
+                                                                                                        \
+        /* Insertions (dependency on the left cell) */                                                  \
+        for (int j = 1; j < n; ++j) {                                                                   \
+            int left = current[j - 1] + INSERTION(costs);                                               \
+            if (left < current[j])                                                                      \
+                current[j] = left;                                                                      \
+        }                                                                                               \
+                                                                                                        \
+        /* Rotate the rows */                                                                           \
+        int* oldest = before;                                                                           \
+        before = previous;                                                                              \
+        previous = current;                                                                             \
+        current = oldest;                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    /* Store the result and free the allocated memory */                                                \
+    int result = previous[len2];                                                                        \
+    free(rows);                                                                                         \
+                                                                                                        \
+    return result;                                                                                      \
+}
+
+/**
+ * @brief Initializes a cost model with unit costs for every operation.
+ *
+ * @param costs The cost model to initialize.
+ */
+void initUnitCosts(EditCosts* costs);
+
+/**
+ * @brief Loads a weighted cost model from a file.
+ *
+ * The model starts from unit costs, then each line of the file overrides one of them:
+ * "a;b;cost" sets the substitution of the character a with b (and of b with a),
+ * while "insertion;cost", "deletion;cost" and "transposition;cost" set the other operations.
+ *
+ * @param path  Path of the cost file.
+ * @param costs The cost model to fill.
+ *
+ * @return      0 on success, -1 if the file cannot be opened.
+ */
+int loadEditCosts(const char* path, EditCosts* costs);
+
+/**
+ * @brief Plain Levenshtein distance with unit costs.
+ */
+int levenshteinUnitCost(const char* str1, int len1, const char* str2, int len2, const EditCosts* costs);
+
+/**
+ * @brief Levenshtein distance with the costs of the given model.
+ */
+int levenshteinWeighted(const char* str1, int len1, const char* str2, int len2, const EditCosts* costs);
+
+/**
+ * @brief Restricted Damerau (optimal string alignment) distance with unit costs.
+ */
+int damerauUnitCost(const char* str1, int len1, const char* str2, int len2, const EditCosts* costs);
+
+/**
+ * @brief Restricted Damerau (optimal string alignment) distance with the costs of the given model.
+ */
+int damerauWeighted(const char* str1, int len1, const char* str2, int len2, const EditCosts* costs);
+
+/**
+ * @brief Levenshtein distance with unit costs, bounded by a maximum value.
+ *
+ * Only the diagonal band of width 2 * bound + 1 is computed, and the computation stops as
+ * soon as every cell of a row exceeds the bound. Use it when only distances up to the bound
+ * are of interest.
+ *
+ * @param str1  The first input string.
+ * @param len1  The length of the first string.
+ * @param str2  The second input string.
+ * @param len2  The length of the second string.
+ * @param bound The maximum distance of interest.
+ *
+ * @return      The distance if it is at most bound, bound + 1 otherwise.
+ *              Returns -1 if memory allocation fails.
+ */
+int boundedLevenshtein(const char* str1, int len1, const char* str2, int len2, int bound);
+
+#endif
@@ -29,6 +29,9 @@
 #include <omp.h>
 #include <time.h>
 
+//Alignment of the blocks of the device arena (a cache line)
+#define ARENA_ALIGNMENT 64
+
 #define CUDA_CHECK(X) {\
  cudaError_t _m_cudaStat = X;\
  if(cudaSuccess != _m_cudaStat) {\
@@ -209,27 +212,122 @@ __host__ __device__ int levenshteinDistance(const char* str1, const char* str2)
     return result;
 }
 
+/**
+ * @brief Rounds a size up to the alignment of the blocks of the device arena.
+ */
+__host__ __device__ size_t arenaBytes(size_t bytes) {
+    return (bytes + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Copies a partition of a string into a given buffer, as partitioning() does.
+ *
+ * @param local_str The buffer of the partition (at least local_len + 1 characters).
+ * @param str       The entire string to be partitioned.
+ * @param len       The length of the entire string.
+ * @param id        The index of the partition.
+ * @param n_id      The total number of partitions.
+ *
+ * @return          The length of the partition.
+ */
+__host__ __device__ int partitioningInto(char* local_str, const char* str, int len, int id, int n_id) {
+    // Calculate the lengths and starting points of local sections of work
+    int remaining = len % n_id;
+    int local_start = id * (len / n_id) + ((id < remaining) ? id : remaining);
+    int local_len = len / n_id + ((id < remaining) ? 1 : 0);
+
+    // Copy the partitioned substring into the buffer
+    for (int i = 0; i < local_len; ++i)
+        local_str[i] = str[local_start + i];
+    local_str[local_len] = '\0';
+
+    return local_len;
+}
+
+/**
+ * @brief Calculates the Levenshtein distance between two strings in a given distance matrix.
+ *
+ * @param str1     The first input string.
+ * @param len1     The length of the first string.
+ * @param str2     The second input string.
+ * @param len2     The length of the second string.
+ * @param distance The distance matrix, of (len1 + 1) * (len2 + 1) elements.
+ *
+ * @return         The Levenshtein distance between the two input strings.
+ */
+__host__ __device__ int matrixLevenshteinDistance(const char* str1, int len1, const char* str2, int len2, int* distance) {
+    int m = len1 + 1;
+    int n = len2 + 1;
+
+    // Populate the distance matrix using the Levenshtein distance algorithm
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if (i == 0) {
+                distance[i * n + j] = j;
+            } else if (j == 0) {
+                distance[i * n + j] = i;
+            } else if (str1[i - 1] == str2[j - 1]) {
+                distance[i * n + j] = distance[(i - 1) * n + (j - 1)];
+            } else {
+                distance[i * n + j] = 1 + cuda_fmin(cuda_fmin(distance[(i - 1) * n + j], distance[i * n + (j - 1)]), distance[(i - 1) * n + (j - 1)]);
+            }
+        }
+    }
+
+    return distance[m * n - 1];
+}
+
+/**
+ * @brief Calculates the size of the slice of the device arena of each CUDA thread.
+ *
+ * The slice holds the two substrings and the distance matrix of the largest partition.
+ *
+ * @param len1      The length of the first string.
+ * @param len2      The length of the second string.
+ * @param n_threads The number of CUDA threads.
+ *
+ * @return          The size of a slice in bytes.
+ */
+__host__ __device__ size_t arenaSliceBytes(int len1, int len2, int n_threads) {
+    size_t max_len1 = len1 / n_threads + 1;
+    size_t max_len2 = len2 / n_threads + 1;
+
+    return arenaBytes(max_len1 + 1) + arenaBytes(max_len2 + 1) + arenaBytes((max_len1 + 1) * (max_len2 + 1) * sizeof(int));
+}
+
 /**
  * @brief CUDA kernel for computing the edit distance between two strings.
  *
  * This CUDA kernel divides the input strings among threads and computes the
  * Levenshtein distance locally for each thread. The results are stored in the
- * output array ED.
- *
- * @param str1 Pointer to the first input string.
- * @param str2 Pointer to the second input string.
- * @param ED   Pointer to the output array to store the computed edit distances.
+ * output array ED. Each thread works in its own slice of the device arena,
+ * allocated once by the host, so the kernel never uses the device heap.
+ *
+ * @param str1  Pointer to the first input string.
+ * @param len1  Length of the first input string.
+ * @param str2  Pointer to the second input string.
+ * @param len2  Length of the second input string.
+ * @param arena The device arena, one slice of arenaSliceBytes() bytes per thread.
+ * @param ED    Pointer to the output array to store the computed edit distances.
  */
-__global__ void EditDistanceKernel(char* str1, char* str2, int* ED) {
+__global__ void EditDistanceKernel(char* str1, int len1, char* str2, int len2, char* arena, int* ED) {
     int tid = blockIdx.x * blockDim.x + threadIdx.x;
     int n_threads = blockDim.x*gridDim.x;
 
+    // Carve the buffers of the current thread from its slice
+    size_t max_len1 = len1 / n_threads + 1;
+    size_t max_len2 = len2 / n_threads + 1;
+    char* slice = arena + (size_t)tid * arenaSliceBytes(len1, len2, n_threads);
+    char* local_str1 = slice;
+    char* local_str2 = local_str1 + arenaBytes(max_len1 + 1);
+    int* distance = (int*)(local_str2 + arenaBytes(max_len2 + 1));
+
     // Partition the input strings for the current thread
-    char* local_str1 = partitioning(str1, tid, n_threads);
-    char* local_str2 = partitioning(str2, tid, n_threads);
+    int local_len1 = partitioningInto(local_str1, str1, len1, tid, n_threads);
+    int local_len2 = partitioningInto(local_str2, str2, len2, tid, n_threads);
 
     // Compute the Levenshtein distance locally for the current thread
-    int local_ED = levenshteinDistance(local_str1, local_str2);
+    int local_ED = matrixLevenshteinDistance(local_str1, local_len1, local_str2, local_len2, distance);
 
     // Store the local edit distance result in the output array
     ED[tid] = local_ED;
@@ -394,6 +492,10 @@ float editDistanceOnDevice(char* str1, char* str2, int n_threads, int opt) {
     int* gpu_ED;
     CUDA_CHECK(cudaMalloc((void**)&gpu_ED, cuda_threads * sizeof(int)));
 
+    // Allocate the device arena, sized from the largest partition of the threads
+    char* gpu_arena;
+    CUDA_CHECK(cudaMalloc((void**)&gpu_arena, cuda_threads * arenaSliceBytes(size_gpu_str1, size_gpu_str2, cuda_threads)));
+
     // Create CUDA events for timing
     cudaEvent_t start, stop;
     CUDA_CHECK(cudaEventCreate(&start));
@@ -406,7 +508,7 @@ float editDistanceOnDevice(char* str1, char* str2, int n_threads, int opt) {
 
     // Record the start time and execute the CUDA kernel
     CUDA_CHECK(cudaEventRecord(start,0));
-    EditDistanceKernel<<<gridSize, blockSize>>>(gpu_str1, gpu_str2, gpu_ED);
+    EditDistanceKernel<<<gridSize, blockSize>>>(gpu_str1, size_gpu_str1, gpu_str2, size_gpu_str2, gpu_arena, gpu_ED);
     CUDA_CHECK(cudaEventRecord(stop,0));
 
     // Perform thread partitioning on the host
@@ -434,6 +536,7 @@ float editDistanceOnDevice(char* str1, char* str2, int n_threads, int opt) {
     CUDA_CHECK(cudaFree(gpu_str1));
     CUDA_CHECK(cudaFree(gpu_str2));
     CUDA_CHECK(cudaFree(gpu_ED));
+    CUDA_CHECK(cudaFree(gpu_arena));
 
     // Print result and free memory
     int n_characters = strlen(str1);
@@ -30,6 +30,14 @@
 #include <math.h>
 #include <sys/time.h>
 #include "Random_String_Generator.h"
+#include "Semi_Local_LCS.h"
+#include "Edit_Distance_Tuning.h"
+#include "Four_Russians.h"
+#include "Anchor_Partitioning.h"
+#include "Memory_Accounting.h"
+#include "Work_Stealing.h"
+#include "Progress.h"
+#include "Energy.h"
 //Constant for the time conversion
 #define SEC_CONV 1000000
 
@@ -73,6 +81,8 @@ int levenshteinDistance(const char* str1, const char* str2) {
                                                 distance[(i - 1) * n + (j - 1)]);
             }
         }
+        if (i > 0)
+            progressAdd(n - 1, 0);
     }
 
     // Store the result and free the allocated memory
@@ -145,33 +155,51 @@ double getTotalTime(struct timeval start, struct timeval stop) {
  * This function partitions the input strings into multiple sections based on the number
  * of threads and calculates the Levenshtein distance for each section concurrently using
  * OpenMP parallelism. The results are combined to obtain the final distance.
+ * Each section is computed with the tiled, Four-Russians or diagonal-transition backend when the
+ * configuration of the host selects it, with the whole distance matrix otherwise.
  *
  * @param str1       The first input string.
  * @param str2       The second input string.
  * @param n_threads  Number of OpenMP threads.
+ * @param tuning     The tuned configuration of the host, NULL to use the distance matrix.
+ * @param cuts1      The cut points of the sections in the first string (n_threads + 1 elements), NULL for equal sections.
+ * @param cuts2      The cut points of the sections in the second string (n_threads + 1 elements), NULL for equal sections.
+ * @param balance    Output parameter: the busy and idle time of each thread (n_threads elements).
  *
  * @return           The Levenshtein distance calculated in a parallelized manner.
  */
-int threadPartitioning(const char* str1, const char* str2, int n_threads) {
+int threadPartitioning(const char* str1, const char* str2, int n_threads, const TuningEntry* tuning, const int* cuts1, const int* cuts2, ThreadBalance* balance) {
     // Array to store individual thread results
     int results[n_threads];
+    memset(balance, 0, n_threads * sizeof(ThreadBalance));
 
     // OpenMP parallel region
     #pragma omp parallel
     {
         // Get the thread ID
         int tid = omp_get_thread_num();
+        double start = omp_get_wtime();
 
         // Partition the input strings for each thread
-        char* local_str1 = partitioning(str1, tid, n_threads);
-        char* local_str2 = partitioning(str2, tid, n_threads);
+        char* local_str1 = (cuts1 != NULL) ? anchorPartition(str1, cuts1, tid) : partitioning(str1, tid, n_threads);
+        char* local_str2 = (cuts2 != NULL) ? anchorPartition(str2, cuts2, tid) : partitioning(str2, tid, n_threads);
 
         // Calculate Levenshtein distance for each thread
-        results[tid] = levenshteinDistance(local_str1, local_str2);
+        if (tuning != NULL && tuning->backend != BACKEND_MATRIX)
+            results[tid] = tunedLevenshtein(local_str1, local_str2, tuning);
+        else
+            results[tid] = levenshteinDistance(local_str1, local_str2);
+        progressAdd(0, 1);
 
         // Free allocated memory for local strings
         free(local_str1);
         free(local_str2);
+
+        // The thread is idle from the end of its section to the end of the slowest one
+        balance[tid].units = 1;
+        balance[tid].busy_time = omp_get_wtime() - start;
+        #pragma omp barrier
+        balance[tid].idle_time = omp_get_wtime() - start - balance[tid].busy_time;
     }
 
     // Combine individual thread results
@@ -182,6 +210,302 @@ int threadPartitioning(const char* str1, const char* str2, int n_threads) {
     return local_result;
 }
 
+/**
+ * @brief Perform Levenshtein distance calculation with the over-decomposed work-stealing scheduler.
+ *
+ * This function partitions the input strings as threadPartitioning() does, so the result is
+ * the same, but the distance matrix of each section is cut in many blocks, sized by their
+ * cells, that the threads take from their own deque or steal from the deques of the others:
+ * a thread slowed down by its core does not hold up its whole section.
+ *
+ * @param str1       The first input string.
+ * @param str2       The second input string.
+ * @param n_threads  Number of OpenMP threads.
+ * @param cuts1      The cut points of the sections in the first string (n_threads + 1 elements), NULL for equal sections.
+ * @param cuts2      The cut points of the sections in the second string (n_threads + 1 elements), NULL for equal sections.
+ * @param balance    Output parameter: the units, steals, busy and idle time of each thread.
+ *
+ * @return           The Levenshtein distance, -1 if memory allocation fails.
+ */
+int stealingThreadPartitioning(const char* str1, const char* str2, int n_threads, const int* cuts1, const int* cuts2, ThreadBalance* balance) {
+    char* local_str1[n_threads];
+    char* local_str2[n_threads];
+    int results[n_threads];
+
+    // Partition the input strings for each thread
+    for (int t = 0; t < n_threads; t++) {
+        local_str1[t] = (cuts1 != NULL) ? anchorPartition(str1, cuts1, t) : partitioning(str1, t, n_threads);
+        local_str2[t] = (cuts2 != NULL) ? anchorPartition(str2, cuts2, t) : partitioning(str2, t, n_threads);
+    }
+
+    // Calculate the Levenshtein distance of all the sections together
+    int failed = stealingLevenshtein(local_str1, local_str2, n_threads, n_threads, results, balance);
+
+    // Combine individual section results
+    int local_result = 0;
+    for (int t = 0; t < n_threads; t++) {
+        local_result += results[t];
+        free(local_str1[t]);
+        free(local_str2[t]);
+    }
+
+    return failed ? -1 : local_result;
+}
+
+/**
+ * @brief Calculates the seaweed permutation of a partition of the first string against the whole second string.
+ *
+ * This function partitions the first string among the OpenMP threads, as threadPartitioning()
+ * does, but each thread compares its partition with the whole second string and computes the
+ * seaweed permutation of its block. The blocks are then combined in a parallel reduction tree
+ * with the sticky product, in the order of the partitions, so the result is exact.
+ *
+ * @param str1       The partition of the first string.
+ * @param str2       The whole second string.
+ * @param n_threads  Number of OpenMP threads.
+ *
+ * @return           A dynamically allocated permutation of 2 * (strlen(str1) + strlen(str2))
+ *                   elements, NULL if memory allocation fails.
+ */
+int* exactThreadPartitioning(const char* str1, const char* str2, int n_threads) {
+    int m = strlen(str1);
+    int n = strlen(str2);
+    int size = 2 * (m + n);
+
+    // Array to store the permutation of each thread block
+    int* blocks[n_threads];
+    int failed = 0;
+
+    // OpenMP parallel region
+    #pragma omp parallel
+    {
+        // Get the thread ID
+        int tid = omp_get_thread_num();
+
+        // Partition the first string for each thread
+        char* local_str1 = partitioning(str1, tid, n_threads);
+        int local_len = strlen(local_str1);
+
+        // Characters of the partitions after this one
+        int local_start = tid * (m / n_threads) + fmin(tid, m % n_threads);
+        int below = m - local_start - local_len;
+
+        // Calculate the seaweed permutation of the block and extend it to the whole partition
+        int* permutation = seaweedPermutation(local_str1, local_len, str2, n);
+        progressAdd(0, 1);
+        blocks[tid] = (permutation != NULL) ? padPermutation(permutation, 2 * (local_len + n), 2 * below, size) : NULL;
+        if (blocks[tid] == NULL) {
+            #pragma omp atomic write
+            failed = 1;
+        }
+
+        // Free allocated memory
+        free(permutation);
+        free(local_str1);
+
+        // Combine the blocks in a reduction tree, keeping the order of the partitions
+        for (int step = 1; step < n_threads; step *= 2) {
+            #pragma omp barrier
+            if (!failed && tid % (2 * step) == 0 && tid + step < n_threads) {
+                int* product = stickyProduct(blocks[tid], blocks[tid + step], size);
+                if (product == NULL) {
+                    #pragma omp atomic write
+                    failed = 1;
+                }
+                free(blocks[tid]);
+                free(blocks[tid + step]);
+                blocks[tid] = product;
+            }
+        }
+    }
+
+    return failed ? NULL : blocks[0];
+}
+
+/**
+ * @brief MPI reduction operation combining the seaweed permutations of two partitions.
+ *
+ * Each element of the datatype is a whole permutation; the operation is not commutative, and
+ * MPI applies it in rank order (inout = in (sticky product) inout).
+ */
+void stickyReduce(void* in, void* inout, int* len, MPI_Datatype* datatype) {
+    int bytes;
+    MPI_Type_size(*datatype, &bytes);
+    int size = bytes / sizeof(int);
+
+    for (int e = 0; e < *len; e++) {
+        int* first = (int*)in + (size_t)e * size;
+        int* second = (int*)inout + (size_t)e * size;
+        int* product = stickyProduct(first, second, size);
+        if (product == NULL)
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        memcpy(second, product, size * sizeof(int));
+        free(product);
+    }
+}
+
+/**
+ * @brief Splits the processes by node, for the shared-memory windows.
+ *
+ * The processes of each node share node_comm (ordered by rank); the first process of each
+ * node (node rank 0) is also in leader_comm, ordered by rank, which is MPI_COMM_NULL for the
+ * others. The rank 0 is always the leader of its node and the rank 0 of leader_comm.
+ *
+ * @param rank        The rank of the process.
+ * @param node_comm   Output parameter: the communicator of the processes of the node.
+ * @param leader_comm Output parameter: the communicator of the leaders of the nodes.
+ *
+ * @return            1 if the ranks of every node are consecutive (so the partitions of a
+ *                    node are adjacent and can be combined in order on the node), 0 otherwise.
+ */
+int splitNodes(int rank, MPI_Comm* node_comm, MPI_Comm* leader_comm) {
+    int node_rank;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, node_comm);
+    MPI_Comm_rank(*node_comm, &node_rank);
+    MPI_Comm_split(MPI_COMM_WORLD, (node_rank == 0) ? 0 : MPI_UNDEFINED, rank, leader_comm);
+
+    // The ranks of the node are consecutive if they all start from the same rank
+    int first = rank - node_rank, min_first, max_first, consecutive;
+    MPI_Allreduce(&first, &min_first, 1, MPI_INT, MPI_MIN, *node_comm);
+    MPI_Allreduce(&first, &max_first, 1, MPI_INT, MPI_MAX, *node_comm);
+    consecutive = (min_first == max_first);
+    MPI_Allreduce(MPI_IN_PLACE, &consecutive, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+
+    return consecutive;
+}
+
+/**
+ * @brief Generates the two random strings once per node, in a shared-memory window.
+ *
+ * The first process of the node allocates the window and generates both strings in it; the
+ * other processes map the same memory, so the node holds a single copy of the inputs.
+ *
+ * @param n_characters The length of the strings.
+ * @param seed1        The seed of the first string.
+ * @param seed2        The seed of the second string.
+ * @param node_comm    The communicator of the processes of the node.
+ * @param win          Output parameter: the window, to free with MPI_Win_free().
+ *
+ * @return             The first string, followed by the second one.
+ */
+char* sharedStrings(int n_characters, int seed1, int seed2, MPI_Comm node_comm, MPI_Win* win) {
+    int node_rank;
+    MPI_Comm_rank(node_comm, &node_rank);
+
+    // Only the first process of the node allocates memory for the strings
+    MPI_Aint bytes = (node_rank == 0) ? 2 * ((MPI_Aint)n_characters + 1) : 0;
+    char* strings;
+    MPI_Win_allocate_shared(bytes, sizeof(char), MPI_INFO_NULL, node_comm, &strings, win);
+
+    MPI_Win_fence(0, *win);
+    if (node_rank == 0) {
+        fillRandomString(strings, n_characters, seed1);
+        fillRandomString(strings + n_characters + 1, n_characters, seed2);
+    }
+    MPI_Win_fence(0, *win);
+
+    // Map the memory of the first process
+    int disp_unit;
+    MPI_Win_shared_query(*win, 0, &bytes, &disp_unit, &strings);
+
+    return strings;
+}
+
+/**
+ * @brief Sums the results of all the processes, through shared memory within each node.
+ *
+ * Each process writes its result in its slot of a node window, the first process of the node
+ * sums the slots, and only the sums of the nodes are sent to the rank 0.
+ *
+ * @param local_result The result of the process.
+ * @param node_comm    The communicator of the processes of the node.
+ * @param leader_comm  The communicator of the leaders of the nodes.
+ *
+ * @return             The sum of all the results on the rank 0, undefined on the others.
+ */
+int sharedSum(int local_result, MPI_Comm node_comm, MPI_Comm leader_comm) {
+    int node_rank, node_size, result = 0;
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+
+    int* slot;
+    MPI_Win win;
+    MPI_Win_allocate_shared(sizeof(int), sizeof(int), MPI_INFO_NULL, node_comm, &slot, &win);
+
+    MPI_Win_fence(0, win);
+    *slot = local_result;
+    MPI_Win_fence(0, win);
+
+    // The first process of the node sums the slots and sends the sum of the node
+    if (node_rank == 0) {
+        int node_result = 0;
+        for (int r = 0; r < node_size; r++) {
+            MPI_Aint bytes;
+            int disp_unit;
+            int* other;
+            MPI_Win_shared_query(win, r, &bytes, &disp_unit, &other);
+            node_result += *other;
+        }
+        MPI_Reduce(&node_result, &result, 1, MPI_INT, MPI_SUM, 0, leader_comm);
+    }
+
+    MPI_Win_free(&win);
+
+    return result;
+}
+
+/**
+ * @brief Combines the seaweed permutations of all the processes, through shared memory within each node.
+ *
+ * Each process copies its permutation in its slot of a node window, and the permutations of
+ * the node are combined in a reduction tree with the sticky product, in rank order, reading
+ * the slots of the other processes in place; only the products of the nodes are then combined
+ * by the leaders with MPI. It requires the ranks of each node to be consecutive.
+ *
+ * @param local_permutation The permutation of the process, of total elements.
+ * @param total             The number of elements of a permutation.
+ * @param node_comm         The communicator of the processes of the node.
+ * @param leader_comm       The communicator of the leaders of the nodes.
+ * @param permutation_type  The MPI datatype of a whole permutation.
+ * @param sticky_op         The MPI operation combining two permutations.
+ * @param permutation       Output parameter: the combined permutation (used on the rank 0 only).
+ */
+void sharedStickyReduce(const int* local_permutation, int total, MPI_Comm node_comm, MPI_Comm leader_comm, MPI_Datatype permutation_type, MPI_Op sticky_op, int* permutation) {
+    int node_rank, node_size;
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+
+    int* slot;
+    MPI_Win win;
+    MPI_Win_allocate_shared((MPI_Aint)total * sizeof(int), sizeof(int), MPI_INFO_NULL, node_comm, &slot, &win);
+
+    MPI_Win_fence(0, win);
+    memcpy(slot, local_permutation, total * sizeof(int));
+    MPI_Win_fence(0, win);
+
+    // Combine the slots in a reduction tree, keeping the order of the ranks
+    for (int step = 1; step < node_size; step *= 2) {
+        if (node_rank % (2 * step) == 0 && node_rank + step < node_size) {
+            MPI_Aint bytes;
+            int disp_unit;
+            int* next;
+            MPI_Win_shared_query(win, node_rank + step, &bytes, &disp_unit, &next);
+            int* product = stickyProduct(slot, next, total);
+            if (product == NULL)
+                MPI_Abort(MPI_COMM_WORLD, 1);
+            memcpy(slot, product, total * sizeof(int));
+            free(product);
+        }
+        MPI_Win_fence(0, win);
+    }
+
+    // Combine the products of the nodes in rank order
+    if (node_rank == 0)
+        MPI_Reduce(slot, permutation, 1, permutation_type, sticky_op, 0, leader_comm);
+
+    MPI_Win_free(&win);
+}
+
 /**
  * @brief Appends timing information to a CSV file.
  *
@@ -190,7 +514,10 @@ int threadPartitioning(const char* str1, const char* str2, int n_threads) {
  * the timing for Edit Distance algorithm execution, 
  * the timing for overall program execution, the number of OpenMP threads used, 
  * and the number of MPI processes used as input parameters.
- * It then appends the information to a CSV file in a formatted string.
+ * It then appends the information to a CSV file in a formatted string, followed by the memory
+ * columns: the peak RSS and the allocated bytes of each phase, the bytes allocated by the
+ * busiest thread of the kernel, the number of allocations and the kernel bytes per DP cell, and
+ * by the energy columns (see printEnergyToCSV()).
  *
  * @param n_characters       Number of characters used in the program.
  * @param opt                Optimization level used in the program.
@@ -200,8 +527,12 @@ int threadPartitioning(const char* str1, const char* str2, int n_threads) {
  * @param execution_time     Total execution time.
  * @param omp_threads        Number of OpenMP threads used.
  * @param mpi_process        Number of MPI processes used.
+ * @param modality           "OMP+MPI" for the approximate sum of the partitions, "Exact" for the exact combination.
+ * @param phases             Memory used by the phases (generation, partitioning, kernel) of all the processes.
+ * @param energy             Energy used by the phases on all the nodes.
+ * @param cells              DP cells computed by all the processes.
  */
-void printTimeToCSV(int n_characters, int opt, double create_time, double comunication_time, double edit_distance_time, double execution_time, int omp_threads, int mpi_process) {
+void printTimeToCSV(int n_characters, int opt, double create_time, double comunication_time, double edit_distance_time, double execution_time, int omp_threads, int mpi_process, const char* modality, const MemoryPhase* phases, const EnergyPhase* energy, double cells) {
     // Define the file path
     char path[200];
     sprintf(path, "Informations/OMP_MPI/opt%d/%d.csv", opt, n_characters); 
@@ -218,7 +549,55 @@ void printTimeToCSV(int n_characters, int opt, double create_time, double comuni
     }
 
     // Print timing information to the CSV file
-    fprintf(fp, "OMP+MPI;%d;%d;%06f;%06f;%06f;%06f;\n", omp_threads, mpi_process, create_time, comunication_time, edit_distance_time, execution_time);
+    fprintf(fp, "%s;%d;%d;%06f;%06f;%06f;%06f;", modality, omp_threads, mpi_process, create_time, comunication_time, edit_distance_time, execution_time);
+
+    // Print memory information to the CSV file
+    printMemoryToCSV(fp, phases, cells);
+
+    // Print energy information to the CSV file
+    printEnergyToCSV(fp, energy, cells);
+
+    // Close the file
+    fclose(fp);
+}
+
+/**
+ * @brief Appends the work done by each thread of each process to a CSV file.
+ *
+ * Each line holds the modality, the number of OpenMP threads and MPI processes, the rank and
+ * the thread, the number of work units computed and stolen by the thread, and its busy and
+ * idle time: the idle time of the threads shows the imbalance of the run.
+ *
+ * @param n_characters The number of characters used in the program.
+ * @param opt          The type of optimization used.
+ * @param omp_threads  The number of OpenMP threads used.
+ * @param mpi_process  The number of MPI processes used.
+ * @param modality     "OMP+MPI" for one section for each thread, "OMP+MPI_Steal" for the work-stealing scheduler.
+ * @param balance      The work of the threads of all the processes, by rank (4 values for each thread).
+ */
+void printBalanceToCSV(int n_characters, int opt, int omp_threads, int mpi_process, const char* modality, const double* balance) {
+    // Define the file path
+    char path[200];
+    sprintf(path, "Informations/Balance/opt%d/%d.csv", opt, n_characters);
+    char *filename = path;
+
+    // Open the file for appending
+    FILE *fp = fopen(filename, "a+");
+
+    // Check if the file can be opened
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", filename);
+        return;
+    }
+
+    // Print a line for each thread of each process
+    for (int r = 0; r < mpi_process; r++) {
+        for (int t = 0; t < omp_threads; t++) {
+            const double* thread = balance + 4 * ((size_t)r * omp_threads + t);
+            fprintf(fp, "%s;%d;%d;%d;%d;%.0f;%.0f;%06f;%06f\n", modality, omp_threads, mpi_process, r, t, thread[0], thread[1], thread[2], thread[3]);
+        }
+    }
 
     // Close the file
     fclose(fp);
@@ -237,8 +616,9 @@ void printTimeToCSV(int n_characters, int opt, double create_time, double comuni
  * @param distance     The result of the Edit Distance calculation.
  * @param omp_threads  The number of OpenMP threads used.
  * @param mpi_process  The number of MPI processes used.
+ * @param modality     "OMP+MPI" for the approximate sum of the partitions, "Exact" for the exact combination.
  */
-void printResultToCSV(int n_characters, int opt, int distance, int omp_threads, int mpi_process) {
+void printResultToCSV(int n_characters, int opt, int distance, int omp_threads, int mpi_process, const char* modality) {
     // Define the file path
     char path[200];
     sprintf(path, "EditDistanceReport/OMP_MPI/opt%d/%d.csv", opt, n_characters); 
@@ -255,7 +635,7 @@ void printResultToCSV(int n_characters, int opt, int distance, int omp_threads,
     }
 
     // Print the formatted string to the CSV file
-    fprintf(fp, "OMP+MPI;%d;%d;%d\n", omp_threads, mpi_process, distance);
+    fprintf(fp, "%s;%d;%d;%d\n", modality, omp_threads, mpi_process, distance);
 
     // Close the file
     fclose(fp);
@@ -267,7 +647,24 @@ void printResultToCSV(int n_characters, int opt, int distance, int omp_threads,
  * This program generates random strings, partitions them for parallel processing,
  * calculates the Edit Distance in a distributed manner, and records the timing information.
  * The results are then printed to CSV files. MPI is used for parallelism among processes,
- * and OpenMP is used for parallelism within each process.
+ * and OpenMP is used for parallelism within each process. With the "exact" argument each
+ * partition of the first string is compared with the whole second string, and the seaweed
+ * permutations of the partitions are combined exactly in place of the sum. With the "shared"
+ * argument the processes of a node map a single copy of the strings from an MPI shared-memory
+ * window, and the results of the processes of a node are combined through shared memory, so
+ * that only one message for each node is exchanged. With the "steal" argument the sections
+ * of the threads are cut in many blocks run by a work-stealing scheduler (not with "exact").
+ * With the "anchor" argument the strings are cut at k-mers that occur once in both of them, in
+ * place of the same offsets, so the partitions stay aligned when a string is shifted with
+ * respect to the other (not with "exact").
+ * The busy and idle time of each thread are appended to "Informations/Balance". While the
+ * Edit Distance is computed, the progress of each process is published in /dev/shm for
+ * Edit_Distance_Stat (edstat).
+ *
+ * With the "tuned" argument the configuration of the host written by the autotuner
+ * (Tuning/<hostname>.csv) is loaded: the entry of the closest input size selects the kernel of
+ * the partitions, and a number of threads of 0 selects the tuned number of threads (not with
+ * "exact", whose permutations do not use the partition kernels).
  *
  * @param argc Number of command line arguments.
  * @param argv Array of command line argument strings.
@@ -282,15 +679,19 @@ int main(int argc, char** argv) {
     struct timeval execution_start, execution_stop, string_generation_start, string_generation_stop, edit_distance_start, edit_distance_stop;
     double execution_time, create_time, edit_distance_time, communication_time;
 
+    // Memory and energy used by each phase
+    MemoryPhase phases[N_PHASES];
+    EnergyPhase energy[N_PHASES];
+
     // MPI rank and size variables
     int rank, size;
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     MPI_Comm_size(MPI_COMM_WORLD, &size);
 
     // Check if the correct number of command line arguments is provided
-    if (argc != 7) {
+    if (argc < 7 || argc > 12) {
         if (rank == 0) {
-            fprintf(stderr, "Usage: %s <n_characters> <seed1> <seed2> <opt> <n_threads>\n", argv[0]);
+            fprintf(stderr, "Usage: %s <n_characters> <seed1> <seed2> <opt> <n_threads> -fopenmp [exact] [shared] [steal] [anchor] [tuned]\n", argv[0]);
         }
         MPI_Finalize();
         return 1;
@@ -302,6 +703,62 @@ int main(int argc, char** argv) {
     int seed2 = atoi(argv[3]);
     int opt = atoi(argv[4]);
     int n_threads = atoi(argv[5]);
+    int exact = 0, shared = 0, steal = 0, anchor = 0, tuned = 0;
+    for (int a = 7; a < argc; a++) {
+        if (strcmp(argv[a], "exact") == 0)
+            exact = 1;
+        else if (strcmp(argv[a], "shared") == 0)
+            shared = 1;
+        else if (strcmp(argv[a], "steal") == 0)
+            steal = 1;
+        else if (strcmp(argv[a], "anchor") == 0)
+            anchor = 1;
+        else if (strcmp(argv[a], "tuned") == 0)
+            tuned = 1;
+    }
+    anchor = anchor && !exact;
+
+    // Split the processes by node for the shared-memory windows
+    MPI_Comm node_comm = MPI_COMM_NULL, leader_comm = MPI_COMM_NULL;
+    MPI_Win strings_win = MPI_WIN_NULL;
+    int consecutive = 0;
+    if (shared) {
+        consecutive = splitNodes(rank, &node_comm, &leader_comm);
+        if (exact && !consecutive && rank == 0)
+            fprintf(stderr, "The ranks of the nodes are not consecutive: the permutations are combined with messages.\n");
+    }
+
+    // Only the first process of each node reads the energy counters, which belong to the node
+    MPI_Comm energy_comm;
+    int node_rank;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &energy_comm);
+    MPI_Comm_rank(energy_comm, &node_rank);
+    MPI_Comm_free(&energy_comm);
+    int energy_domains = (node_rank == 0) ? energyInit() : 0;
+
+    // Load the configuration of the host, only when it is requested and the partition kernels are used
+    char tuning_path[300];
+    TuningConfig tuning_config = { 0, NULL };
+    const TuningEntry* tuning = NULL;
+    if (tuned && exact && rank == 0)
+        fprintf(stderr, "The exact mode does not use the tuned configuration: it is ignored.\n");
+    if (tuned && !exact) {
+        tuningConfigPath(tuning_path, sizeof(tuning_path));
+        if (loadTuningConfig(tuning_path, &tuning_config) != 0 && rank == 0)
+            fprintf(stderr, "File %s can not be opened: the distance matrix is used.\n", tuning_path);
+        tuning = findTuningEntry(&tuning_config, n_characters);
+    }
+    if (n_threads <= 0)
+        n_threads = (tuning != NULL) ? tuning->omp_threads : 1;
+
+    // Each option is a suffix of the modality, so the runs with and without it are not averaged together
+    char modality[64];
+    snprintf(modality, sizeof(modality), "%s%s%s%s%s", exact ? "Exact" : "OMP+MPI", (steal && !exact) ? "_Steal" : "", anchor ? "_Anchor" : "",
+             shared ? "_Shared" : "", (tuning != NULL) ? "_Tuned" : "");
+
+    // Build the lookup table of the Four-Russians backend before the timed phases
+    if (tuning != NULL && tuning->backend == BACKEND_RUSSIANS)
+        fourRussiansInit();
 
     // Set the number of OpenMP threads
     omp_set_num_threads(n_threads);
@@ -311,8 +768,18 @@ int main(int argc, char** argv) {
 
     // Generate random strings
     gettimeofday(&string_generation_start, NULL);
-    char* str1 = generateRandomString(n_characters, seed1);
-    char* str2 = generateRandomString(n_characters, seed2);
+    memoryPhaseStart();
+    energyPhaseStart();
+    char *str1, *str2;
+    if (shared) {
+        str1 = sharedStrings(n_characters, seed1, seed2, node_comm, &strings_win);
+        str2 = str1 + n_characters + 1;
+    } else {
+        str1 = generateRandomString(n_characters, seed1);
+        str2 = generateRandomString(n_characters, seed2);
+    }
+    energyPhaseStop(&energy[PHASE_GENERATION]);
+    memoryPhaseStop(&phases[PHASE_GENERATION]);
     gettimeofday(&string_generation_stop, NULL);
 
     // Calculate the time taken for string generation
@@ -322,23 +789,127 @@ int main(int argc, char** argv) {
     gettimeofday(&edit_distance_start, NULL);
 
     // Partition strings and calculate Edit Distance in parallel
-    char* local_str1 = partitioning(str1, rank, size);
-    char* local_str2 = partitioning(str2, rank, size);
+    memoryPhaseStart();
+    energyPhaseStart();
+    char* local_str1;
+    char* local_str2;
+    int thread_cuts1[n_threads + 1], thread_cuts2[n_threads + 1];
+    if (anchor) {
+        // Cut points of the sections of all the threads of all the processes, at shared unique k-mers
+        int n_parts = size * n_threads;
+        int* cuts1 = (int*)malloc((n_parts + 1) * sizeof(int));
+        int* cuts2 = (int*)malloc((n_parts + 1) * sizeof(int));
+        if (cuts1 == NULL || cuts2 == NULL) {
+            fprintf(stderr, "ERROR in memory allocation.\n");
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        anchorCuts(str1, n_characters, str2, n_characters, n_parts, cuts1, cuts2);
+
+        // The partition of the process holds the sections of its threads
+        int first = rank * n_threads;
+        int process_cuts1[2] = { cuts1[first], cuts1[first + n_threads] };
+        int process_cuts2[2] = { cuts2[first], cuts2[first + n_threads] };
+        local_str1 = anchorPartition(str1, process_cuts1, 0);
+        local_str2 = anchorPartition(str2, process_cuts2, 0);
+        for (int t = 0; t <= n_threads; t++) {
+            thread_cuts1[t] = cuts1[first + t] - process_cuts1[0];
+            thread_cuts2[t] = cuts2[first + t] - process_cuts2[0];
+        }
+        free(cuts1);
+        free(cuts2);
+    } else {
+        local_str1 = partitioning(str1, rank, size);
+        local_str2 = partitioning(str2, rank, size);
+    }
+    energyPhaseStop(&energy[PHASE_PARTITIONING]);
+    memoryPhaseStop(&phases[PHASE_PARTITIONING]);
+
+    // Publish the progress of the process, with the cells of its threads
+    long long total_cells = 0;
+    int local_len1 = strlen(local_str1), local_len2 = strlen(local_str2);
+    if (exact)
+        total_cells = (long long)local_len1 * n_characters;
+    else if (anchor)
+        for (int t = 0; t < n_threads; t++)
+            total_cells += (long long)(thread_cuts1[t + 1] - thread_cuts1[t]) * (thread_cuts2[t + 1] - thread_cuts2[t]);
+    else
+        for (int t = 0; t < n_threads; t++)
+            total_cells += (long long)(local_len1 / n_threads + (t < local_len1 % n_threads)) * (local_len2 / n_threads + (t < local_len2 % n_threads));
+    progressOpen(n_threads, rank, total_cells);
 
     // Synchronize before calculating Edit Distance in parallel
     MPI_Barrier(MPI_COMM_WORLD);
+    memoryPhaseStart();
+    energyPhaseStart();
 
-    int local_result = threadPartitioning(local_str1, local_str2, n_threads);
     int ED;
-
-    //Calculation the communication time
     double temptime;
-    temptime = MPI_Wtime();
-
-    // Sum the partial results
-    MPI_Reduce(&local_result, &ED, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    ThreadBalance balance[n_threads];
+
+    if (!exact) {
+        int local_result;
+        if (steal)
+            local_result = stealingThreadPartitioning(local_str1, local_str2, n_threads, anchor ? thread_cuts1 : NULL, anchor ? thread_cuts2 : NULL, balance);
+        else
+            local_result = threadPartitioning(local_str1, local_str2, n_threads, tuning, anchor ? thread_cuts1 : NULL, anchor ? thread_cuts2 : NULL, balance);
+        if (local_result < 0)
+            MPI_Abort(MPI_COMM_WORLD, 1);
+
+        //Calculation the communication time
+        temptime = MPI_Wtime();
+
+        // Sum the partial results
+        if (shared)
+            ED = sharedSum(local_result, node_comm, leader_comm);
+        else
+            MPI_Reduce(&local_result, &ED, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+
+        communication_time = MPI_Wtime() - temptime;
+    } else {
+        // Each rank compares its partition of the first string with the whole second string
+        int local_len = strlen(local_str1);
+        int local_start = rank * (n_characters / size) + fmin(rank, n_characters % size);
+        int total = 2 * (n_characters + n_characters);
+
+        int* block = exactThreadPartitioning(local_str1, str2, n_threads);
+        int* local_permutation = (block != NULL) ? padPermutation(block, 2 * (local_len + n_characters), 2 * (n_characters - local_start - local_len), total) : NULL;
+        // With the shared-memory combination only the rank 0 receives the permutation
+        int receives = (rank == 0 || !(shared && consecutive));
+        int* permutation = receives ? (int*)malloc(total * sizeof(int)) : NULL;
+        if (local_permutation == NULL || (receives && permutation == NULL))
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        free(block);
+
+        //Calculation the communication time
+        temptime = MPI_Wtime();
+
+        // Combine the permutations of the partitions in rank order (a whole permutation is one element)
+        MPI_Datatype permutation_type;
+        MPI_Op sticky_op;
+        MPI_Type_contiguous(total, MPI_INT, &permutation_type);
+        MPI_Type_commit(&permutation_type);
+        MPI_Op_create(stickyReduce, 0, &sticky_op);
+
+        if (shared && consecutive)
+            sharedStickyReduce(local_permutation, total, node_comm, leader_comm, permutation_type, sticky_op, permutation);
+        else
+            MPI_Reduce(local_permutation, permutation, 1, permutation_type, sticky_op, 0, MPI_COMM_WORLD);
+
+        MPI_Op_free(&sticky_op);
+        MPI_Type_free(&permutation_type);
+
+        communication_time = MPI_Wtime() - temptime;
+
+        if (rank == 0)
+            ED = permutationDistance(permutation, n_characters, n_characters);
+
+        free(local_permutation);
+        free(permutation);
+    }
 
-    communication_time = MPI_Wtime() - temptime;
+    energyPhaseStop(&energy[PHASE_KERNEL]);
+    memoryPhaseStop(&phases[PHASE_KERNEL]);
+    progressClose();
 
     free(local_str1);
     free(local_str2);
@@ -355,14 +926,73 @@ int main(int argc, char** argv) {
     // Calculate the total execution time
     execution_time = getTotalTime(execution_start, execution_stop);
 
+    // Gather the memory of all the processes: the bytes are summed, the busiest thread is the maximum
+    long long local_memory[4 * N_PHASES], sum_memory[4 * N_PHASES], max_memory[4 * N_PHASES];
+    for (int p = 0; p < N_PHASES; p++) {
+        local_memory[4 * p] = phases[p].peak_rss;
+        local_memory[4 * p + 1] = phases[p].allocated;
+        local_memory[4 * p + 2] = phases[p].thread_allocated;
+        local_memory[4 * p + 3] = phases[p].allocations;
+    }
+    MPI_Reduce(local_memory, sum_memory, 4 * N_PHASES, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(local_memory, max_memory, 4 * N_PHASES, MPI_LONG_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+    for (int p = 0; p < N_PHASES; p++) {
+        phases[p].peak_rss = sum_memory[4 * p];
+        phases[p].allocated = sum_memory[4 * p + 1];
+        phases[p].thread_allocated = max_memory[4 * p + 2];
+        phases[p].allocations = sum_memory[4 * p + 3];
+    }
+
+    // Sum the energy of the nodes and the cells of the processes: the energy is missing if a node cannot read it
+    double local_energy[2 * N_PHASES + 4], sum_energy[2 * N_PHASES + 4];
+    for (int p = 0; p < N_PHASES; p++) {
+        local_energy[2 * p] = fmax(energy[p].package, 0);
+        local_energy[2 * p + 1] = fmax(energy[p].dram, 0);
+    }
+    local_energy[2 * N_PHASES] = (node_rank == 0);
+    local_energy[2 * N_PHASES + 1] = (energy_domains & ENERGY_PACKAGE) ? 1 : 0;
+    local_energy[2 * N_PHASES + 2] = (energy_domains & ENERGY_DRAM) ? 1 : 0;
+    local_energy[2 * N_PHASES + 3] = total_cells;
+    MPI_Reduce(local_energy, sum_energy, 2 * N_PHASES + 4, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    for (int p = 0; p < N_PHASES; p++) {
+        energy[p].package = (sum_energy[2 * N_PHASES + 1] == sum_energy[2 * N_PHASES]) ? sum_energy[2 * p] : -1;
+        energy[p].dram = (sum_energy[2 * N_PHASES + 2] == sum_energy[2 * N_PHASES]) ? sum_energy[2 * p + 1] : -1;
+    }
+
+    // Gather the work of the threads of all the processes
+    double* all_balance = NULL;
+    if (!exact) {
+        double local_balance[4 * n_threads];
+        for (int t = 0; t < n_threads; t++) {
+            local_balance[4 * t] = balance[t].units;
+            local_balance[4 * t + 1] = balance[t].stolen;
+            local_balance[4 * t + 2] = balance[t].busy_time;
+            local_balance[4 * t + 3] = balance[t].idle_time;
+        }
+        if (rank == 0)
+            all_balance = (double*)malloc(4 * (size_t)n_threads * size * sizeof(double));
+        MPI_Gather(local_balance, 4 * n_threads, MPI_DOUBLE, all_balance, 4 * n_threads, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    }
+
     // Print timing information and Edit Distance result to CSV (only by rank 0)
     if (rank == 0) {
-        printTimeToCSV(n_characters, opt, create_time, communication_time, edit_distance_time, execution_time, n_threads, size);
-        printResultToCSV(n_characters, opt, ED, n_threads, size);
+        printTimeToCSV(n_characters, opt, create_time, communication_time, edit_distance_time, execution_time, n_threads, size, modality, phases, energy, sum_energy[2 * N_PHASES + 3]);
+        printResultToCSV(n_characters, opt, ED, n_threads, size, modality);
+        if (all_balance != NULL)
+            printBalanceToCSV(n_characters, opt, n_threads, size, modality, all_balance);
     }
-
-    free(str1);
-    free(str2);
+    free(all_balance);
+
+    if (shared) {
+        MPI_Win_free(&strings_win);
+        if (leader_comm != MPI_COMM_NULL)
+            MPI_Comm_free(&leader_comm);
+        MPI_Comm_free(&node_comm);
+    } else {
+        free(str1);
+        free(str2);
+    }
+    freeTuningConfig(&tuning_config);
 
     // MPI Finalization
     MPI_Finalize();
@@ -0,0 +1,146 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "Mapped_File.h"
+#include "Pattern_Search.h"
+//Number of text characters of a chunk
+#define CHUNK_SIZE (1024LL * 1024LL)
+//Number of chunks of each thread searched before printing their occurrences
+#define CHUNKS_PER_ROUND 4
+
+/**
+ * @brief The occurrences found in a chunk of the text.
+ */
+typedef struct {
+    PatternMatch* matches;  /**< The occurrences, in order of position. */
+    int n_matches;          /**< Number of occurrences. */
+    int capacity;           /**< Capacity of the array. */
+} ChunkMatches;
+
+/**
+ * @brief Main function for the approximate pattern search program.
+ *
+ * This program maps the text file in memory and finds every position where an occurrence of
+ * the pattern with at most k errors ends (semi-global alignment). The text is split in chunks
+ * of CHUNK_SIZE characters searched in parallel by the OpenMP threads; each chunk also scans
+ * the pattern length + k characters before it, so the occurrences crossing the chunk borders
+ * are found with their exact cost. The chunks are searched in rounds and the occurrences of a
+ * round are printed in order of position ("position;cost", the position of the last character)
+ * before the next one, so the memory does not grow with the text.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    // Check if the correct number of command line arguments is provided
+    if (argc != 5) {
+        fprintf(stderr, "Usage: %s <text_file> <pattern> <k> <n_threads>\n", argv[0]);
+        return 1;
+    }
+
+    // Parse command line arguments
+    char* text_path = argv[1];
+    char* pattern = argv[2];
+    int k = atoi(argv[3]);
+    int n_threads = atoi(argv[4]);
+    int length = strlen(pattern);
+
+    if (length == 0 || k < 0) {
+        fprintf(stderr, "The pattern must not be empty and k must not be negative.\n");
+        return 1;
+    }
+
+    // Set the number of OpenMP threads
+    omp_set_num_threads(n_threads);
+
+    // Map the text and build the masks of the pattern
+    MappedFile text;
+    if (mapFile(text_path, &text) != 0)
+        return 1;
+    PatternMask mask;
+    if (compilePattern(pattern, length, &mask) != 0)
+        return 1;
+
+    long long text_len = (long long)text.size;
+    long long n_chunks = (text_len + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    long long overlap = (long long)length + k;
+    int round_size = n_threads * CHUNKS_PER_ROUND;
+
+    ChunkMatches* round = (ChunkMatches*)calloc(round_size, sizeof(ChunkMatches));
+    if (round == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+
+    long long total_matches = 0;
+    int failed = 0;
+    double search_start = omp_get_wtime();
+
+    for (long long first = 0; first < n_chunks && !failed; first += round_size) {
+        int n_round = (n_chunks - first < round_size) ? (int)(n_chunks - first) : round_size;
+
+        // Search the chunks of the round in parallel
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int c = 0; c < n_round; c++) {
+            long long begin = (first + c) * CHUNK_SIZE;
+            long long end = (begin + CHUNK_SIZE < text_len) ? begin + CHUNK_SIZE : text_len;
+            long long scan_begin = (begin > overlap) ? begin - overlap : 0;
+
+            round[c].n_matches = 0;
+            if (searchPattern(&mask, text.data, scan_begin, begin, end, k, &round[c].matches, &round[c].n_matches, &round[c].capacity) != 0) {
+                #pragma omp atomic write
+                failed = 1;
+            }
+        }
+
+        // Print the occurrences of the round in order of position
+        for (int c = 0; c < n_round; c++) {
+            for (int i = 0; i < round[c].n_matches; i++)
+                printf("%lld;%d\n", round[c].matches[i].position, round[c].matches[i].cost);
+            total_matches += round[c].n_matches;
+        }
+    }
+
+    double search_time = omp_get_wtime() - search_start;
+
+    // Print the statistics of the search
+    printf("Text;%lld;Pattern;%d;k;%d;Matches;%lld;Time;%06f;MB/s;%.2f\n", text_len, length, k, total_matches,
+           search_time, search_time > 0 ? text_len / search_time / (1024.0 * 1024.0) : 0.0);
+
+    // Free allocated memory
+    for (int c = 0; c < round_size; c++)
+        free(round[c].matches);
+    free(round);
+    freePattern(&mask);
+    unmapFile(&text);
+
+    return failed ? 1 : 0;
+}
@@ -28,6 +28,8 @@
 #include <math.h>
 #include <sys/time.h>
 #include "Random_String_Generator.h"
+#include "Memory_Accounting.h"
+#include "Energy.h"
 //Constant for the time conversion
 #define SEC_CONV 1000000
 
@@ -87,7 +89,8 @@ int levenshteinDistance(const char* str1, const char* str2) {
  * the timing for string generation, the timing for Edit Distance algorithm execution, 
  * the timing for overall program execution, the number of OpenMP threads used, 
  * and the number of MPI processes used as input parameters (just for the compare with the parallel version).
- * It then appends the information to a CSV file in a formatted string.
+ * It then appends the information to a CSV file in a formatted string, followed by the same
+ * memory columns of the parallel version.
  *
  * @param n_characters      The number of characters used in the program.
  * @param opt               The type of optimization used.
@@ -96,9 +99,11 @@ int levenshteinDistance(const char* str1, const char* str2) {
  * @param execution_time    The total time taken for the entire program execution.
  * @param omp_threads       The number of OpenMP threads (just for the split).
  * @param mpi_process       The number of MPI processes (just for the split).
- * @param directory    The directory where to put the results.
+ * @param phases            Memory used by the phases (generation, partitioning, kernel).
+ * @param energy            Energy used by the phases.
+ * @param cells             DP cells computed by the kernel.
  */
-void printTimeToCSV(int n_characters, int opt, double create_time, double edit_distance_time, double execution_time, int omp_threads, int mpi_process) {
+void printTimeToCSV(int n_characters, int opt, double create_time, double edit_distance_time, double execution_time, int omp_threads, int mpi_process, const MemoryPhase* phases, const EnergyPhase* energy, double cells) {
     // Define the file path
     char path[200];
     sprintf(path, "Informations/OMP_MPI/opt%d/%d.csv", opt, n_characters); 
@@ -114,7 +119,13 @@ void printTimeToCSV(int n_characters, int opt, double create_time, double edit_d
         return;
     }
 
-    fprintf(fp, "Approximate;%d;%d;%06f;0.0;%06f;%06f;\n", omp_threads, mpi_process, create_time, edit_distance_time, execution_time);
+    fprintf(fp, "Approximate;%d;%d;%06f;0.0;%06f;%06f;", omp_threads, mpi_process, create_time, edit_distance_time, execution_time);
+
+    // Print memory information to the CSV file
+    printMemoryToCSV(fp, phases, cells);
+
+    // Print energy information to the CSV file
+    printEnergyToCSV(fp, energy, cells);
 
     // Close the file
     fclose(fp);
@@ -245,13 +256,22 @@ int main(int argc, char* argv[]) {
     struct timeval execution_start, execution_stop, string_generation_start, string_generation_stop, edit_distance_start, edit_distance_stop;
     double execution_time, create_time, edit_distance_time;
 
+    // Memory and energy used by each phase
+    MemoryPhase phases[N_PHASES];
+    EnergyPhase energy[N_PHASES];
+    energyInit();
+
     // Record the start time of the entire program
     gettimeofday(&execution_start, NULL);
 
     // Generate random strings
     gettimeofday(&string_generation_start, NULL);
+    memoryPhaseStart();
+    energyPhaseStart();
     char* X = generateRandomString(n_characters, seed1);
     char* Y = generateRandomString(n_characters, seed2);
+    energyPhaseStop(&energy[PHASE_GENERATION]);
+    memoryPhaseStop(&phases[PHASE_GENERATION]);
     gettimeofday(&string_generation_stop, NULL);
 
     // Calculate the time taken for string generation
@@ -262,24 +282,39 @@ int main(int argc, char* argv[]) {
     // Record the start time of the Edit Distance calculation
     gettimeofday(&edit_distance_start, NULL);
 
-    // Partition strings and calculate Edit Distance
+    // Partition strings among the processes
+    memoryPhaseStart();
+    energyPhaseStart();
+    char* process_str1[mpi_process];
+    char* process_str2[mpi_process];
     for (int i = 0; i < mpi_process; i++) {
-        char* process_str1 = partitioning(X, i, mpi_process);
-        char* process_str2 = partitioning(Y, i, mpi_process);
+        process_str1[i] = partitioning(X, i, mpi_process);
+        process_str2[i] = partitioning(Y, i, mpi_process);
+    }
+    energyPhaseStop(&energy[PHASE_PARTITIONING]);
+    memoryPhaseStop(&phases[PHASE_PARTITIONING]);
 
+    // Calculate Edit Distance of the partitions of the threads
+    double cells = 0;
+    memoryPhaseStart();
+    energyPhaseStart();
+    for (int i = 0; i < mpi_process; i++) {
         for (int j = 0; j < omp_threads; j++) {
-            char* thread_str1 = partitioning(process_str1, j, omp_threads);
-            char* thread_str2 = partitioning(process_str2, j, omp_threads);
+            char* thread_str1 = partitioning(process_str1[i], j, omp_threads);
+            char* thread_str2 = partitioning(process_str2[i], j, omp_threads);
 
             ED += levenshteinDistance(thread_str1, thread_str2);
+            cells += (double)strlen(thread_str1) * strlen(thread_str2);
 
             free(thread_str1);
             free(thread_str2);
         }
 
-        free(process_str1);
-        free(process_str2);
+        free(process_str1[i]);
+        free(process_str2[i]);
     }
+    energyPhaseStop(&energy[PHASE_KERNEL]);
+    memoryPhaseStop(&phases[PHASE_KERNEL]);
 
     // Record the stop time of the Edit Distance calculation
     gettimeofday(&edit_distance_stop, NULL);
@@ -294,7 +329,7 @@ int main(int argc, char* argv[]) {
     execution_time = getTotalTime(execution_start, execution_stop);
 
     // Print timing information to CSV
-    printTimeToCSV(n_characters, opt, create_time, edit_distance_time, execution_time, omp_threads, mpi_process);
+    printTimeToCSV(n_characters, opt, create_time, edit_distance_time, execution_time, omp_threads, mpi_process, phases, energy, cells);
 
     // Print Edit Distance result to CSV
     printResultToCSV(n_characters, opt, ED, omp_threads, mpi_process);
@@ -28,34 +28,29 @@
 #include <math.h>
 #include <sys/time.h>
 #include "Random_String_Generator.h"
+#include "Arena.h"
+#include "Batch_Levenshtein.h"
 //Constant for the time conversion
 #define SEC_CONV 1000000
 
 /**
- * @brief Calculates the Levenshtein distance between two strings.
+ * @brief Calculates the Levenshtein distance between two strings in a given distance matrix.
  *
  * The Levenshtein distance is the minimum number of single-character edits 
  * (insertions, deletions, or substitutions) required to change one word into another.
+ * The matrix is provided by the caller, so the loops over the partitions do not allocate.
  *
- * @param str1 The first input string.
- * @param str2 The second input string.
- * 
- * @return     The Levenshtein distance between the two input strings.
- *             Returns -1 if memory allocation fails during distance matrix creation.
+ * @param str1     The first input string.
+ * @param len1     The length of the first string.
+ * @param str2     The second input string.
+ * @param len2     The length of the second string.
+ * @param distance The distance matrix, of (len1 + 1) * (len2 + 1) elements.
+ *
+ * @return         The Levenshtein distance between the two input strings.
  */
-int levenshteinDistance(const char* str1, const char* str2) {
-    // Lengths of input strings plus one for the null terminator
-    int m = strlen(str1) + 1;
-    int n = strlen(str2) + 1;
-
-    // Allocate memory for the distance matrix
-    int* distance = (int*)malloc(m * n * sizeof(int));
-
-    // Check for memory allocation failure
-    if (distance == NULL) {
-        fprintf(stderr, "ERROR in memory allocation.\n");
-        return -1;
-    }
+int matrixLevenshteinDistance(const char* str1, int len1, const char* str2, int len2, int* distance) {
+    int m = len1 + 1;
+    int n = len2 + 1;
 
     // Populate the distance matrix using the Levenshtein distance algorithm
     for (int i = 0; i < m; ++i) {
@@ -73,11 +68,7 @@ int levenshteinDistance(const char* str1, const char* str2) {
         }
     }
 
-    // Store the result and free the allocated memory
-    int result = distance[m * n - 1];
-    free(distance);
-
-    return result;
+    return distance[m * n - 1];
 }
 
 /**
@@ -189,6 +180,132 @@ char* partitioning(const char* str, int id, int n_id) {
     return local_str;
 }
 
+/**
+ * @brief Copies a partition of a string into an arena, as partitioning() does.
+ *
+ * @param arena     The arena of the unit of work.
+ * @param str       The entire string to be partitioned.
+ * @param len       The length of the entire string.
+ * @param id        The index of the partition.
+ * @param n_id      The total number of partitions.
+ * @param local_len Output parameter: the length of the partition.
+ *
+ * @return          The partitioned substring, allocated in the arena (NULL if it is full).
+ */
+char* arenaPartitioning(Arena* arena, const char* str, int len, int id, int n_id, int* local_len) {
+    // Calculate the lengths and starting points of local sections of work
+    int remaining = len % n_id;
+    int local_start = id * (len / n_id) + fmin(id, remaining);
+    *local_len = len / n_id + ((id < remaining) ? 1 : 0);
+
+    // Copy the partitioned substring into the arena
+    char* local_str = (char*)arenaAlloc(arena, *local_len + 1);
+    if (local_str != NULL) {
+        memcpy(local_str, str + local_start, *local_len);
+        local_str[*local_len] = '\0';
+    }
+
+    return local_str;
+}
+
+/**
+ * @brief Calculates the Edit Distance of all the partitions of two strings, one after the other.
+ *
+ * The arena is sized up front for the largest partition (the two substrings and the distance
+ * matrix) and reset after each partition, so the loop does not allocate.
+ *
+ * @param str1   The first string.
+ * @param str2   The second string.
+ * @param n_id   The number of partitions.
+ *
+ * @return       The sum of the distances of the partitions, -1 if the arena cannot be mapped.
+ */
+int arenaPartitionsDistance(const char* str1, const char* str2, int n_id) {
+    int len1 = strlen(str1);
+    int len2 = strlen(str2);
+
+    // Size the arena from the largest partition
+    size_t max_len1 = len1 / n_id + 1;
+    size_t max_len2 = len2 / n_id + 1;
+    Arena arena;
+    if (arenaInit(&arena, arenaBytes(max_len1 + 1) + arenaBytes(max_len2 + 1) + arenaBytes((max_len1 + 1) * (max_len2 + 1) * sizeof(int))) != 0)
+        return -1;
+
+    int ED = 0;
+    for (int i = 0; i < n_id; i++) {
+        int local_len1, local_len2;
+        char* local_str1 = arenaPartitioning(&arena, str1, len1, i, n_id, &local_len1);
+        char* local_str2 = arenaPartitioning(&arena, str2, len2, i, n_id, &local_len2);
+        int* distance = (int*)arenaAlloc(&arena, (size_t)(local_len1 + 1) * (local_len2 + 1) * sizeof(int));
+
+        ED += matrixLevenshteinDistance(local_str1, local_len1, local_str2, local_len2, distance);
+
+        // The memory of the partition is reused by the next one
+        arenaReset(&arena);
+    }
+
+    arenaFree(&arena);
+
+    return ED;
+}
+
+/**
+ * @brief Calculates the Edit Distance of all the partitions of two strings with the batch kernel.
+ *
+ * This simulates the threads of the GPU kernel on the vector units of the CPU: the partitions
+ * are small and have the same length (+1), so BATCH_LANES of them are computed together, one
+ * for each lane. The partitions are not copied, the batch kernel reads them from the strings.
+ *
+ * @param str1   The first string.
+ * @param str2   The second string.
+ * @param n_id   The number of partitions.
+ *
+ * @return       The sum of the distances of the partitions, -1 on failure.
+ */
+int batchPartitionsDistance(const char* str1, const char* str2, int n_id) {
+    int len1 = strlen(str1);
+    int len2 = strlen(str2);
+
+    // Start and length of each partition, as partitioning() computes them
+    const char** local_str1 = (const char**)malloc(n_id * sizeof(const char*));
+    const char** local_str2 = (const char**)malloc(n_id * sizeof(const char*));
+    int* local_len = (int*)malloc(4 * (size_t)n_id * sizeof(int));
+    if (local_str1 == NULL || local_str2 == NULL || local_len == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(local_str1);
+        free(local_str2);
+        free(local_len);
+        return -1;
+    }
+    int* local_len1 = local_len;
+    int* local_len2 = local_len + n_id;
+    int* results = local_len + 2 * n_id;
+    for (int i = 0; i < n_id; i++) {
+        local_str1[i] = str1 + i * (len1 / n_id) + (int)fmin(i, len1 % n_id);
+        local_len1[i] = len1 / n_id + ((i < len1 % n_id) ? 1 : 0);
+        local_str2[i] = str2 + i * (len2 / n_id) + (int)fmin(i, len2 % n_id);
+        local_len2[i] = len2 / n_id + ((i < len2 % n_id) ? 1 : 0);
+    }
+
+    // Size the arena from the largest partition
+    Arena arena;
+    int ED = -1;
+    if (arenaInit(&arena, batchArenaBytes(len1 / n_id + 1, len2 / n_id + 1)) == 0) {
+        if (batchLevenshtein(&arena, local_str1, local_len1, local_str2, local_len2, n_id, results) == 0) {
+            ED = 0;
+            for (int i = 0; i < n_id; i++)
+                ED += results[i];
+        }
+        arenaFree(&arena);
+    }
+
+    free(local_str1);
+    free(local_str2);
+    free(local_len);
+
+    return ED;
+}
+
 /**
  * @brief Calculates the duration between two time points and converts it to seconds.
  *
@@ -222,7 +339,7 @@ double getTotalTime(struct timeval start, struct timeval stop) {
  * @param argc Number of command line arguments.
  * @param argv Array of command line argument strings.
  *
- * @return Returns 0 on successful execution, 1 on incorrect number of arguments.
+ * @return Returns 0 on successful execution, 1 on incorrect number of arguments or memory allocation failure.
  */
 int main(int argc, char* argv[]) {
     // Check if the correct number of command line arguments is provided
@@ -275,26 +392,20 @@ int main(int argc, char* argv[]) {
     gettimeofday(&edit_distance_start, NULL);
 
     // Partition strings and calculate Edit Distance for the host
-    for (int i = 0; i < omp_threads; i++) {
-        char* thread_str1 = partitioning(host_str1, i, omp_threads);
-        char* thread_str2 = partitioning(host_str2, i, omp_threads);
-
-        ED += levenshteinDistance(thread_str1, thread_str2);
-
-        free(thread_str1);
-        free(thread_str2);
+    int host_distance = arenaPartitionsDistance(host_str1, host_str2, omp_threads);
+    if (host_distance < 0) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
     }
+    ED += host_distance;
 
-    // Partition strings and calculate Edit Distance for the gpu
-    for (int i = 0; i < cuda_threads; i++) {
-        char* gpu_thread_str1 = partitioning(gpu_str1, i, cuda_threads);
-        char* gpu_thread_str2 = partitioning(gpu_str2, i, cuda_threads);
-
-        ED += levenshteinDistance(gpu_thread_str1, gpu_thread_str2);
-
-        free(gpu_thread_str1);
-        free(gpu_thread_str2);
+    // Partition strings and calculate Edit Distance for the gpu, a batch of partitions at a time
+    int gpu_distance = batchPartitionsDistance(gpu_str1, gpu_str2, cuda_threads);
+    if (gpu_distance < 0) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
     }
+    ED += gpu_distance;
 
     // Record the stop time of the Edit Distance calculation
     gettimeofday(&edit_distance_stop, NULL);
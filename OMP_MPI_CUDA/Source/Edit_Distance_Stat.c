@@ -0,0 +1,216 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "Progress.h"
+//Folder of the shared-memory segments
+#define SHM_FOLDER "/dev/shm"
+//Maximum number of runs followed at the same time
+#define MAX_RUNS 256
+
+/**
+ * @brief The last sample of a followed run, for its current throughput.
+ */
+typedef struct {
+    int pid;             /**< Process id of the run. */
+    long long cells;     /**< Cells at the last sample. */
+    double time;         /**< Time of the last sample. */
+} RunSample;
+
+/**
+ * @brief Returns the current time in seconds since the epoch.
+ */
+double currentTime(void) {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1e6;
+}
+
+/**
+ * @brief Prints the progress of a run from its segment.
+ *
+ * @param header  The mapped segment.
+ * @param samples The last samples of the runs, updated with this one.
+ * @param n_runs  The number of samples (updated if the run is new).
+ *
+ * @return        1 if the run is still running, 0 if it is finished or its process is dead.
+ */
+int printRun(const ProgressHeader* header, RunSample* samples, int* n_runs) {
+    const ProgressCounters* counters = (const ProgressCounters*)(header + 1);
+    double now = currentTime();
+
+    // Sum the counters of the threads
+    long long cells = 0, units = 0;
+    for (int t = 0; t < header->n_threads; t++) {
+        cells += atomic_load_explicit(&counters[t].cells, memory_order_relaxed);
+        units += atomic_load_explicit(&counters[t].units, memory_order_relaxed);
+    }
+
+    // Throughput since the last sample and since the start
+    RunSample* sample = NULL;
+    for (int r = 0; r < *n_runs; r++)
+        if (samples[r].pid == header->pid)
+            sample = &samples[r];
+    double elapsed = now - header->start_time;
+    double average = (elapsed > 0) ? cells / elapsed : 0.0;
+    double current = average;
+    if (sample != NULL && now > sample->time)
+        current = (cells - sample->cells) / (now - sample->time);
+    if (sample == NULL && *n_runs < MAX_RUNS)
+        sample = &samples[(*n_runs)++];
+    if (sample != NULL) {
+        sample->pid = header->pid;
+        sample->cells = cells;
+        sample->time = now;
+    }
+
+    // Remaining time at the average throughput
+    int finished = atomic_load(&header->finished);
+    int dead = !finished && kill(header->pid, 0) != 0 && errno == ESRCH;
+    const char* state = finished ? "finished" : (dead ? "dead" : "running");
+    double done = (header->total_cells > 0) ? 100.0 * cells / header->total_cells : 0.0;
+    double eta = (average > 0 && header->total_cells > cells) ? (header->total_cells - cells) / average : 0.0;
+
+    printf("pid %d rank %d (%s): %.1f%% of %lld cells, %lld units, GCUPS %.3f (average %.3f), elapsed %.1fs, ETA %.1fs\n",
+           header->pid, header->rank, state, done, header->total_cells, units, current / 1e9, average / 1e9, elapsed, eta);
+
+    // Share of the cells of each thread
+    for (int t = 0; t < header->n_threads; t++) {
+        long long thread_cells = atomic_load_explicit(&counters[t].cells, memory_order_relaxed);
+        printf("    thread %d: %lld cells (%.1f%%), %lld units\n", t, thread_cells,
+               (cells > 0) ? 100.0 * thread_cells / cells : 0.0, atomic_load_explicit(&counters[t].units, memory_order_relaxed));
+    }
+
+    return !finished && !dead;
+}
+
+/**
+ * @brief Prints the progress of all the runs with a segment (or only the one of the given process).
+ *
+ * The segments left by dead processes are printed, but they are not counted.
+ *
+ * @param pid     The process id to show, 0 for all.
+ * @param samples The last samples of the runs.
+ * @param n_runs  The number of samples.
+ *
+ * @return        The number of runs in progress, -1 if the segments cannot be listed.
+ */
+int printRuns(int pid, RunSample* samples, int* n_runs) {
+    DIR* folder = opendir(SHM_FOLDER);
+    if (folder == NULL) {
+        perror("ERROR during the folder opening.");
+        fprintf(stderr, "Folder %s can not be opened.\n", SHM_FOLDER);
+        return -1;
+    }
+
+    int found = 0;
+    struct dirent* entry;
+    while ((entry = readdir(folder)) != NULL) {
+        if (strncmp(entry->d_name, PROGRESS_PREFIX, strlen(PROGRESS_PREFIX)) != 0)
+            continue;
+        if (pid != 0 && atoi(entry->d_name + strlen(PROGRESS_PREFIX)) != pid)
+            continue;
+
+        // Map the segment, read-only
+        char name[300];
+        snprintf(name, sizeof(name), "/%s", entry->d_name);
+        int fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0)
+            continue;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(ProgressHeader)) {
+            close(fd);
+            continue;
+        }
+        void* segment = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (segment == MAP_FAILED)
+            continue;
+
+        // Skip the segments not yet filled
+        const ProgressHeader* header = (const ProgressHeader*)segment;
+        if (header->magic == PROGRESS_MAGIC && sizeof(ProgressHeader) + header->n_threads * sizeof(ProgressCounters) <= (size_t)info.st_size) {
+            found += printRun(header, samples, n_runs);
+        }
+        munmap(segment, info.st_size);
+    }
+    closedir(folder);
+
+    return found;
+}
+
+/**
+ * @brief Main function of the progress monitor (edstat).
+ *
+ * This program maps the progress segments of the running Edit Distance processes and prints,
+ * every interval, the cells computed by each process and each of its threads, the current and
+ * average throughput in GCUPS (billions of cell updates per second) and the estimated time to
+ * the end. It stops when the runs are over.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 if there are no runs in progress.
+ */
+int main(int argc, char* argv[]) {
+    if (argc > 3) {
+        fprintf(stderr, "Usage: %s [interval_s] [pid]\n", argv[0]);
+        return 1;
+    }
+
+    double interval = (argc >= 2) ? atof(argv[1]) : 1.0;
+    int pid = (argc >= 3) ? atoi(argv[2]) : 0;
+    RunSample samples[MAX_RUNS];
+    int n_runs = 0;
+
+    // Print the runs until they are all over
+    for (int round = 0;; round++) {
+        if (round > 0)
+            printf("\n");
+        int found = printRuns(pid, samples, &n_runs);
+        if (found < 0)
+            return 1;
+        if (found == 0) {
+            if (round == 0) {
+                printf("No runs in progress.\n");
+                return 1;
+            }
+            printf("All the runs are over.\n");
+            return 0;
+        }
+        fflush(stdout);
+        usleep((useconds_t)(interval * 1e6));
+    }
+}
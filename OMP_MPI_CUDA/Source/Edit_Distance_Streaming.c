@@ -0,0 +1,377 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <aio.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+//Constant for the time conversion
+#define SEC_CONV 1000000
+//Constant for the memory budget conversion (megabytes to bytes)
+#define MB_CONV (1024LL * 1024LL)
+//Smallest chunk size that is still worth an asynchronous read
+#define MIN_CHUNK_SIZE 4096
+
+/**
+ * @brief State of the double-buffered asynchronous reader of the row-string.
+ *
+ * Two buffers of chunk_size bytes are used in turn: while the DP consumes one of them,
+ * the next chunk of the file is read into the other one with aio_read().
+ */
+typedef struct {
+    int fd;                 /**< Descriptor of the streamed file. */
+    off_t file_size;        /**< Size of the streamed file in bytes. */
+    off_t next_offset;      /**< Offset of the next chunk to request. */
+    size_t chunk_size;      /**< Size of each buffer in bytes. */
+    char* buffers[2];       /**< The two chunk buffers. */
+    struct aiocb request;   /**< Control block of the outstanding read. */
+    int pending;            /**< 1 if a read has been submitted and not yet collected. */
+} ChunkReader;
+
+/**
+ * @brief Loads a whole file in memory, keeping track of its length explicitly.
+ *
+ * The content is not NUL-terminated on purpose: the length is returned through the
+ * length parameter, so files with embedded NUL bytes are handled correctly.
+ *
+ * @param path   Path of the file to load.
+ * @param length Output parameter that receives the number of bytes read.
+ *
+ * @return       A dynamically allocated buffer with the file content. It is the responsibility
+ *               of the caller to free the allocated memory using free().
+ *               Returns NULL if the file cannot be read or memory allocation fails.
+ */
+char* loadReference(const char* path, long long* length) {
+    FILE* fp = fopen(path, "rb");
+
+    // Check if the file can be opened
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", path);
+        return NULL;
+    }
+
+    // Get the size of the file
+    struct stat info;
+    if (fstat(fileno(fp), &info) != 0) {
+        perror("ERROR during the file stat.");
+        fclose(fp);
+        return NULL;
+    }
+    *length = (long long)info.st_size;
+
+    // Allocate memory for the content (at least one byte, to allow empty files)
+    char* content = (char*)malloc((*length > 0 ? *length : 1) * sizeof(char));
+
+    // Check for memory allocation failure
+    if (content == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        fclose(fp);
+        return NULL;
+    }
+
+    // Read the whole file
+    if ((long long)fread(content, sizeof(char), *length, fp) != *length) {
+        fprintf(stderr, "ERROR while reading %s.\n", path);
+        free(content);
+        fclose(fp);
+        return NULL;
+    }
+
+    fclose(fp);
+
+    return content;
+}
+
+/**
+ * @brief Submits the asynchronous read of the next chunk of the file into the given buffer.
+ *
+ * If the whole file has already been requested nothing is submitted and the reader
+ * is left without pending reads.
+ *
+ * @param reader The chunk reader.
+ * @param slot   The index (0 or 1) of the buffer that will receive the chunk.
+ */
+void submitChunk(ChunkReader* reader, int slot) {
+    // Nothing left to read
+    if (reader->next_offset >= reader->file_size) {
+        reader->pending = 0;
+        return;
+    }
+
+    // Clamp the last chunk to the end of the file
+    size_t bytes = reader->chunk_size;
+    if ((off_t)bytes > reader->file_size - reader->next_offset)
+        bytes = (size_t)(reader->file_size - reader->next_offset);
+
+    // Fill the control block and start the read
+    memset(&reader->request, 0, sizeof(struct aiocb));
+    reader->request.aio_fildes = reader->fd;
+    reader->request.aio_buf = reader->buffers[slot];
+    reader->request.aio_nbytes = bytes;
+    reader->request.aio_offset = reader->next_offset;
+
+    if (aio_read(&reader->request) != 0) {
+        perror("ERROR during the asynchronous read.");
+        exit(EXIT_FAILURE);
+    }
+
+    reader->next_offset += bytes;
+    reader->pending = 1;
+}
+
+/**
+ * @brief Waits for the outstanding read of the reader and returns the number of bytes in the chunk.
+ *
+ * A short asynchronous read is completed with synchronous pread() calls, so the returned
+ * chunk always contains every byte that was requested.
+ *
+ * @param reader The chunk reader.
+ *
+ * @return       The number of bytes available in the buffer of the completed read.
+ */
+size_t waitChunk(ChunkReader* reader) {
+    const struct aiocb* list[1] = { &reader->request };
+
+    // Wait for the completion of the request
+    while (aio_error(&reader->request) == EINPROGRESS)
+        aio_suspend(list, 1, NULL);
+
+    if (aio_error(&reader->request) != 0) {
+        errno = aio_error(&reader->request);
+        perror("ERROR during the asynchronous read.");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t requested = reader->request.aio_nbytes;
+    size_t done = (size_t)aio_return(&reader->request);
+    char* buffer = (char*)reader->request.aio_buf;
+
+    // Complete a short read synchronously
+    while (done < requested) {
+        ssize_t bytes = pread(reader->fd, buffer + done, requested - done, reader->request.aio_offset + done);
+        if (bytes <= 0) {
+            perror("ERROR during the chunk read.");
+            exit(EXIT_FAILURE);
+        }
+        done += (size_t)bytes;
+    }
+
+    reader->pending = 0;
+
+    return done;
+}
+
+/**
+ * @brief Advances the single resident DP row over a chunk of the row-string.
+ *
+ * The row holds the distances between the prefix of the row-string read so far and
+ * every prefix of the reference (the column-string). Each character of the chunk
+ * produces the next row of the Levenshtein matrix in place.
+ *
+ * @param row        The DP row, of length ref_len + 1.
+ * @param ref        The reference string.
+ * @param ref_len    The length of the reference string.
+ * @param chunk      The chunk of the row-string.
+ * @param chunk_len  The number of characters in the chunk.
+ * @param row_index  In/out index of the last row computed (number of characters consumed).
+ */
+void advanceRow(long long* row, const char* ref, long long ref_len, const char* chunk, size_t chunk_len, long long* row_index) {
+    long long i = *row_index;
+
+    for (size_t k = 0; k < chunk_len; ++k) {
+        char c = chunk[k];
+        long long diagonal = row[0];
+        row[0] = ++i;
+
+        for (long long j = 1; j <= ref_len; ++j) {
+            long long above = row[j];
+            if (c == ref[j - 1]) {
+                row[j] = diagonal;
+            } else {
+                long long best = above < row[j - 1] ? above : row[j - 1];
+                row[j] = 1 + (best < diagonal ? best : diagonal);
+            }
+            diagonal = above;
+        }
+    }
+
+    *row_index = i;
+}
+
+/**
+ * @brief Calculates the duration between two time points and converts it to seconds.
+ *
+ * This function takes two `struct timeval` time points, calculates the duration between them,
+ * and converts the result to seconds for easier interpretation. It uses a conversion factor
+ * `SEC_CONV` to handle the microsecond part of the time.
+ *
+ * @param start The starting time point.
+ * @param stop  The ending time point.
+ *
+ * @return      The duration between the two time points in seconds.
+ */
+double getTotalTime(struct timeval start, struct timeval stop) {
+    unsigned long long start_time, stop_time;
+
+    // Convert timeval to microseconds
+    start_time = (unsigned long long)start.tv_sec * SEC_CONV + start.tv_usec;
+    stop_time = (unsigned long long)stop.tv_sec * SEC_CONV + stop.tv_usec;
+
+    // Calculate the duration in microseconds and convert it to seconds
+    return (double)(stop_time - start_time) / (double)SEC_CONV;
+}
+
+/**
+ * @brief Main function for the out-of-core streaming Edit Distance calculation program.
+ *
+ * This program keeps the reference (column-string) and one DP row resident, and streams the
+ * text (row-string) from disk in fixed-size chunks with double-buffered asynchronous reads.
+ * The chunk size is derived from the memory budget given on the command line, so the total
+ * memory used is bounded regardless of the size of the text. The exact distance and the
+ * timing information are printed on the standard output.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    // Check if the correct number of command line arguments is provided
+    if (argc != 4) {
+        fprintf(stderr, "Usage: %s <text_file> <reference_file> <memory_budget_MB>\n", argv[0]);
+        return 1;
+    }
+
+    // Parse command line arguments
+    char* text_path = argv[1];
+    char* reference_path = argv[2];
+    long long budget = atoll(argv[3]) * MB_CONV;
+
+    // Variables for timing
+    struct timeval execution_start, execution_stop;
+
+    // Record the start time of the entire program
+    gettimeofday(&execution_start, NULL);
+
+    // Load the reference, that stays resident for the whole run
+    long long ref_len;
+    char* reference = loadReference(reference_path, &ref_len);
+    if (reference == NULL)
+        return 1;
+
+    // Check that the budget leaves room for the two chunk buffers
+    long long resident = ref_len + (ref_len + 1) * (long long)sizeof(long long);
+    if (budget < resident + 2 * MIN_CHUNK_SIZE) {
+        fprintf(stderr, "ERROR: a budget of at least %lld MB is needed for a reference of %lld bytes.\n",
+                (resident + 2 * MIN_CHUNK_SIZE) / MB_CONV + 1, ref_len);
+        free(reference);
+        return 1;
+    }
+
+    // Open the streamed text
+    ChunkReader reader;
+    reader.fd = open(text_path, O_RDONLY);
+    if (reader.fd < 0) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", text_path);
+        free(reference);
+        return 1;
+    }
+
+    // Get the size of the text
+    struct stat info;
+    if (fstat(reader.fd, &info) != 0) {
+        perror("ERROR during the file stat.");
+        close(reader.fd);
+        free(reference);
+        return 1;
+    }
+    reader.file_size = info.st_size;
+    reader.next_offset = 0;
+    reader.pending = 0;
+
+    // Split the remaining budget between the two buffers (no need to exceed the file size)
+    reader.chunk_size = (size_t)((budget - resident) / 2);
+    if ((off_t)reader.chunk_size > reader.file_size)
+        reader.chunk_size = reader.file_size > 0 ? (size_t)reader.file_size : 1;
+
+    reader.buffers[0] = (char*)malloc(reader.chunk_size * sizeof(char));
+    reader.buffers[1] = (char*)malloc(reader.chunk_size * sizeof(char));
+
+    // Allocate and initialize the DP row (distances from the empty prefix of the text)
+    long long* row = (long long*)malloc((ref_len + 1) * sizeof(long long));
+
+    // Check for memory allocation failure
+    if (reader.buffers[0] == NULL || reader.buffers[1] == NULL || row == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        close(reader.fd);
+        free(reader.buffers[0]);
+        free(reader.buffers[1]);
+        free(row);
+        free(reference);
+        return 1;
+    }
+
+    for (long long j = 0; j <= ref_len; ++j)
+        row[j] = j;
+
+    // Stream the text: read the next chunk while the current one is consumed
+    long long row_index = 0;
+    int slot = 0;
+    submitChunk(&reader, slot);
+
+    while (reader.pending) {
+        size_t chunk_len = waitChunk(&reader);
+
+        submitChunk(&reader, 1 - slot);
+
+        advanceRow(row, reference, ref_len, reader.buffers[slot], chunk_len, &row_index);
+
+        slot = 1 - slot;
+    }
+
+    long long distance = row[ref_len];
+
+    // Record the stop time of the entire program
+    gettimeofday(&execution_stop, NULL);
+
+    // Print the result and the timing information
+    printf("Streaming;%lld;%lld;%zu;%lld;%06f\n", row_index, ref_len, reader.chunk_size, distance,
+           getTotalTime(execution_start, execution_stop));
+
+    // Free allocated memory and close the text
+    close(reader.fd);
+    free(reader.buffers[0]);
+    free(reader.buffers[1]);
+    free(row);
+    free(reference);
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "Top_K_Search.h"
+#include "Text_Lines.h"
+
+/**
+ * @brief Main function for the top-k nearest string search program.
+ *
+ * This program loads a corpus (one string per line) and prints the k strings closest to
+ * the query, followed by the number of candidates rejected by each filter and the search time.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    // Check if the correct number of command line arguments is provided
+    if (argc != 5) {
+        fprintf(stderr, "Usage: %s <corpus_file> <query> <k> <n_threads>\n", argv[0]);
+        return 1;
+    }
+
+    // Parse command line arguments
+    char* corpus_path = argv[1];
+    char* query = argv[2];
+    int k = atoi(argv[3]);
+    int n_threads = atoi(argv[4]);
+
+    // Set the number of OpenMP threads
+    omp_set_num_threads(n_threads);
+
+    // Load the corpus
+    int n_strings;
+    char** corpus = loadLines(corpus_path, &n_strings);
+    if (corpus == NULL)
+        return 1;
+
+    SearchMatch* matches = (SearchMatch*)malloc((k > 0 ? k : 1) * sizeof(SearchMatch));
+    SearchStatistics stats;
+
+    // Search the corpus
+    double search_start = omp_get_wtime();
+    int found = topKSearch(query, corpus, n_strings, k, matches, &stats);
+    double search_time = omp_get_wtime() - search_start;
+
+    if (found < 0) {
+        fprintf(stderr, "ERROR during the search.\n");
+        return 1;
+    }
+
+    // Print the matches and the statistics of the filters
+    for (int i = 0; i < found; i++)
+        printf("%d;%d;%s\n", matches[i].index, matches[i].distance, corpus[matches[i].index]);
+    printf("Candidates;%d;Length_pruned;%lld;Qgram_pruned;%lld;Band_pruned;%lld;Accepted;%lld;Time;%06f\n",
+           n_strings, stats.length_pruned, stats.qgram_pruned, stats.band_pruned, stats.accepted, search_time);
+
+    // Free allocated memory
+    freeLines(corpus, n_strings);
+    free(matches);
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "Qgram_Sketch.h"
+#include "Edit_Distance_Kernels.h"
+#include "Text_Lines.h"
+
+/**
+ * @brief A string of the corpus within the maximum distance of a query.
+ */
+typedef struct {
+    int index;        /**< Index of the string in the corpus. */
+    int distance;     /**< Edit distance from the query. */
+    double estimate;  /**< Distance estimated from the sketches. */
+} TriageMatch;
+
+/**
+ * @brief The matches of a query.
+ */
+typedef struct {
+    TriageMatch* matches;
+    int n_matches;
+    int capacity;
+} QueryMatches;
+
+/**
+ * @brief Appends a match to the matches of a query.
+ */
+static void addMatch(QueryMatches* query, int index, int distance, double estimate) {
+    if (query->n_matches == query->capacity) {
+        query->capacity = (query->capacity > 0) ? 2 * query->capacity : 16;
+        query->matches = (TriageMatch*)realloc(query->matches, query->capacity * sizeof(TriageMatch));
+        if (query->matches == NULL) {
+            fprintf(stderr, "ERROR in memory allocation.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    query->matches[query->n_matches].index = index;
+    query->matches[query->n_matches].distance = distance;
+    query->matches[query->n_matches].estimate = estimate;
+    query->n_matches++;
+}
+
+/**
+ * @brief Main function for the sketch-based triage of the pairs of two sets of strings.
+ *
+ * This program loads a corpus and a set of queries (one string per line) and finds, for each
+ * query, the strings of the corpus within the maximum edit distance. The q-gram MinHash sketches
+ * of all the strings are computed first, in parallel; then every pair is estimated from its
+ * sketches, and only the pairs whose lower bound of the distance (with the confidence of
+ * SKETCH_Z) is within the maximum distance are verified with the exact bounded kernel. The
+ * queries are processed in parallel by the OpenMP threads. The matches are printed in order of
+ * query and corpus index ("query;index;distance;estimate"), and the last line contains the
+ * number of pairs discarded by the length difference and by the sketches, of the verified and
+ * matching pairs and the time. With "check" the discarded pairs are verified too, and the last
+ * line also counts the matches that the sketches discarded (a measure of the confidence).
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    // Check if the correct number of command line arguments is provided
+    if (argc != 5 && argc != 6) {
+        fprintf(stderr, "Usage: %s <corpus_file> <queries_file> <max_distance> <n_threads> [check]\n", argv[0]);
+        return 1;
+    }
+
+    // Parse command line arguments
+    char* corpus_path = argv[1];
+    char* queries_path = argv[2];
+    int max_distance = atoi(argv[3]);
+    int n_threads = atoi(argv[4]);
+    int check = (argc == 6 && strcmp(argv[5], "check") == 0);
+
+    // Set the number of OpenMP threads
+    omp_set_num_threads(n_threads);
+
+    // Load the corpus and the queries
+    int n_strings, n_queries;
+    char** corpus = loadLines(corpus_path, &n_strings);
+    if (corpus == NULL)
+        return 1;
+    char** queries = loadLines(queries_path, &n_queries);
+    if (queries == NULL)
+        return 1;
+
+    double execution_start = omp_get_wtime();
+
+    // Sketch all the strings, stored contiguously
+    SketchSet corpus_sketches, query_sketches;
+    if (buildSketches(corpus, n_strings, &corpus_sketches) != 0 || buildSketches(queries, n_queries, &query_sketches) != 0)
+        return 1;
+
+    double sketch_time = omp_get_wtime() - execution_start;
+
+    QueryMatches* results = (QueryMatches*)calloc(n_queries + 1, sizeof(QueryMatches));
+    if (results == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+
+    long long length_pruned = 0, sketch_pruned = 0, verified = 0, matched = 0, missed = 0;
+    int failed = 0;
+
+    #pragma omp parallel for schedule(dynamic) reduction(+:length_pruned, sketch_pruned, verified, matched, missed)
+    for (int q = 0; q < n_queries; q++) {
+        int query_len = query_sketches.lengths[q];
+        for (int s = 0; s < n_strings; s++) {
+            int len = corpus_sketches.lengths[s];
+
+            // The length difference is a lower bound of the distance
+            if (abs(len - query_len) > max_distance) {
+                length_pruned++;
+                continue;
+            }
+
+            // Discard the pairs whose lower bound from the sketches is above the maximum distance
+            SketchEstimate estimate;
+            sketchEstimate(&query_sketches, q, &corpus_sketches, s, &estimate);
+            int pruned = (estimate.distance_low > max_distance);
+            if (pruned && !check) {
+                sketch_pruned++;
+                continue;
+            }
+
+            // Verify the pair with the exact kernel
+            int distance = boundedLevenshtein(queries[q], query_len, corpus[s], len, max_distance);
+            if (distance < 0) {
+                #pragma omp atomic write
+                failed = 1;
+                continue;
+            }
+            if (pruned) {
+                sketch_pruned++;
+                if (distance <= max_distance)
+                    missed++;
+                continue;
+            }
+            verified++;
+            if (distance <= max_distance) {
+                matched++;
+                addMatch(&results[q], s, distance, estimate.distance);
+            }
+        }
+    }
+
+    double execution_time = omp_get_wtime() - execution_start;
+
+    if (failed) {
+        fprintf(stderr, "ERROR during the verification.\n");
+        return 1;
+    }
+
+    // Print the matches of each query and the statistics of the filters
+    for (int q = 0; q < n_queries; q++)
+        for (int m = 0; m < results[q].n_matches; m++)
+            printf("%d;%d;%d;%.1f\n", q, results[q].matches[m].index, results[q].matches[m].distance, results[q].matches[m].estimate);
+    printf("Pairs;%lld;Length_pruned;%lld;Sketch_pruned;%lld;Verified;%lld;Matched;%lld;", (long long)n_queries * n_strings,
+           length_pruned, sketch_pruned, verified, matched);
+    if (check)
+        printf("Missed;%lld;", missed);
+    printf("Sketch_time;%06f;Time;%06f\n", sketch_time, execution_time);
+
+    // Free allocated memory
+    for (int q = 0; q < n_queries; q++)
+        free(results[q].matches);
+    free(results);
+    freeSketches(&corpus_sketches);
+    freeSketches(&query_sketches);
+    freeLines(corpus, n_strings);
+    freeLines(queries, n_queries);
+
+    return 0;
+}
@@ -0,0 +1,290 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "Edit_Distance_Tuning.h"
+#include "Four_Russians.h"
+#include "Diagonal_Transition.h"
+#include "Progress.h"
+//Directory of the configurations of the hosts
+#define TUNING_DIRECTORY "Tuning"
+//Maximum length of the strings with 16 bit cells
+#define MAX_CELL16_LENGTH 65534
+
+/**
+ * @brief Defines a Levenshtein kernel computed in column strips, for one type of DP cells.
+ *
+ * @param NAME Name of the generated function.
+ * @param CELL Type of the DP cells.
+ */
+#define DEFINE_TILED_KERNEL(NAME, CELL)                                                                 \
+int NAME(const char* str1, int len1, const char* str2, int len2, int tile) {                            \
+    if (tile < 1)                                                                                       \
+        tile = 1;                                                                                       \
+                                                                                                        \
+    /* Allocate the boundary column and the row of a strip */                                           \
+    CELL* column = (CELL*)malloc((len1 + 1) * sizeof(CELL));                                            \
+    CELL* row = (CELL*)malloc((tile + 1) * sizeof(CELL));                                               \
+    if (column == NULL || row == NULL) {                                                                \
+        fprintf(stderr, "ERROR in memory allocation.\n");                                               \
+        free(column);                                                                                   \
+        free(row);                                                                                      \
+        return -1;                                                                                      \
+    }                                                                                                   \
+                                                                                                        \
+    /* First column: deletions only */                                                                  \
+    for (int i = 0; i <= len1; ++i)                                                                     \
+        column[i] = (CELL)i;                                                                            \
+                                                                                                        \
+    for (int start = 0; start < len2; start += tile) {                                                  \
+        int width = (len2 - start < tile) ? len2 - start : tile;                                        \
+        const char* strip = str2 + start - 1;                                                           \
+                                                                                                        \
+        /* First row of the strip: insertions only */                                                   \
+        for (int k = 1; k <= width; ++k)                                                                \
+            row[k] = (CELL)(start + k);                                                                 \
+        CELL diagonal = column[0];                                                                      \
+        column[0] = (CELL)(start + width);                                                              \
+                                                                                                        \
+        for (int i = 1; i <= len1; ++i) {                                                               \
+            char a = str1[i - 1];                                                                       \
+            CELL first = column[i];                                                                     \
+            CELL left = first;                                                                          \
+            CELL corner = diagonal;                                                                     \
+                                                                                                        \
+            /* Cells of the row inside the strip */                                                     \
+            for (int k = 1; k <= width; ++k) {                                                          \
+                CELL up = row[k];                                                                       \
+                CELL value = corner + (a != strip[k]);                                                  \
+                if (up + 1 < value)                                                                     \
+                    value = up + 1;                                                                     \
+                if (left + 1 < value)                                                                   \
+                    value = left + 1;                                                                   \
+                corner = up;                                                                            \
+                row[k] = value;                                                                         \
+                left = value;                                                                           \
+            }                                                                                           \
+                                                                                                        \
+            /* Pass the last column of the strip to the next one */                                     \
+            diagonal = first;                                                                           \
+            column[i] = left;                                                                           \
+        }                                                                                               \
+        progressAdd((long long)len1 * width, 0);                                                        \
+    }                                                                                                   \
+                                                                                                        \
+    /* Store the result and free the allocated memory */                                                \
+    int result = column[len1];                                                                          \
+    free(column);                                                                                       \
+    free(row);                                                                                          \
+                                                                                                        \
+    return result;                                                                                      \
+}
+
+// One instantiation per cell width
+DEFINE_TILED_KERNEL(tiledLevenshtein16, uint16_t)
+DEFINE_TILED_KERNEL(tiledLevenshtein32, int32_t)
+
+/**
+ * @brief Writes the default path of the configuration of this host, "Tuning/<hostname>.csv".
+ *
+ * @param path The buffer to fill.
+ * @param size The size of the buffer.
+ */
+void tuningConfigPath(char* path, size_t size) {
+    char host[256];
+
+    if (gethostname(host, sizeof(host)) != 0)
+        strcpy(host, "localhost");
+    host[sizeof(host) - 1] = '\0';
+
+    snprintf(path, size, "%s/%s.csv", TUNING_DIRECTORY, host);
+}
+
+/**
+ * @brief Loads a configuration written by saveTuningConfig().
+ *
+ * @param path   Path of the configuration file.
+ * @param config The configuration to fill (empty if the file does not exist).
+ *
+ * @return       0 on success, -1 if the file cannot be opened.
+ */
+int loadTuningConfig(const char* path, TuningConfig* config) {
+    config->n_entries = 0;
+    config->entries = NULL;
+
+    // A missing configuration leaves it empty, the caller decides whether to use the defaults
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL)
+        return -1;
+
+    int capacity = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        TuningEntry entry;
+        char backend[32];
+
+        // Skip the header and the malformed lines
+        if (sscanf(line, "%d;%31[^;];%d;%d;%d;%d;%lf", &entry.n_characters, backend, &entry.tile,
+                   &entry.cell_width, &entry.omp_threads, &entry.mpi_process, &entry.time) != 7)
+            continue;
+        if (strcmp(backend, "tiled") == 0)
+            entry.backend = BACKEND_TILED;
+        else if (strcmp(backend, "russians") == 0)
+            entry.backend = BACKEND_RUSSIANS;
+        else if (strcmp(backend, "diagonal") == 0)
+            entry.backend = BACKEND_DIAGONAL;
+        else
+            entry.backend = BACKEND_MATRIX;
+
+        if (config->n_entries == capacity) {
+            capacity = (capacity == 0) ? 8 : 2 * capacity;
+            TuningEntry* entries = (TuningEntry*)realloc(config->entries, capacity * sizeof(TuningEntry));
+            if (entries == NULL) {
+                fprintf(stderr, "ERROR in memory allocation.\n");
+                break;
+            }
+            config->entries = entries;
+        }
+        config->entries[config->n_entries++] = entry;
+    }
+
+    fclose(fp);
+
+    return 0;
+}
+
+/**
+ * @brief Name of a backend in the configuration files.
+ *
+ * @param backend The backend.
+ *
+ * @return        "matrix", "tiled", "russians" or "diagonal".
+ */
+const char* tuningBackendName(int backend) {
+    if (backend == BACKEND_TILED)
+        return "tiled";
+    if (backend == BACKEND_RUSSIANS)
+        return "russians";
+    if (backend == BACKEND_DIAGONAL)
+        return "diagonal";
+    return "matrix";
+}
+
+/**
+ * @brief Writes a configuration as a CSV file, one entry per line.
+ *
+ * @param path   Path of the configuration file.
+ * @param config The configuration to write.
+ *
+ * @return       0 on success, -1 if the file cannot be opened.
+ */
+int saveTuningConfig(const char* path, const TuningConfig* config) {
+    FILE* fp = fopen(path, "w");
+
+    // Check if the file can be opened
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", path);
+        return -1;
+    }
+
+    fprintf(fp, "n_characters;backend;tile;cell_width;omp_threads;mpi_process;time\n");
+    for (int e = 0; e < config->n_entries; e++) {
+        const TuningEntry* entry = &config->entries[e];
+        fprintf(fp, "%d;%s;%d;%d;%d;%d;%06f\n", entry->n_characters,
+                tuningBackendName(entry->backend), entry->tile,
+                entry->cell_width, entry->omp_threads, entry->mpi_process, entry->time);
+    }
+
+    fclose(fp);
+
+    return 0;
+}
+
+/**
+ * @brief Releases the entries of a configuration.
+ */
+void freeTuningConfig(TuningConfig* config) {
+    free(config->entries);
+    config->entries = NULL;
+    config->n_entries = 0;
+}
+
+/**
+ * @brief Finds the entry tuned for the input size closest to the given one.
+ *
+ * @param config       The configuration.
+ * @param n_characters The input size.
+ *
+ * @return             The entry, NULL if the configuration is empty.
+ */
+const TuningEntry* findTuningEntry(const TuningConfig* config, int n_characters) {
+    const TuningEntry* best = NULL;
+    double best_ratio = 0;
+
+    // Sizes are compared by ratio, since the cost grows with their square
+    for (int e = 0; e < config->n_entries; e++) {
+        double ratio = (double)config->entries[e].n_characters / (n_characters > 0 ? n_characters : 1);
+        if (ratio < 1)
+            ratio = 1 / ratio;
+        if (best == NULL || ratio < best_ratio) {
+            best = &config->entries[e];
+            best_ratio = ratio;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Levenshtein distance with the backend of the entry.
+ *
+ * The Four-Russians backend uses the lookup table, the diagonal backend the diagonal-transition
+ * waves (with the bit-parallel fallback); the tiled backend uses the cell width of the entry, but the 16 bit cells are only used when both lengths fit them, otherwise 32 bit cells are used.
+ *
+ * @param str1  The first input string.
+ * @param str2  The second input string.
+ * @param entry The tuned configuration.
+ *
+ * @return      The Levenshtein distance, -1 if memory allocation fails.
+ */
+int tunedLevenshtein(const char* str1, const char* str2, const TuningEntry* entry) {
+    int len1 = strlen(str1);
+    int len2 = strlen(str2);
+
+    if (entry->backend == BACKEND_RUSSIANS)
+        return fourRussiansLevenshtein(str1, len1, str2, len2);
+    if (entry->backend == BACKEND_DIAGONAL)
+        return similarLevenshtein(str1, len1, str2, len2);
+
+    if (entry->cell_width == 16 && len1 <= MAX_CELL16_LENGTH && len2 <= MAX_CELL16_LENGTH)
+        return tiledLevenshtein16(str1, len1, str2, len2, entry->tile);
+
+    return tiledLevenshtein32(str1, len1, str2, len2, entry->tile);
+}
@@ -0,0 +1,146 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef EDIT_DISTANCE_TUNING_H
+#define EDIT_DISTANCE_TUNING_H
+
+#include <stddef.h>
+
+//Kernel backends of the partitions
+#define BACKEND_MATRIX 0
+#define BACKEND_TILED 1
+#define BACKEND_RUSSIANS 2
+#define BACKEND_DIAGONAL 3
+
+/**
+ * @brief The best configuration found by the autotuner for one input size.
+ */
+typedef struct {
+    int n_characters;  /**< Input size of the trials. */
+    int backend;       /**< BACKEND_MATRIX (whole DP matrix), BACKEND_TILED (column strips), BACKEND_RUSSIANS (lookup table) or BACKEND_DIAGONAL (diagonal transition). */
+    int tile;          /**< Width of the column strips of the tiled backend. */
+    int cell_width;    /**< Bits of the DP cells of the tiled backend (16 or 32). */
+    int omp_threads;   /**< Number of OpenMP threads. */
+    int mpi_process;   /**< Number of MPI processes on the node. */
+    double time;       /**< Best time of the trials, in seconds. */
+} TuningEntry;
+
+/**
+ * @brief The configuration of a host, one entry per tuned input size.
+ */
+typedef struct {
+    int n_entries;         /**< Number of entries. */
+    TuningEntry* entries;  /**< The entries, in the order of the file. */
+} TuningConfig;
+
+/**
+ * @brief Writes the default path of the configuration of this host, "Tuning/<hostname>.csv".
+ *
+ * @param path The buffer to fill.
+ * @param size The size of the buffer.
+ */
+void tuningConfigPath(char* path, size_t size);
+
+/**
+ * @brief Loads a configuration written by saveTuningConfig().
+ *
+ * @param path   Path of the configuration file.
+ * @param config The configuration to fill (empty if the file does not exist).
+ *
+ * @return       0 on success, -1 if the file cannot be opened.
+ */
+int loadTuningConfig(const char* path, TuningConfig* config);
+
+/**
+ * @brief Name of a backend in the configuration files.
+ *
+ * @param backend The backend.
+ *
+ * @return        "matrix", "tiled", "russians" or "diagonal".
+ */
+const char* tuningBackendName(int backend);
+
+/**
+ * @brief Writes a configuration as a CSV file, one entry per line.
+ *
+ * @param path   Path of the configuration file.
+ * @param config The configuration to write.
+ *
+ * @return       0 on success, -1 if the file cannot be opened.
+ */
+int saveTuningConfig(const char* path, const TuningConfig* config);
+
+/**
+ * @brief Releases the entries of a configuration.
+ */
+void freeTuningConfig(TuningConfig* config);
+
+/**
+ * @brief Finds the entry tuned for the input size closest to the given one.
+ *
+ * @param config       The configuration.
+ * @param n_characters The input size.
+ *
+ * @return             The entry, NULL if the configuration is empty.
+ */
+const TuningEntry* findTuningEntry(const TuningConfig* config, int n_characters);
+
+/**
+ * @brief Levenshtein distance computed in column strips, with 16 bit cells.
+ *
+ * The DP is computed one strip of tile columns at a time: the row of the strip stays in the
+ * L1 cache, and the last column of each strip is passed to the next one, so only
+ * len1 + tile + 2 cells are kept in memory. Both lengths must be less than 65535.
+ *
+ * @param str1 The first input string.
+ * @param len1 The length of the first string.
+ * @param str2 The second input string.
+ * @param len2 The length of the second string.
+ * @param tile The width of the strips.
+ *
+ * @return     The Levenshtein distance, -1 if memory allocation fails.
+ */
+int tiledLevenshtein16(const char* str1, int len1, const char* str2, int len2, int tile);
+
+/**
+ * @brief Levenshtein distance computed in column strips, with 32 bit cells.
+ */
+int tiledLevenshtein32(const char* str1, int len1, const char* str2, int len2, int tile);
+
+/**
+ * @brief Levenshtein distance with the backend of the entry.
+ *
+ * The Four-Russians backend uses the lookup table, the diagonal backend the diagonal-transition
+ * waves (with the bit-parallel fallback); the tiled backend uses the cell width of the entry, but the 16 bit cells are only used when both lengths fit them, otherwise 32 bit cells are used.
+ *
+ * @param str1  The first input string.
+ * @param str2  The second input string.
+ * @param entry The tuned configuration.
+ *
+ * @return      The Levenshtein distance, -1 if memory allocation fails.
+ */
+int tunedLevenshtein(const char* str1, const char* str2, const TuningEntry* entry);
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "Random_String_Generator.h"
+#include "Edit_Distance_Kernels.h"
+#include "Four_Russians.h"
+#include "Pattern_Search.h"
+#include "Diagonal_Transition.h"
+#include "Anchor_Partitioning.h"
+//Constant for the time conversion
+#define SEC_CONV 1000000
+
+/**
+ * @brief Calculates the duration between two time points and converts it to seconds.
+ *
+ * This function takes two `struct timeval` time points, calculates the duration between them,
+ * and converts the result to seconds for easier interpretation. It uses a conversion factor
+ * `SEC_CONV` to handle the microsecond part of the time.
+ *
+ * @param start The starting time point.
+ * @param stop  The ending time point.
+ *
+ * @return      The duration between the two time points in seconds.
+ */
+double getTotalTime(struct timeval start, struct timeval stop) {
+    unsigned long long start_time, stop_time;
+
+    // Convert timeval to microseconds
+    start_time = (unsigned long long)start.tv_sec * SEC_CONV + start.tv_usec;
+    stop_time = (unsigned long long)stop.tv_sec * SEC_CONV + stop.tv_usec;
+
+    // Calculate the duration in microseconds and convert it to seconds
+    return (double)(stop_time - start_time) / (double)SEC_CONV;
+}
+
+/**
+ * @brief Levenshtein distance with the Four-Russians lookup table, with the signature of the kernels.
+ *
+ * @param str1  The first input string.
+ * @param len1  The length of the first string.
+ * @param str2  The second input string.
+ * @param len2  The length of the second string.
+ * @param costs Not used: unit costs.
+ *
+ * @return      The Levenshtein distance, -1 if memory allocation fails.
+ */
+int fourRussiansKernel(const char* str1, int len1, const char* str2, int len2, const EditCosts* costs) {
+    (void)costs;
+    return fourRussiansLevenshtein(str1, len1, str2, len2);
+}
+
+/**
+ * @brief Levenshtein distance with the bit-parallel kernel (the first string is the pattern),
+ * with the signature of the kernels.
+ *
+ * @param str1  The first input string.
+ * @param len1  The length of the first string.
+ * @param str2  The second input string.
+ * @param len2  The length of the second string.
+ * @param costs Not used: unit costs.
+ *
+ * @return      The Levenshtein distance, -1 if memory allocation fails.
+ */
+int bitParallelKernel(const char* str1, int len1, const char* str2, int len2, const EditCosts* costs) {
+    (void)costs;
+    if (len1 == 0)
+        return len2;
+
+    PatternMask mask;
+    if (compilePattern(str1, len1, &mask) != 0)
+        return -1;
+    int distance = levenshteinBitParallel(&mask, str2, len2);
+    freePattern(&mask);
+
+    return distance;
+}
+
+/**
+ * @brief Levenshtein distance with the diagonal-transition waves (and the bit-parallel fallback),
+ * with the signature of the kernels.
+ *
+ * @param str1  The first input string.
+ * @param len1  The length of the first string.
+ * @param str2  The second input string.
+ * @param len2  The length of the second string.
+ * @param costs Not used: unit costs.
+ *
+ * @return      The Levenshtein distance, -1 if memory allocation fails.
+ */
+int diagonalKernel(const char* str1, int len1, const char* str2, int len2, const EditCosts* costs) {
+    (void)costs;
+    return similarLevenshtein(str1, len1, str2, len2);
+}
+
+/**
+ * @brief Main function for the Edit Distance variants program.
+ *
+ * This program generates random strings and calculates their distance with the kernel
+ * specialised for the requested cost model: "levenshtein" and "damerau" use unit costs,
+ * "weighted" and "weighted_damerau" use the costs loaded from the given cost file.
+ * "four_russians", "bit_parallel" and "diagonal" compute the unit cost Levenshtein distance with
+ * the lookup table, the bit-parallel kernel and the diagonal-transition waves, to compare them
+ * with "levenshtein". With n_edits the second string is a copy of the first one with n_edits
+ * random edits (seed2 is the seed of the edits), for the near-duplicate inputs.
+ * With n_partitions the distance is approximated as in the OMP+MPI modality, by the sum of the
+ * distances of the partitions, cut at the same offsets ("equal") or at the shared unique k-mers
+ * of Anchor_Partitioning ("anchor"), to measure the error of the two partitionings.
+ * The distance and the time of the kernel are printed on the standard output (with the
+ * partitions and the cuts placed on an anchor when the strings are partitioned).
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    // Check if the correct number of command line arguments is provided
+    if (argc < 5 || argc > 9) {
+        fprintf(stderr, "Usage: %s <n_characters> <seed1> <seed2> <levenshtein|damerau|weighted|weighted_damerau|four_russians|bit_parallel|diagonal> [cost_file|-] [n_edits|-] [n_partitions] [equal|anchor]\n", argv[0]);
+        return 1;
+    }
+
+    // Parse command line arguments
+    int n_characters = atoi(argv[1]);
+    int seed1 = atoi(argv[2]);
+    int seed2 = atoi(argv[3]);
+    char* model = argv[4];
+    int n_edits = (argc >= 7 && strcmp(argv[6], "-") != 0) ? atoi(argv[6]) : -1;
+    int n_partitions = (argc >= 8) ? atoi(argv[7]) : 1;
+    int anchor = (argc == 9 && strcmp(argv[8], "anchor") == 0);
+    if (n_partitions < 1)
+        n_partitions = 1;
+
+    // Load the cost model (unit costs if no file is given)
+    EditCosts* costs = (EditCosts*)malloc(sizeof(EditCosts));
+    if (costs == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+    if (argc >= 6 && strcmp(argv[5], "-") != 0) {
+        if (loadEditCosts(argv[5], costs) != 0) {
+            free(costs);
+            return 1;
+        }
+    } else {
+        initUnitCosts(costs);
+    }
+
+    // Select the kernel specialised for the cost model
+    int (*kernel)(const char*, int, const char*, int, const EditCosts*);
+    if (strcmp(model, "levenshtein") == 0) {
+        kernel = levenshteinUnitCost;
+    } else if (strcmp(model, "damerau") == 0) {
+        kernel = damerauUnitCost;
+    } else if (strcmp(model, "weighted") == 0) {
+        kernel = levenshteinWeighted;
+    } else if (strcmp(model, "weighted_damerau") == 0) {
+        kernel = damerauWeighted;
+    } else if (strcmp(model, "four_russians") == 0) {
+        kernel = fourRussiansKernel;
+        fourRussiansInit();
+    } else if (strcmp(model, "bit_parallel") == 0) {
+        kernel = bitParallelKernel;
+    } else if (strcmp(model, "diagonal") == 0) {
+        kernel = diagonalKernel;
+    } else {
+        fprintf(stderr, "Unknown cost model %s.\n", model);
+        free(costs);
+        return 1;
+    }
+
+    // Generate random strings, or a string and a near-duplicate of it
+    char* X = generateRandomString(n_characters, seed1);
+    char* Y;
+    int y_characters = n_characters;
+    if (n_edits >= 0)
+        Y = mutateString(X, n_characters, n_edits, seed2, &y_characters);
+    else
+        Y = generateRandomString(n_characters, seed2);
+
+    int* cuts1 = (int*)malloc((n_partitions + 1) * sizeof(int));
+    int* cuts2 = (int*)malloc((n_partitions + 1) * sizeof(int));
+    if (cuts1 == NULL || cuts2 == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+
+    // Calculate the distance (the sum of the distances of the partitions)
+    struct timeval edit_distance_start, edit_distance_stop;
+    gettimeofday(&edit_distance_start, NULL);
+    int anchored = 0;
+    if (anchor) {
+        anchored = anchorCuts(X, n_characters, Y, y_characters, n_partitions, cuts1, cuts2);
+    } else {
+        for (int p = 0; p <= n_partitions; p++) {
+            cuts1[p] = p * (n_characters / n_partitions) + ((p < n_characters % n_partitions) ? p : n_characters % n_partitions);
+            cuts2[p] = p * (y_characters / n_partitions) + ((p < y_characters % n_partitions) ? p : y_characters % n_partitions);
+        }
+    }
+    int distance = 0;
+    for (int p = 0; p < n_partitions; p++)
+        distance += kernel(X + cuts1[p], cuts1[p + 1] - cuts1[p], Y + cuts2[p], cuts2[p + 1] - cuts2[p], costs);
+    gettimeofday(&edit_distance_stop, NULL);
+
+    // Print the result and the time of the kernel
+    if (argc >= 8)
+        printf("%s;%d;%d;%06f;%d;%s;%d\n", model, n_characters, distance, getTotalTime(edit_distance_start, edit_distance_stop),
+               n_partitions, anchor ? "anchor" : "equal", anchored);
+    else
+        printf("%s;%d;%d;%06f\n", model, n_characters, distance, getTotalTime(edit_distance_start, edit_distance_stop));
+
+    // Free allocated memory
+    free(X);
+    free(Y);
+    free(costs);
+    free(cuts1);
+    free(cuts2);
+
+    return 0;
+}
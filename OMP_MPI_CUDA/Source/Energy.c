@@ -0,0 +1,197 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <time.h>
+#include "Energy.h"
+#include "Memory_Accounting.h"
+//Prefix of the RAPL domains in the powercap interface
+#define RAPL_PREFIX "intel-rapl:"
+
+/**
+ * @brief A RAPL domain.
+ */
+typedef struct {
+    char path[300];                /**< Path of the energy_uj file. */
+    int type;                      /**< ENERGY_PACKAGE or ENERGY_DRAM. */
+    unsigned long long max_range;  /**< Value where the counter wraps, in microjoules. */
+    unsigned long long start;      /**< Value at the start of the phase, in microjoules. */
+} EnergyDomain;
+
+static EnergyDomain domains[MAX_ENERGY_DOMAINS];
+static int n_domains = 0;
+static struct timespec phase_start;
+
+/**
+ * @brief Reads an unsigned number from a sysfs file.
+ *
+ * @param path  The path of the file.
+ * @param value Output parameter: the number.
+ *
+ * @return      0 on success, -1 if the file cannot be read.
+ */
+static int readCounter(const char* path, unsigned long long* value) {
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL)
+        return -1;
+    int read = fscanf(fp, "%llu", value);
+    fclose(fp);
+
+    return (read == 1) ? 0 : -1;
+}
+
+/**
+ * @brief Finds the readable RAPL domains of the node.
+ *
+ * @return The domains found, ENERGY_PACKAGE and/or ENERGY_DRAM, 0 if there are none.
+ */
+int energyInit(void) {
+    n_domains = 0;
+    DIR* dir = opendir(POWERCAP_PATH);
+    if (dir == NULL)
+        return 0;
+
+    int found = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL && n_domains < MAX_ENERGY_DOMAINS) {
+        if (strncmp(entry->d_name, RAPL_PREFIX, strlen(RAPL_PREFIX)) != 0)
+            continue;
+
+        // Only the packages and the DRAM (core, uncore and psys overlap with them)
+        char path[300], name[64] = "";
+        snprintf(path, sizeof(path), "%s/%s/name", POWERCAP_PATH, entry->d_name);
+        FILE* fp = fopen(path, "r");
+        if (fp == NULL)
+            continue;
+        int read = fscanf(fp, "%63s", name);
+        fclose(fp);
+        if (read != 1)
+            continue;
+        EnergyDomain* domain = &domains[n_domains];
+        if (strncmp(name, "package", 7) == 0)
+            domain->type = ENERGY_PACKAGE;
+        else if (strcmp(name, "dram") == 0)
+            domain->type = ENERGY_DRAM;
+        else
+            continue;
+
+        // Skip the counters that cannot be read (often only root can)
+        snprintf(path, sizeof(path), "%s/%s/max_energy_range_uj", POWERCAP_PATH, entry->d_name);
+        snprintf(domain->path, sizeof(domain->path), "%s/%s/energy_uj", POWERCAP_PATH, entry->d_name);
+        if (readCounter(path, &domain->max_range) != 0 || readCounter(domain->path, &domain->start) != 0)
+            continue;
+
+        found |= domain->type;
+        n_domains++;
+    }
+    closedir(dir);
+
+    return found;
+}
+
+/**
+ * @brief Starts a phase: reads the counters of the domains and the clock.
+ */
+void energyPhaseStart(void) {
+    for (int d = 0; d < n_domains; d++)
+        readCounter(domains[d].path, &domains[d].start);
+    clock_gettime(CLOCK_MONOTONIC, &phase_start);
+}
+
+/**
+ * @brief Stops a phase and computes the energy used since its start.
+ *
+ * @param phase The energy to fill.
+ */
+void energyPhaseStop(EnergyPhase* phase) {
+    struct timespec stop_time;
+    clock_gettime(CLOCK_MONOTONIC, &stop_time);
+    phase->seconds = (stop_time.tv_sec - phase_start.tv_sec) + (stop_time.tv_nsec - phase_start.tv_nsec) / 1e9;
+    phase->package = -1;
+    phase->dram = -1;
+
+    for (int d = 0; d < n_domains; d++) {
+        unsigned long long stop;
+        if (readCounter(domains[d].path, &stop) != 0)
+            continue;
+
+        // The counter wraps at max_range
+        unsigned long long used = (stop >= domains[d].start) ? stop - domains[d].start : stop + domains[d].max_range - domains[d].start;
+        double* joules = (domains[d].type == ENERGY_PACKAGE) ? &phase->package : &phase->dram;
+        if (*joules < 0)
+            *joules = 0;
+        *joules += used / 1e6;
+    }
+}
+
+/**
+ * @brief Prints a number of joules, or an empty column if it is missing.
+ */
+static void printJoules(FILE* fp, double joules) {
+    if (joules >= 0)
+        fprintf(fp, "%06f;", joules);
+    else
+        fprintf(fp, ";");
+}
+
+/**
+ * @brief Prints the energy columns of a line of the Informations files.
+ *
+ * The columns are the package joules and the DRAM joules of the phases (generation,
+ * partitioning, kernel), the average watts over the three phases (their joules over their
+ * seconds, so the time outside them does not lower the power) and the DP cells per joule of the
+ * kernel; the columns that cannot be computed are left empty. The line is ended.
+ *
+ * @param fp     The file.
+ * @param phases Energy used by the phases.
+ * @param cells  DP cells computed by the kernel.
+ */
+void printEnergyToCSV(FILE* fp, const EnergyPhase* phases, double cells) {
+    double total = 0, seconds = 0, kernel = -1;
+    for (int p = 0; p < N_PHASES; p++)
+        printJoules(fp, phases[p].package);
+    for (int p = 0; p < N_PHASES; p++)
+        printJoules(fp, phases[p].dram);
+
+    // Watts and cells per joule of the packages, with the DRAM if it is read
+    if (phases[PHASE_KERNEL].package >= 0) {
+        for (int p = 0; p < N_PHASES; p++) {
+            total += phases[p].package + ((phases[p].dram > 0) ? phases[p].dram : 0);
+            seconds += phases[p].seconds;
+        }
+        kernel = phases[PHASE_KERNEL].package + ((phases[PHASE_KERNEL].dram > 0) ? phases[PHASE_KERNEL].dram : 0);
+    }
+    if (kernel >= 0 && seconds > 0)
+        fprintf(fp, "%06f;", total / seconds);
+    else
+        fprintf(fp, ";");
+    if (kernel > 0)
+        fprintf(fp, "%06f;\n", cells / kernel);
+    else
+        fprintf(fp, ";\n");
+}
@@ -0,0 +1,94 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <stdio.h>
+
+//Root of the powercap interface of the RAPL counters
+#ifndef POWERCAP_PATH
+#define POWERCAP_PATH "/sys/class/powercap"
+#endif
+//Largest number of RAPL domains read
+#define MAX_ENERGY_DOMAINS 32
+//Domains of the energy readings
+#define ENERGY_PACKAGE 1
+#define ENERGY_DRAM 2
+//Columns of the energy in the Informations files: package and DRAM joules of 3 phases, watts, cells per joule
+#define ENERGY_FIELDS 8
+
+/*
+ * The energy is read from the RAPL counters of the Linux powercap interface
+ * (/sys/class/powercap/intel-rapl:*, also used for AMD processors): the "package-N" domains
+ * and their "dram" subdomains. The counters belong to the whole node, so with several
+ * processes on a node only one of them must read them. The counters are often readable only
+ * by root: the domains that cannot be read are skipped, and without any the energy is
+ * reported as missing.
+ */
+
+/**
+ * @brief Energy used by a phase of the program.
+ */
+typedef struct {
+    double package;  /**< Joules of the packages, -1 if they cannot be read. */
+    double dram;     /**< Joules of the DRAM, -1 if it cannot be read. */
+    double seconds;  /**< Duration of the phase. */
+} EnergyPhase;
+
+/**
+ * @brief Finds the readable RAPL domains of the node.
+ *
+ * @return The domains found, ENERGY_PACKAGE and/or ENERGY_DRAM, 0 if there are none.
+ */
+int energyInit(void);
+
+/**
+ * @brief Starts a phase: reads the counters of the domains and the clock.
+ */
+void energyPhaseStart(void);
+
+/**
+ * @brief Stops a phase and computes the energy used since its start.
+ *
+ * @param phase The energy to fill.
+ */
+void energyPhaseStop(EnergyPhase* phase);
+
+/**
+ * @brief Prints the energy columns of a line of the Informations files.
+ *
+ * The columns are the package joules and the DRAM joules of the phases (generation,
+ * partitioning, kernel), the average watts over the three phases (their joules over their
+ * seconds, so the time outside them does not lower the power) and the DP cells per joule of the
+ * kernel; the columns that cannot be computed are left empty. The line is ended.
+ *
+ * @param fp     The file.
+ * @param phases Energy used by the phases.
+ * @param cells  DP cells computed by the kernel.
+ */
+void printEnergyToCSV(FILE* fp, const EnergyPhase* phases, double cells);
+
+#endif
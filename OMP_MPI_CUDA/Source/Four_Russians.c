@@ -0,0 +1,218 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "Four_Russians.h"
+#include "Progress.h"
+//Index of the boundary vector with all the differences equal to +1 (first row and first column)
+#define ALL_INSERTIONS (RUSSIANS_VECTORS - 1)
+
+// The table: bottom vector in the low byte, right vector in the high byte
+static uint16_t russians_table[RUSSIANS_MASKS * RUSSIANS_VECTORS * RUSSIANS_VECTORS];
+static pthread_once_t russians_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Computes every entry of the lookup table with the cell by cell DP of the block.
+ */
+static void buildTable(void) {
+    int D[RUSSIANS_BLOCK + 1][RUSSIANS_BLOCK + 1];
+
+    for (int mask = 0; mask < RUSSIANS_MASKS; mask++) {
+        for (int top = 0; top < RUSSIANS_VECTORS; top++) {
+            for (int left = 0; left < RUSSIANS_VECTORS; left++) {
+                // Boundary of the block, relative to its top left corner (digit k is difference k + 1)
+                D[0][0] = 0;
+                for (int k = 0, t = top, l = left; k < RUSSIANS_BLOCK; k++, t /= 3, l /= 3) {
+                    D[0][k + 1] = D[0][k] + t % 3 - 1;
+                    D[k + 1][0] = D[k][0] + l % 3 - 1;
+                }
+
+                // Cells of the block: bit i * RUSSIANS_BLOCK + j of the mask is set if they match
+                for (int i = 1; i <= RUSSIANS_BLOCK; i++) {
+                    for (int j = 1; j <= RUSSIANS_BLOCK; j++) {
+                        int match = (mask >> ((i - 1) * RUSSIANS_BLOCK + j - 1)) & 1;
+                        int best = D[i - 1][j - 1] + !match;
+                        if (D[i - 1][j] + 1 < best)
+                            best = D[i - 1][j] + 1;
+                        if (D[i][j - 1] + 1 < best)
+                            best = D[i][j - 1] + 1;
+                        D[i][j] = best;
+                    }
+                }
+
+                // Encode the differences of the bottom row and of the right column
+                int bottom = 0;
+                int right = 0;
+                for (int k = RUSSIANS_BLOCK - 1; k >= 0; k--) {
+                    bottom = bottom * 3 + D[RUSSIANS_BLOCK][k + 1] - D[RUSSIANS_BLOCK][k] + 1;
+                    right = right * 3 + D[k + 1][RUSSIANS_BLOCK] - D[k][RUSSIANS_BLOCK] + 1;
+                }
+                russians_table[(mask * RUSSIANS_VECTORS + top) * RUSSIANS_VECTORS + left] = (uint16_t)(bottom | (right << 8));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Builds the lookup table, once for the process (later calls return immediately).
+ *
+ * fourRussiansLevenshtein() calls it on its first use; calling it at startup keeps the
+ * construction out of the timed kernels.
+ */
+void fourRussiansInit(void) {
+    pthread_once(&russians_once, buildTable);
+}
+
+/**
+ * @brief Levenshtein distance computed with the Four-Russians lookup table.
+ *
+ * The blocks cover the first (len1 / RUSSIANS_BLOCK) * RUSSIANS_BLOCK rows and the first
+ * (len2 / RUSSIANS_BLOCK) * RUSSIANS_BLOCK columns; the last rows and columns are computed cell
+ * by cell from the boundaries of the blocks.
+ *
+ * @param str1 The first input string.
+ * @param len1 The length of the first string.
+ * @param str2 The second input string.
+ * @param len2 The length of the second string.
+ *
+ * @return     The Levenshtein distance, -1 if memory allocation fails.
+ */
+int fourRussiansLevenshtein(const char* str1, int len1, const char* str2, int len2) {
+    fourRussiansInit();
+
+    int block_rows = len1 / RUSSIANS_BLOCK;
+    int block_cols = len2 / RUSSIANS_BLOCK;
+    int rows = block_rows * RUSSIANS_BLOCK;
+    int cols = block_cols * RUSSIANS_BLOCK;
+
+    // Remap the characters of the second string to dense codes (0 is for the characters it lacks)
+    int code[256] = {0};
+    int n_codes = 1;
+    for (int j = 0; j < len2; j++) {
+        if (code[(unsigned char)str2[j]] == 0)
+            code[(unsigned char)str2[j]] = n_codes++;
+    }
+
+    // Allocate the masks, the boundaries of the blocks and a row of the DP
+    uint8_t* peq = (uint8_t*)calloc((size_t)n_codes * (block_cols + 1), sizeof(uint8_t));
+    uint8_t* top = (uint8_t*)malloc((block_cols + 1) * sizeof(uint8_t));
+    uint8_t* right = (uint8_t*)malloc((block_rows + 1) * sizeof(uint8_t));
+    int* column = (int*)malloc((rows + 1) * sizeof(int));
+    int* row = (int*)malloc((len2 + 1) * sizeof(int));
+    if (peq == NULL || top == NULL || right == NULL || column == NULL || row == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(peq);
+        free(top);
+        free(right);
+        free(column);
+        free(row);
+        return -1;
+    }
+
+    // Match masks: bit k of peq[c][b] is set if the character k of the block column b has code c
+    for (int j = 0; j < cols; j++)
+        peq[code[(unsigned char)str2[j]] * (block_cols + 1) + j / RUSSIANS_BLOCK] |= 1 << (j % RUSSIANS_BLOCK);
+
+    // Blocks, one row of blocks at a time: the first row and the first column are insertions
+    for (int b = 0; b < block_cols; b++)
+        top[b] = ALL_INSERTIONS;
+    for (int a = 0; a < block_rows; a++) {
+        const uint8_t* p0 = peq + code[(unsigned char)str1[a * RUSSIANS_BLOCK]] * (block_cols + 1);
+        const uint8_t* p1 = peq + code[(unsigned char)str1[a * RUSSIANS_BLOCK + 1]] * (block_cols + 1);
+        const uint8_t* p2 = peq + code[(unsigned char)str1[a * RUSSIANS_BLOCK + 2]] * (block_cols + 1);
+        int left = ALL_INSERTIONS;
+        for (int b = 0; b < block_cols; b++) {
+            int mask = p0[b] | (p1[b] << RUSSIANS_BLOCK) | (p2[b] << (2 * RUSSIANS_BLOCK));
+            uint16_t out = russians_table[(mask * RUSSIANS_VECTORS + top[b]) * RUSSIANS_VECTORS + left];
+            top[b] = out & 0xFF;
+            left = out >> 8;
+        }
+        right[a] = left;
+        progressAdd((long long)RUSSIANS_BLOCK * cols, 0);
+    }
+
+    // Column "cols" of the DP, from the right vectors of the rows of blocks
+    column[0] = cols;
+    for (int a = 0; a < block_rows; a++) {
+        for (int k = 0, r = right[a]; k < RUSSIANS_BLOCK; k++, r /= 3)
+            column[a * RUSSIANS_BLOCK + k + 1] = column[a * RUSSIANS_BLOCK + k] + r % 3 - 1;
+    }
+
+    // Columns on the right of the blocks, cell by cell down to row "rows"
+    for (int j = cols; j <= len2; j++)
+        row[j] = j;
+    for (int i = 1; i <= rows; i++) {
+        int diag = row[cols];
+        row[cols] = column[i];
+        for (int j = cols + 1; j <= len2; j++) {
+            int up = row[j];
+            int best = diag + (str1[i - 1] != str2[j - 1]);
+            if (up + 1 < best)
+                best = up + 1;
+            if (row[j - 1] + 1 < best)
+                best = row[j - 1] + 1;
+            row[j] = best;
+            diag = up;
+        }
+    }
+
+    // Row "rows" of the DP under the blocks, from their bottom vectors
+    row[0] = rows;
+    for (int b = 0; b < block_cols; b++) {
+        for (int k = 0, t = top[b]; k < RUSSIANS_BLOCK; k++, t /= 3)
+            row[b * RUSSIANS_BLOCK + k + 1] = row[b * RUSSIANS_BLOCK + k] + t % 3 - 1;
+    }
+
+    // Rows under the blocks, cell by cell
+    for (int i = rows + 1; i <= len1; i++) {
+        int diag = row[0];
+        row[0] = i;
+        for (int j = 1; j <= len2; j++) {
+            int up = row[j];
+            int best = diag + (str1[i - 1] != str2[j - 1]);
+            if (up + 1 < best)
+                best = up + 1;
+            if (row[j - 1] + 1 < best)
+                best = row[j - 1] + 1;
+            row[j] = best;
+            diag = up;
+        }
+    }
+    progressAdd((long long)len1 * len2 - (long long)rows * cols, 0);
+
+    int distance = row[len2];
+
+    // Free allocated memory
+    free(peq);
+    free(top);
+    free(right);
+    free(column);
+    free(row);
+
+    return distance;
+}
@@ -0,0 +1,73 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef FOUR_RUSSIANS_H
+#define FOUR_RUSSIANS_H
+
+//Side of the blocks of the lookup table
+#define RUSSIANS_BLOCK 3
+//Boundary vectors of a block side: one difference (-1, 0 or 1) for each cell, 3^RUSSIANS_BLOCK
+#define RUSSIANS_VECTORS 27
+//Match masks of a block: one bit for each cell, 2^(RUSSIANS_BLOCK^2)
+#define RUSSIANS_MASKS 512
+
+/*
+ * Four-Russians kernel of the Levenshtein distance. The DP matrix is cut in blocks of
+ * RUSSIANS_BLOCK x RUSSIANS_BLOCK cells; with unit costs the differences between adjacent cells
+ * are -1, 0 or 1, so a block is fully described by the differences along its top row and its
+ * left column and by which characters of the block match. The bottom row and the right column
+ * of every possible block are precomputed once in a table of RUSSIANS_MASKS x RUSSIANS_VECTORS^2
+ * entries of 16 bits (729 kB), and each block of the matrix is a single lookup.
+ *
+ * The table is keyed by the match mask and not by the characters, so its size does not depend
+ * on the alphabet: the characters of the strings are remapped to dense codes, and each code
+ * keeps one mask of RUSSIANS_BLOCK bits for each block column of the second string.
+ */
+
+/**
+ * @brief Builds the lookup table, once for the process (later calls return immediately).
+ *
+ * fourRussiansLevenshtein() calls it on its first use; calling it at startup keeps the
+ * construction out of the timed kernels.
+ */
+void fourRussiansInit(void);
+
+/**
+ * @brief Levenshtein distance computed with the Four-Russians lookup table.
+ *
+ * The blocks cover the first (len1 / RUSSIANS_BLOCK) * RUSSIANS_BLOCK rows and the first
+ * (len2 / RUSSIANS_BLOCK) * RUSSIANS_BLOCK columns; the last rows and columns are computed cell
+ * by cell from the boundaries of the blocks.
+ *
+ * @param str1 The first input string.
+ * @param len1 The length of the first string.
+ * @param str2 The second input string.
+ * @param len2 The length of the second string.
+ *
+ * @return     The Levenshtein distance, -1 if memory allocation fails.
+ */
+int fourRussiansLevenshtein(const char* str1, int len1, const char* str2, int len2);
+
+#endif
@@ -0,0 +1,251 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "Name_Clusters.h"
+
+/**
+ * @brief The distinct names read from the input files, with their number of occurrences.
+ */
+typedef struct {
+    char** name;        /**< The distinct names. */
+    int* occurrences;   /**< Occurrences of each name. */
+    int* slot;          /**< Open addressing table of name ids + 1 (0 if the slot is empty). */
+    int capacity;       /**< Size of the table, a power of 2. */
+    int count;          /**< Number of distinct names. */
+    long long total;    /**< Number of names read. */
+} NameSet;
+
+/**
+ * @brief Hash of a NUL-terminated string (FNV-1a).
+ */
+static unsigned int hashName(const char* str) {
+    unsigned int hash = 2166136261u;
+    while (*str)
+        hash = (hash ^ (unsigned char)*str++) * 16777619u;
+    return hash;
+}
+
+/**
+ * @brief Adds an occurrence of a name to the set, growing the set when it is half full.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int addName(NameSet* set, const char* name) {
+    if (2 * (set->count + 1) > set->capacity) {
+        int capacity = set->capacity > 0 ? 2 * set->capacity : 1024;
+        int* slot = (int*)calloc(capacity, sizeof(int));
+        char** names = (char**)realloc(set->name, capacity * sizeof(char*));
+        int* occurrences = (int*)realloc(set->occurrences, capacity * sizeof(int));
+        if (slot == NULL || names == NULL || occurrences == NULL) {
+            fprintf(stderr, "ERROR in memory allocation.\n");
+            free(slot);
+            return -1;
+        }
+        set->name = names;
+        set->occurrences = occurrences;
+
+        // Reinsert the names in the larger table
+        for (int id = 0; id < set->count; id++) {
+            int s = hashName(set->name[id]) & (capacity - 1);
+            while (slot[s] != 0)
+                s = (s + 1) & (capacity - 1);
+            slot[s] = id + 1;
+        }
+        free(set->slot);
+        set->slot = slot;
+        set->capacity = capacity;
+    }
+
+    set->total++;
+    int s = hashName(name) & (set->capacity - 1);
+    while (set->slot[s] != 0) {
+        int id = set->slot[s] - 1;
+        if (strcmp(set->name[id], name) == 0) {
+            set->occurrences[id]++;
+            return 0;
+        }
+        s = (s + 1) & (set->capacity - 1);
+    }
+
+    set->name[set->count] = strdup(name);
+    set->occurrences[set->count] = 1;
+    set->slot[s] = ++set->count;
+    return 0;
+}
+
+/**
+ * @brief Reads the names of a file: one record per line, the name is the text before the first tab.
+ *
+ * This reads plain lists of names as well as the per-player outputs of the Hadoop jobs.
+ *
+ * @return 0 on success, -1 otherwise.
+ */
+static int readNames(const char* path, NameSet* set) {
+    FILE* fp = fopen(path, "r");
+
+    // Check if the file can be opened
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", path);
+        return -1;
+    }
+
+    char* line = NULL;
+    size_t size = 0;
+    int result = 0;
+    while (result == 0 && getline(&line, &size, fp) != -1) {
+        line[strcspn(line, "\t\r\n")] = '\0';
+        if (line[0] != '\0')
+            result = addName(set, line);
+    }
+    free(line);
+    fclose(fp);
+
+    return result;
+}
+
+/**
+ * @brief Main function for the fuzzy deduplication of names.
+ *
+ * This program reads the names of one or more files (joining them), groups the names within
+ * edit distance k of each other with clusterNames(), and writes one line per cluster with more
+ * than one name: the canonical name (the most frequent one, the first one read on ties), a tab,
+ * and the other names separated by semicolons. The last line printed contains the statistics.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    // Check if the correct number of command line arguments is provided
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <k> <n_threads> <output_file> <names_file> [names_file...]\n", argv[0]);
+        return 1;
+    }
+
+    // Parse command line arguments
+    int k = atoi(argv[1]);
+    int n_threads = atoi(argv[2]);
+    char* output_path = argv[3];
+
+    double start = omp_get_wtime();
+
+    // Read the distinct names of all the files
+    NameSet set;
+    memset(&set, 0, sizeof(set));
+    for (int f = 4; f < argc; f++)
+        if (readNames(argv[f], &set) != 0)
+            return 1;
+
+    double read_time = omp_get_wtime() - start;
+
+    // Group the names
+    int* cluster = (int*)malloc((set.count + 1) * sizeof(int));
+    if (cluster == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+    ClusterStatistics stats;
+    double cluster_start = omp_get_wtime();
+    int n_clusters = clusterNames(set.name, set.count, k, n_threads, cluster, &stats);
+    double cluster_time = omp_get_wtime() - cluster_start;
+    if (n_clusters < 0)
+        return 1;
+
+    // Canonical name of each cluster: the most frequent one
+    int* canonical = (int*)malloc((set.count + 1) * sizeof(int));
+    int* size = (int*)calloc(set.count + 1, sizeof(int));
+    if (canonical == NULL || size == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+    for (int i = 0; i < set.count; i++)
+        canonical[i] = i;
+    for (int i = 0; i < set.count; i++) {
+        int c = cluster[i];
+        size[c]++;
+        if (set.occurrences[i] > set.occurrences[canonical[c]])
+            canonical[c] = i;
+    }
+
+    // Write the clusters with more than one name
+    FILE* fp = fopen(output_path, "w");
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", output_path);
+        return 1;
+    }
+    int merged = 0;
+    int* next = (int*)malloc((set.count + 1) * sizeof(int));
+    int* head = (int*)malloc((set.count + 1) * sizeof(int));
+    if (next == NULL || head == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+    for (int i = 0; i < set.count; i++)
+        head[i] = -1;
+    for (int i = set.count - 1; i >= 0; i--) {
+        next[i] = head[cluster[i]];
+        head[cluster[i]] = i;
+    }
+    for (int c = 0; c < set.count; c++) {
+        if (cluster[c] != c || size[c] < 2)
+            continue;
+        merged++;
+        fprintf(fp, "%s\t", set.name[canonical[c]]);
+        int first = 1;
+        for (int i = head[c]; i >= 0; i = next[i]) {
+            if (i == canonical[c])
+                continue;
+            fprintf(fp, first ? "%s" : ";%s", set.name[i]);
+            first = 0;
+        }
+        fprintf(fp, "\n");
+    }
+    fclose(fp);
+
+    // Print the statistics
+    printf("Names;%lld;Distinct;%d;Clusters;%d;Merged;%d;Blocked;%lld;Verified;%lld;Matched;%lld;Read_time;%06f;Cluster_time;%06f\n",
+           set.total, set.count, n_clusters, merged, stats.blocked_pairs, stats.verified_pairs, stats.matched_pairs,
+           read_time, cluster_time);
+
+    // Free allocated memory
+    for (int i = 0; i < set.count; i++)
+        free(set.name[i]);
+    free(set.name);
+    free(set.occurrences);
+    free(set.slot);
+    free(cluster);
+    free(canonical);
+    free(size);
+    free(next);
+    free(head);
+
+    return 0;
+}
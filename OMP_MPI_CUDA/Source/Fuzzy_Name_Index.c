@@ -0,0 +1,522 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Edit_Distance_Kernels.h"
+#include "Top_K_Search.h"
+#include "Fuzzy_Name_Index.h"
+
+/**
+ * @brief Rounds a size up to a multiple of 8 bytes.
+ */
+static size_t align8(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+/**
+ * @brief Calculates the size of the blob of an index with the sizes written in the header.
+ */
+static size_t blobSize(const NameIndexHeader* header) {
+    size_t size = align8(sizeof(NameIndexHeader));
+    size += 2 * align8((header->n_names + 1) * sizeof(uint32_t));
+    size += 2 * align8(header->n_edges * sizeof(uint32_t));
+    size += align8((header->buckets + 1) * sizeof(uint32_t));
+    size += 2 * align8(header->n_postings * sizeof(uint32_t));
+    size += align8(header->pool_size);
+    return size;
+}
+
+/**
+ * @brief Sets the pointers of the index to the arrays of the blob, following the header.
+ */
+static void layoutIndex(NameIndex* index, void* blob, size_t size, int mapped) {
+    char* cursor = (char*)blob;
+    const NameIndexHeader* header = (const NameIndexHeader*)cursor;
+    cursor += align8(sizeof(NameIndexHeader));
+
+    index->header = header;
+    index->name_offset = (const uint32_t*)cursor;
+    cursor += align8((header->n_names + 1) * sizeof(uint32_t));
+    index->first_edge = (const uint32_t*)cursor;
+    cursor += align8((header->n_names + 1) * sizeof(uint32_t));
+    index->edge_child = (const uint32_t*)cursor;
+    cursor += align8(header->n_edges * sizeof(uint32_t));
+    index->edge_distance = (const uint32_t*)cursor;
+    cursor += align8(header->n_edges * sizeof(uint32_t));
+    index->bucket_start = (const uint32_t*)cursor;
+    cursor += align8((header->buckets + 1) * sizeof(uint32_t));
+    index->posting_name = (const uint32_t*)cursor;
+    cursor += align8(header->n_postings * sizeof(uint32_t));
+    index->posting_count = (const uint32_t*)cursor;
+    cursor += align8(header->n_postings * sizeof(uint32_t));
+    index->pool = cursor;
+
+    index->blob = blob;
+    index->blob_size = size;
+    index->mapped = mapped;
+}
+
+/**
+ * @brief Hash of a NUL-terminated string (FNV-1a).
+ */
+static unsigned int hashName(const char* str) {
+    unsigned int hash = 2166136261u;
+    while (*str)
+        hash = (hash ^ (unsigned char)*str++) * 16777619u;
+    return hash;
+}
+
+/**
+ * @brief Returns the name with the given id.
+ */
+const char* indexName(const NameIndex* index, int id) {
+    return index->pool + index->name_offset[id];
+}
+
+/**
+ * @brief Length of the name with the given id.
+ */
+static int nameLength(const NameIndex* index, int id) {
+    return (int)(index->name_offset[id + 1] - index->name_offset[id]) - 1;
+}
+
+/**
+ * @brief Builds the index over the distinct names of the given list.
+ *
+ * @param names   The names (duplicates and empty names are ignored).
+ * @param n_names The number of names in the list.
+ * @param index   The index to build.
+ *
+ * @return        0 on success, -1 on allocation failure.
+ */
+int buildNameIndex(char** names, int n_names, NameIndex* index) {
+    // Open addressing table used to keep only the distinct names
+    int table_size = 1;
+    while (table_size < 2 * n_names + 2)
+        table_size *= 2;
+    int* table = (int*)malloc(table_size * sizeof(int));
+    char** distinct = (char**)malloc((n_names + 1) * sizeof(char*));
+
+    // Check for memory allocation failure
+    if (table == NULL || distinct == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(table);
+        free(distinct);
+        return -1;
+    }
+    memset(table, -1, table_size * sizeof(int));
+
+    int n = 0;
+    size_t pool_size = 0;
+    for (int i = 0; i < n_names; i++) {
+        if (names[i][0] == '\0')
+            continue;
+        unsigned int slot = hashName(names[i]) & (table_size - 1);
+        while (table[slot] >= 0 && strcmp(distinct[table[slot]], names[i]) != 0)
+            slot = (slot + 1) & (table_size - 1);
+        if (table[slot] < 0) {
+            table[slot] = n;
+            distinct[n++] = names[i];
+            pool_size += strlen(names[i]) + 1;
+        }
+    }
+    free(table);
+
+    // Build the BK-tree with linked lists of children (node i is name i, the root is name 0)
+    int* first_child = (int*)malloc((n + 1) * sizeof(int));
+    int* next_sibling = (int*)malloc((n + 1) * sizeof(int));
+    int* parent_distance = (int*)malloc((n + 1) * sizeof(int));
+    int* parent = (int*)malloc((n + 1) * sizeof(int));
+    if (first_child == NULL || next_sibling == NULL || parent_distance == NULL || parent == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        first_child[i] = -1;
+        next_sibling[i] = -1;
+        parent[i] = -1;
+    }
+
+    for (int i = 1; i < n; i++) {
+        int len = strlen(distinct[i]);
+        int node = 0;
+        while (1) {
+            int d = levenshteinUnitCost(distinct[i], len, distinct[node], strlen(distinct[node]), NULL);
+            int child = first_child[node];
+            while (child >= 0 && parent_distance[child] != d)
+                child = next_sibling[child];
+            if (child < 0) {
+                parent[i] = node;
+                parent_distance[i] = d;
+                next_sibling[i] = first_child[node];
+                first_child[node] = i;
+                break;
+            }
+            node = child;
+        }
+    }
+
+    // Count the postings of the q-gram inverted index
+    unsigned short histogram[QGRAM_BUCKETS];
+    uint32_t* bucket_size = (uint32_t*)calloc(QGRAM_BUCKETS + 1, sizeof(uint32_t));
+    if (bucket_size == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+    size_t n_postings = 0;
+    for (int i = 0; i < n; i++) {
+        qgramHistogram(distinct[i], strlen(distinct[i]), histogram);
+        for (int b = 0; b < QGRAM_BUCKETS; b++) {
+            if (histogram[b] > 0) {
+                bucket_size[b]++;
+                n_postings++;
+            }
+        }
+    }
+
+    // Allocate the blob with the final layout
+    NameIndexHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = NAME_INDEX_MAGIC;
+    header.version = NAME_INDEX_VERSION;
+    header.buckets = QGRAM_BUCKETS;
+    header.n_names = n;
+    header.n_edges = (n > 0) ? n - 1 : 0;
+    header.n_postings = (uint32_t)n_postings;
+    header.pool_size = (uint32_t)pool_size;
+
+    size_t size = blobSize(&header);
+    void* blob = calloc(1, size);
+    if (blob == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+    memcpy(blob, &header, sizeof(header));
+    layoutIndex(index, blob, size, 0);
+
+    uint32_t* name_offset = (uint32_t*)index->name_offset;
+    uint32_t* first_edge = (uint32_t*)index->first_edge;
+    uint32_t* edge_child = (uint32_t*)index->edge_child;
+    uint32_t* edge_distance = (uint32_t*)index->edge_distance;
+    uint32_t* bucket_start = (uint32_t*)index->bucket_start;
+    uint32_t* posting_name = (uint32_t*)index->posting_name;
+    uint32_t* posting_count = (uint32_t*)index->posting_count;
+    char* pool = (char*)index->pool;
+
+    // Fill the pool of names
+    uint32_t offset = 0;
+    for (int i = 0; i < n; i++) {
+        name_offset[i] = offset;
+        strcpy(pool + offset, distinct[i]);
+        offset += strlen(distinct[i]) + 1;
+    }
+    name_offset[n] = offset;
+
+    // Flatten the BK-tree: the children of each node are contiguous and sorted by distance
+    uint32_t edge = 0;
+    for (int i = 0; i < n; i++) {
+        first_edge[i] = edge;
+        for (int child = first_child[i]; child >= 0; child = next_sibling[child]) {
+            // Insertion sort by distance
+            uint32_t pos = edge++;
+            while (pos > first_edge[i] && edge_distance[pos - 1] > (uint32_t)parent_distance[child]) {
+                edge_child[pos] = edge_child[pos - 1];
+                edge_distance[pos] = edge_distance[pos - 1];
+                pos--;
+            }
+            edge_child[pos] = child;
+            edge_distance[pos] = parent_distance[child];
+        }
+    }
+    first_edge[n] = edge;
+
+    // Fill the posting lists, sorted by name id
+    bucket_start[0] = 0;
+    for (int b = 0; b < QGRAM_BUCKETS; b++)
+        bucket_start[b + 1] = bucket_start[b] + bucket_size[b];
+    memset(bucket_size, 0, (QGRAM_BUCKETS + 1) * sizeof(uint32_t));
+    for (int i = 0; i < n; i++) {
+        qgramHistogram(distinct[i], strlen(distinct[i]), histogram);
+        for (int b = 0; b < QGRAM_BUCKETS; b++) {
+            if (histogram[b] > 0) {
+                uint32_t pos = bucket_start[b] + bucket_size[b]++;
+                posting_name[pos] = i;
+                posting_count[pos] = histogram[b];
+            }
+        }
+    }
+
+    // Free the temporary structures
+    free(distinct);
+    free(first_child);
+    free(next_sibling);
+    free(parent_distance);
+    free(parent);
+    free(bucket_size);
+
+    return 0;
+}
+
+/**
+ * @brief Writes the index to a file.
+ *
+ * @param index The index.
+ * @param path  Path of the file.
+ *
+ * @return      0 on success, -1 if the file cannot be written.
+ */
+int saveNameIndex(const NameIndex* index, const char* path) {
+    FILE* fp = fopen(path, "wb");
+
+    // Check if the file can be opened
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", path);
+        return -1;
+    }
+
+    size_t written = fwrite(index->blob, 1, index->blob_size, fp);
+    fclose(fp);
+
+    if (written != index->blob_size) {
+        fprintf(stderr, "ERROR while writing %s.\n", path);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Loads an index file with mmap.
+ *
+ * @param path  Path of the file.
+ * @param index The index to fill.
+ *
+ * @return      0 on success, -1 if the file cannot be mapped or is not a valid index.
+ */
+int loadNameIndex(const char* path, NameIndex* index) {
+    int fd = open(path, O_RDONLY);
+
+    // Check if the file can be opened
+    if (fd < 0) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", path);
+        return -1;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(NameIndexHeader)) {
+        fprintf(stderr, "File %s is not a valid index.\n", path);
+        close(fd);
+        return -1;
+    }
+
+    void* blob = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (blob == MAP_FAILED) {
+        perror("ERROR during the file mapping.");
+        return -1;
+    }
+
+    // Validate the header before trusting the sizes
+    const NameIndexHeader* header = (const NameIndexHeader*)blob;
+    if (header->magic != NAME_INDEX_MAGIC || header->version != NAME_INDEX_VERSION ||
+        header->buckets != QGRAM_BUCKETS || blobSize(header) != (size_t)info.st_size) {
+        fprintf(stderr, "File %s is not a valid index.\n", path);
+        munmap(blob, info.st_size);
+        return -1;
+    }
+
+    layoutIndex(index, blob, info.st_size, 1);
+
+    return 0;
+}
+
+/**
+ * @brief Releases the memory (or the mapping) of the index.
+ *
+ * @param index The index.
+ */
+void freeNameIndex(NameIndex* index) {
+    if (index->mapped)
+        munmap(index->blob, index->blob_size);
+    else
+        free(index->blob);
+    index->blob = NULL;
+}
+
+/**
+ * @brief Comparison function for qsort, ordering the matches by distance and name id.
+ */
+static int compareByDistance(const void* a, const void* b) {
+    const SearchMatch* x = (const SearchMatch*)a;
+    const SearchMatch* y = (const SearchMatch*)b;
+    if (x->distance != y->distance)
+        return x->distance - y->distance;
+    return x->index - y->index;
+}
+
+/**
+ * @brief Appends a match to a growing array.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int appendMatch(SearchMatch** matches, int* n_matches, int* capacity, int id, int distance) {
+    if (*n_matches == *capacity) {
+        *capacity = (*capacity > 0) ? 2 * *capacity : 16;
+        SearchMatch* grown = (SearchMatch*)realloc(*matches, *capacity * sizeof(SearchMatch));
+        if (grown == NULL)
+            return -1;
+        *matches = grown;
+    }
+    (*matches)[*n_matches].index = id;
+    (*matches)[*n_matches].distance = distance;
+    (*n_matches)++;
+    return 0;
+}
+
+/**
+ * @brief Finds all the names within distance k of the query.
+ *
+ * When the q-gram count filter is selective (the query has more than QGRAM_LENGTH * k q-grams),
+ * the candidates are taken from the posting lists of the inverted index; otherwise the BK-tree
+ * is visited, using the triangle inequality to skip subtrees. Every candidate is verified
+ * with the bounded edit distance kernel.
+ *
+ * @param index   The index.
+ * @param query   The query.
+ * @param k       The maximum distance.
+ * @param matches Output parameter that receives a dynamically allocated array of matches,
+ *                sorted by distance and name id. It is the responsibility of the caller to
+ *                free it using free().
+ *
+ * @return        The number of matches, -1 on allocation failure.
+ */
+int searchNameIndex(const NameIndex* index, const char* query, int k, SearchMatch** matches) {
+    int n = index->header->n_names;
+    int query_len = strlen(query);
+    int n_matches = 0, capacity = 0;
+    *matches = NULL;
+
+    if (n == 0)
+        return 0;
+
+    // Minimum number of q-grams shared by the query and any name within distance k
+    int min_shared = query_len - QGRAM_LENGTH + 1 - QGRAM_LENGTH * k;
+
+    if (min_shared > 0) {
+        // Inverted index: only names sharing at least one q-gram can match
+        unsigned short histogram[QGRAM_BUCKETS];
+        qgramHistogram(query, query_len, histogram);
+
+        uint32_t* shared = (uint32_t*)calloc(n, sizeof(uint32_t));
+        uint32_t* touched = (uint32_t*)malloc(n * sizeof(uint32_t));
+        if (shared == NULL || touched == NULL) {
+            fprintf(stderr, "ERROR in memory allocation.\n");
+            free(shared);
+            free(touched);
+            return -1;
+        }
+        int n_touched = 0;
+
+        // Count the shared q-grams of every name in the posting lists of the query
+        for (int b = 0; b < QGRAM_BUCKETS; b++) {
+            if (histogram[b] == 0)
+                continue;
+            for (uint32_t p = index->bucket_start[b]; p < index->bucket_start[b + 1]; p++) {
+                uint32_t id = index->posting_name[p];
+                if (shared[id] == 0)
+                    touched[n_touched++] = id;
+                shared[id] += (index->posting_count[p] < histogram[b]) ? index->posting_count[p] : histogram[b];
+            }
+        }
+
+        // Apply the count filter and verify the survivors
+        for (int t = 0; t < n_touched; t++) {
+            int id = touched[t];
+            int len = nameLength(index, id);
+            int longest = (len > query_len) ? len : query_len;
+            if ((int)shared[id] < longest - QGRAM_LENGTH + 1 - QGRAM_LENGTH * k)
+                continue;
+            int d = boundedLevenshtein(query, query_len, indexName(index, id), len, k);
+            if (d >= 0 && d <= k && appendMatch(matches, &n_matches, &capacity, id, d) != 0) {
+                n_matches = -1;
+                break;
+            }
+        }
+
+        free(shared);
+        free(touched);
+    } else {
+        // BK-tree: visit only the children whose edge distance is within k of the node distance
+        int* stack = (int*)malloc(n * sizeof(int));
+        if (stack == NULL) {
+            fprintf(stderr, "ERROR in memory allocation.\n");
+            return -1;
+        }
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0 && n_matches >= 0) {
+            int node = stack[--top];
+            uint32_t begin = index->first_edge[node];
+            uint32_t end = index->first_edge[node + 1];
+            int max_edge = (end > begin) ? (int)index->edge_distance[end - 1] : 0;
+
+            // Distances above k + max_edge exclude the node and all its children alike
+            int d = boundedLevenshtein(query, query_len, indexName(index, node), nameLength(index, node), k + max_edge);
+            if (d < 0)
+                break;
+            if (d <= k && appendMatch(matches, &n_matches, &capacity, node, d) != 0) {
+                n_matches = -1;
+                break;
+            }
+
+            for (uint32_t e = begin; e < end; e++) {
+                int edge_d = (int)index->edge_distance[e];
+                if (edge_d >= d - k && edge_d <= d + k)
+                    stack[top++] = index->edge_child[e];
+            }
+        }
+
+        free(stack);
+    }
+
+    if (n_matches < 0) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(*matches);
+        *matches = NULL;
+        return -1;
+    }
+
+    qsort(*matches, n_matches, sizeof(SearchMatch), compareByDistance);
+
+    return n_matches;
+}
@@ -0,0 +1,138 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#ifndef FUZZY_NAME_INDEX_H
+#define FUZZY_NAME_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Top_K_Search.h"
+
+//Magic number at the beginning of an index file ("FNIX")
+#define NAME_INDEX_MAGIC 0x58494E46
+//Version of the index file layout
+#define NAME_INDEX_VERSION 1
+
+/**
+ * @brief Header of the index, at the beginning of the on-disk file.
+ *
+ * The header is followed by the arrays of the index, in the order of the fields of NameIndex,
+ * so the file can be used directly from an mmap without any parsing.
+ */
+typedef struct {
+    uint32_t magic;       /**< NAME_INDEX_MAGIC. */
+    uint32_t version;     /**< NAME_INDEX_VERSION. */
+    uint32_t buckets;     /**< Number of q-gram buckets (QGRAM_BUCKETS at build time). */
+    uint32_t n_names;     /**< Number of distinct names. */
+    uint32_t n_edges;     /**< Number of BK-tree edges (n_names - 1). */
+    uint32_t n_postings;  /**< Number of entries of the q-gram posting lists. */
+    uint32_t pool_size;   /**< Size in bytes of the pool of NUL-terminated names. */
+    uint32_t reserved;    /**< Padding, keeps the arrays 8-byte aligned. */
+} NameIndexHeader;
+
+/**
+ * @brief BK-tree plus q-gram inverted index over a set of distinct names.
+ *
+ * Node i of the BK-tree is name i, the root is name 0. The children of node i are the edges
+ * in [first_edge[i], first_edge[i + 1]), sorted by distance. The posting list of bucket b is
+ * the range [bucket_start[b], bucket_start[b + 1]) of posting_name and posting_count.
+ */
+typedef struct {
+    const NameIndexHeader* header;  /**< Header of the index. */
+    const uint32_t* name_offset;    /**< Offset of each name in the pool (n_names + 1 entries). */
+    const uint32_t* first_edge;     /**< First child edge of each node (n_names + 1 entries). */
+    const uint32_t* edge_child;     /**< Child node of each edge. */
+    const uint32_t* edge_distance;  /**< Distance between parent and child of each edge. */
+    const uint32_t* bucket_start;   /**< First posting of each bucket (buckets + 1 entries). */
+    const uint32_t* posting_name;   /**< Name of each posting. */
+    const uint32_t* posting_count;  /**< Occurrences of the bucket in the name of each posting. */
+    const char* pool;               /**< The names, NUL-terminated. */
+    void* blob;                     /**< Memory holding the whole index. */
+    size_t blob_size;               /**< Size of the blob in bytes. */
+    int mapped;                     /**< 1 if the blob is an mmap of a file, 0 if allocated. */
+} NameIndex;
+
+/**
+ * @brief Builds the index over the distinct names of the given list.
+ *
+ * @param names   The names (duplicates and empty names are ignored).
+ * @param n_names The number of names in the list.
+ * @param index   The index to build.
+ *
+ * @return        0 on success, -1 on allocation failure.
+ */
+int buildNameIndex(char** names, int n_names, NameIndex* index);
+
+/**
+ * @brief Writes the index to a file.
+ *
+ * @param index The index.
+ * @param path  Path of the file.
+ *
+ * @return      0 on success, -1 if the file cannot be written.
+ */
+int saveNameIndex(const NameIndex* index, const char* path);
+
+/**
+ * @brief Loads an index file with mmap.
+ *
+ * @param path  Path of the file.
+ * @param index The index to fill.
+ *
+ * @return      0 on success, -1 if the file cannot be mapped or is not a valid index.
+ */
+int loadNameIndex(const char* path, NameIndex* index);
+
+/**
+ * @brief Releases the memory (or the mapping) of the index.
+ *
+ * @param index The index.
+ */
+void freeNameIndex(NameIndex* index);
+
+/**
+ * @brief Returns the name with the given id.
+ */
+const char* indexName(const NameIndex* index, int id);
+
+/**
+ * @brief Finds all the names within distance k of the query.
+ *
+ * When the q-gram count filter is selective (the query has more than QGRAM_LENGTH * k q-grams),
+ * the candidates are taken from the posting lists of the inverted index; otherwise the BK-tree
+ * is visited, using the triangle inequality to skip subtrees. Every candidate is verified
+ * with the bounded edit distance kernel.
+ *
+ * @param index   The index.
+ * @param query   The query.
+ * @param k       The maximum distance.
+ * @param matches Output parameter that receives a dynamically allocated array of matches,
+ *                sorted by distance and name id. It is the responsibility of the caller to
+ *                free it using free().
+ *
+ * @return        The number of matches, -1 on allocation failure.
+ */
+int searchNameIndex(const NameIndex* index, const char* query, int k, SearchMatch** matches);
+
+#endif
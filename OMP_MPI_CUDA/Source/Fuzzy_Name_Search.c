@@ -0,0 +1,233 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "Fuzzy_Name_Index.h"
+//Constant for the time conversion
+#define SEC_CONV 1000000
+//Column of the coach name in the players dataset
+#define COACH_NAME_COLUMN 3
+//Column of the player name in the players dataset
+#define PLAYER_NAME_COLUMN 6
+
+/**
+ * @brief Calculates the duration between two time points and converts it to seconds.
+ *
+ * This function takes two `struct timeval` time points, calculates the duration between them,
+ * and converts the result to seconds for easier interpretation. It uses a conversion factor
+ * `SEC_CONV` to handle the microsecond part of the time.
+ *
+ * @param start The starting time point.
+ * @param stop  The ending time point.
+ *
+ * @return      The duration between the two time points in seconds.
+ */
+double getTotalTime(struct timeval start, struct timeval stop) {
+    unsigned long long start_time, stop_time;
+
+    // Convert timeval to microseconds
+    start_time = (unsigned long long)start.tv_sec * SEC_CONV + start.tv_usec;
+    stop_time = (unsigned long long)stop.tv_sec * SEC_CONV + stop.tv_usec;
+
+    // Calculate the duration in microseconds and convert it to seconds
+    return (double)(stop_time - start_time) / (double)SEC_CONV;
+}
+
+/**
+ * @brief Copies the given column of a CSV row into a newly allocated string.
+ *
+ * @param row    The row, fields separated by commas.
+ * @param column The index of the column.
+ *
+ * @return       A dynamically allocated copy of the field (empty if the row has fewer columns).
+ */
+char* csvField(const char* row, int column) {
+    // Skip the previous fields
+    for (int c = 0; c < column && row != NULL; c++) {
+        row = strchr(row, ',');
+        if (row != NULL)
+            row++;
+    }
+    if (row == NULL)
+        return strdup("");
+
+    // Copy the field up to the next separator
+    size_t len = strcspn(row, ",\r\n");
+    char* field = (char*)malloc(len + 1);
+    memcpy(field, row, len);
+    field[len] = '\0';
+
+    return field;
+}
+
+/**
+ * @brief Builds the index over the player and coach names of the dataset and writes it to a file.
+ *
+ * @param csv_path   Path of the players dataset.
+ * @param index_path Path of the index file.
+ *
+ * @return           0 on success, 1 otherwise.
+ */
+int buildCommand(const char* csv_path, const char* index_path) {
+    FILE* fp = fopen(csv_path, "r");
+
+    // Check if the file can be opened
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", csv_path);
+        return 1;
+    }
+
+    struct timeval build_start, build_stop;
+    gettimeofday(&build_start, NULL);
+
+    // Collect the names of both columns (the header is skipped)
+    int capacity = 1024, n_names = 0;
+    char** names = (char**)malloc(capacity * sizeof(char*));
+
+    // Check for memory allocation failure
+    if (names == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        fclose(fp);
+        return 1;
+    }
+
+    char* line = NULL;
+    size_t size = 0;
+    int header = 1;
+    while (getline(&line, &size, fp) != -1) {
+        if (header) {
+            header = 0;
+            continue;
+        }
+        if (n_names + 2 > capacity) {
+            capacity *= 2;
+            char** grown = (char**)realloc(names, capacity * sizeof(char*));
+
+            // Check for memory allocation failure (the old block is still valid)
+            if (grown == NULL) {
+                fprintf(stderr, "ERROR in memory allocation.\n");
+                for (int i = 0; i < n_names; i++)
+                    free(names[i]);
+                free(names);
+                free(line);
+                fclose(fp);
+                return 1;
+            }
+            names = grown;
+        }
+        names[n_names++] = csvField(line, PLAYER_NAME_COLUMN);
+        names[n_names++] = csvField(line, COACH_NAME_COLUMN);
+    }
+    free(line);
+    fclose(fp);
+
+    // Build the index and write it
+    NameIndex index;
+    if (buildNameIndex(names, n_names, &index) != 0)
+        return 1;
+    int result = saveNameIndex(&index, index_path);
+
+    gettimeofday(&build_stop, NULL);
+
+    printf("Names;%d;Distinct;%u;Bytes;%zu;Build_time;%06f\n", n_names, index.header->n_names,
+           index.blob_size, getTotalTime(build_start, build_stop));
+
+    // Free allocated memory
+    freeNameIndex(&index);
+    for (int i = 0; i < n_names; i++)
+        free(names[i]);
+    free(names);
+
+    return result == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Loads the index file and prints all the names within distance k of the query.
+ *
+ * @param index_path Path of the index file.
+ * @param query      The name to search.
+ * @param k          The maximum distance.
+ *
+ * @return           0 on success, 1 otherwise.
+ */
+int queryCommand(const char* index_path, const char* query, int k) {
+    struct timeval load_start, load_stop, query_start, query_stop;
+
+    // Map the index
+    gettimeofday(&load_start, NULL);
+    NameIndex index;
+    if (loadNameIndex(index_path, &index) != 0)
+        return 1;
+    gettimeofday(&load_stop, NULL);
+
+    // Search the names
+    gettimeofday(&query_start, NULL);
+    SearchMatch* matches;
+    int n_matches = searchNameIndex(&index, query, k, &matches);
+    gettimeofday(&query_stop, NULL);
+
+    if (n_matches < 0) {
+        freeNameIndex(&index);
+        return 1;
+    }
+
+    // Print the matches and the timing information (in microseconds)
+    for (int i = 0; i < n_matches; i++)
+        printf("%d;%s\n", matches[i].distance, indexName(&index, matches[i].index));
+    printf("Matches;%d;Load_us;%.0f;Query_us;%.0f\n", n_matches,
+           getTotalTime(load_start, load_stop) * SEC_CONV, getTotalTime(query_start, query_stop) * SEC_CONV);
+
+    free(matches);
+    freeNameIndex(&index);
+
+    return 0;
+}
+
+/**
+ * @brief Main function for the fuzzy name index program.
+ *
+ * With "build" it indexes the "Player Name" and "Coach Name" columns of the players dataset
+ * into an index file; with "query" it maps the index file and prints all the names within
+ * distance k of the given name.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    if (argc == 4 && strcmp(argv[1], "build") == 0)
+        return buildCommand(argv[2], argv[3]);
+
+    if (argc == 5 && strcmp(argv[1], "query") == 0)
+        return queryCommand(argv[2], argv[3], atoi(argv[4]));
+
+    fprintf(stderr, "Usage: %s build <players_csv> <index_file>\n", argv[0]);
+    fprintf(stderr, "       %s query <index_file> <name> <k>\n", argv[0]);
+    return 1;
+}
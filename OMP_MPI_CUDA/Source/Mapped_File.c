@@ -0,0 +1,85 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Mapped_File.h"
+
+/**
+ * @brief Maps a whole file in memory, read-only.
+ *
+ * @param path Path of the file.
+ * @param file The mapping to fill.
+ *
+ * @return     0 on success, -1 if the file cannot be mapped.
+ */
+int mapFile(const char* path, MappedFile* file) {
+    int fd = open(path, O_RDONLY);
+
+    // Check if the file can be opened
+    if (fd < 0) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", path);
+        return -1;
+    }
+
+    struct stat info;
+    fstat(fd, &info);
+    file->size = info.st_size;
+
+    // An empty file cannot be mapped, but it is still a valid (empty) dataset
+    if (file->size == 0) {
+        file->data = "";
+        close(fd);
+        return 0;
+    }
+
+    void* data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        perror("ERROR during the file mapping.");
+        return -1;
+    }
+
+    // The file is read sequentially by each thread
+    madvise(data, file->size, MADV_SEQUENTIAL);
+    file->data = (const char*)data;
+
+    return 0;
+}
+
+/**
+ * @brief Releases a mapping created by mapFile().
+ */
+void unmapFile(MappedFile* file) {
+    if (file->size > 0)
+        munmap((void*)file->data, file->size);
+    file->data = NULL;
+    file->size = 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stddef.h>
+
+/**
+ * @brief A read-only memory mapping of a whole file.
+ */
+typedef struct {
+    const char* data;  /**< First byte of the file. */
+    size_t size;       /**< Size of the file in bytes. */
+} MappedFile;
+
+/**
+ * @brief Maps a whole file in memory, read-only.
+ *
+ * @param path Path of the file.
+ * @param file The mapping to fill.
+ *
+ * @return     0 on success, -1 if the file cannot be mapped.
+ */
+int mapFile(const char* path, MappedFile* file);
+
+/**
+ * @brief Releases a mapping created by mapFile().
+ */
+void unmapFile(MappedFile* file);
+
+#endif
@@ -0,0 +1,238 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <stdatomic.h>
+#include "Memory_Accounting.h"
+//Maximum number of threads with their own counters (the others share the last ones)
+#define MAX_THREADS 256
+//Size of a cache line, the alignment of the counters of each thread
+#define CACHE_LINE 64
+
+/**
+ * @brief Allocation counters of a thread, on their own cache line (the alignment of the first
+ * member aligns the struct and rounds its size up to a whole line).
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) _Atomic long long allocated;  /**< Bytes currently allocated by the thread. */
+    _Atomic long long base;                            /**< Bytes allocated by the thread at the start of the phase. */
+    _Atomic long long high_water;                      /**< Highest value of allocated during the phase. */
+    _Atomic long long allocations;                     /**< Number of allocations during the phase. */
+} ThreadCounters;
+
+static ThreadCounters threads[MAX_THREADS];
+static _Atomic int n_threads = 0;
+static _Thread_local int slot = -1;
+
+// Counters of the whole process
+static _Atomic long long process_allocated = 0;
+static _Atomic long long process_base = 0;
+static _Atomic long long process_high_water = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+/**
+ * @brief Raises a high-water mark to the given value, if it is lower.
+ */
+static void raiseHighWater(_Atomic long long* high_water, long long value) {
+    long long current = atomic_load_explicit(high_water, memory_order_relaxed);
+    while (value > current && !atomic_compare_exchange_weak_explicit(high_water, &current, value, memory_order_relaxed, memory_order_relaxed))
+        ;
+}
+
+/**
+ * @brief Returns the counters of the calling thread, assigning them on its first allocation.
+ */
+static ThreadCounters* threadCounters(void) {
+    if (slot < 0) {
+        slot = atomic_fetch_add(&n_threads, 1);
+        if (slot >= MAX_THREADS)
+            slot = MAX_THREADS - 1;
+    }
+    return &threads[slot];
+}
+
+/**
+ * @brief Counts an allocation (bytes > 0) or a release (bytes < 0) of the calling thread.
+ */
+static void countBytes(long long bytes, int allocation) {
+    ThreadCounters* counters = threadCounters();
+
+    long long allocated = atomic_fetch_add_explicit(&counters->allocated, bytes, memory_order_relaxed) + bytes;
+    long long total = atomic_fetch_add_explicit(&process_allocated, bytes, memory_order_relaxed) + bytes;
+    if (bytes > 0) {
+        raiseHighWater(&counters->high_water, allocated);
+        raiseHighWater(&process_high_water, total);
+    }
+    if (allocation)
+        atomic_fetch_add_explicit(&counters->allocations, 1, memory_order_relaxed);
+}
+
+/*
+ * Wrappers of the allocation functions: the objects linked with --wrap call them in place of
+ * the ones of the C library.
+ */
+void* __wrap_malloc(size_t size) {
+    void* ptr = __real_malloc(size);
+    if (ptr != NULL)
+        countBytes(malloc_usable_size(ptr), 1);
+    return ptr;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    void* ptr = __real_calloc(count, size);
+    if (ptr != NULL)
+        countBytes(malloc_usable_size(ptr), 1);
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    long long old_size = (ptr != NULL) ? (long long)malloc_usable_size(ptr) : 0;
+    void* new_ptr = __real_realloc(ptr, size);
+
+    // A failed realloc leaves the old block untouched
+    if (new_ptr != NULL || size == 0) {
+        countBytes(-old_size, 0);
+        if (new_ptr != NULL)
+            countBytes(malloc_usable_size(new_ptr), 1);
+    }
+    return new_ptr;
+}
+
+void __wrap_free(void* ptr) {
+    if (ptr != NULL)
+        countBytes(-(long long)malloc_usable_size(ptr), 0);
+    __real_free(ptr);
+}
+
+/**
+ * @brief Reads a field of a file of /proc/self (status or smaps_rollup), in bytes.
+ *
+ * @param path The path of the file.
+ * @param name The name of the field, with the colon (e.g. "VmHWM:").
+ *
+ * @return     The value of the field, 0 if it cannot be read.
+ */
+static long long readProcField(const char* path, const char* name) {
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL)
+        return 0;
+
+    long long value = 0;
+    char line[256];
+    size_t len = strlen(name);
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (strncmp(line, name, len) == 0) {
+            value = atoll(line + len) * 1024;
+            break;
+        }
+    }
+
+    fclose(fp);
+
+    return value;
+}
+
+/**
+ * @brief Starts a phase: resets the peak resident set size and the high-water marks.
+ */
+void memoryPhaseStart(void) {
+    // Reset the peak resident set size (VmHWM) to the current one
+    FILE* fp = fopen("/proc/self/clear_refs", "w");
+    if (fp != NULL) {
+        fputs("5", fp);
+        fclose(fp);
+    }
+
+    // The high-water marks start from the bytes allocated now
+    int used = atomic_load(&n_threads);
+    if (used > MAX_THREADS)
+        used = MAX_THREADS;
+    for (int t = 0; t < used; t++) {
+        long long allocated = atomic_load(&threads[t].allocated);
+        atomic_store(&threads[t].base, allocated);
+        atomic_store(&threads[t].high_water, allocated);
+        atomic_store(&threads[t].allocations, 0);
+    }
+    long long allocated = atomic_load(&process_allocated);
+    atomic_store(&process_base, allocated);
+    atomic_store(&process_high_water, allocated);
+}
+
+/**
+ * @brief Stops a phase and reads its memory usage.
+ *
+ * @param phase The memory usage to fill.
+ */
+void memoryPhaseStop(MemoryPhase* phase) {
+    // The pages shared with other processes (e.g. the MPI windows of a node) are counted by
+    // each of them: remove the share of the others, as in the proportional set size (PSS)
+    long long shared = readProcField("/proc/self/smaps_rollup", "Rss:") - readProcField("/proc/self/smaps_rollup", "Pss:");
+    phase->peak_rss = readProcField("/proc/self/status", "VmHWM:") - ((shared > 0) ? shared : 0);
+    phase->allocated = atomic_load(&process_high_water) - atomic_load(&process_base);
+    phase->thread_allocated = 0;
+    phase->allocations = 0;
+
+    int used = atomic_load(&n_threads);
+    if (used > MAX_THREADS)
+        used = MAX_THREADS;
+    for (int t = 0; t < used; t++) {
+        long long allocated = atomic_load(&threads[t].high_water) - atomic_load(&threads[t].base);
+        if (allocated > phase->thread_allocated)
+            phase->thread_allocated = allocated;
+        phase->allocations += atomic_load(&threads[t].allocations);
+    }
+}
+
+/**
+ * @brief Prints the memory columns of a line of the Informations files.
+ *
+ * The columns are the peak RSS of the phases (generation, partitioning, kernel), their
+ * allocated bytes, the bytes allocated by the busiest thread of the kernel, the number of
+ * allocations of all the phases and the bytes allocated by the kernel per DP cell it computed
+ * (0 if no cell was computed). The line is not ended.
+ *
+ * @param fp     The file.
+ * @param phases Memory used by the phases.
+ * @param cells  DP cells computed by the kernel.
+ */
+void printMemoryToCSV(FILE* fp, const MemoryPhase* phases, double cells) {
+    long long allocations = 0;
+    for (int p = 0; p < N_PHASES; p++)
+        allocations += phases[p].allocations;
+    fprintf(fp, "%lld;%lld;%lld;%lld;%lld;%lld;%lld;%lld;", phases[PHASE_GENERATION].peak_rss,
+            phases[PHASE_PARTITIONING].peak_rss, phases[PHASE_KERNEL].peak_rss, phases[PHASE_GENERATION].allocated,
+            phases[PHASE_PARTITIONING].allocated, phases[PHASE_KERNEL].allocated, phases[PHASE_KERNEL].thread_allocated,
+            allocations);
+
+    // Bytes per cell of the cells actually computed, far fewer than n_characters^2 with partitions
+    fprintf(fp, "%06f;", (cells > 0) ? (double)phases[PHASE_KERNEL].allocated / cells : 0.0);
+}
@@ -0,0 +1,80 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <stdio.h>
+
+//Phases of the Edit Distance executables
+#define PHASE_GENERATION 0
+#define PHASE_PARTITIONING 1
+#define PHASE_KERNEL 2
+#define N_PHASES 3
+
+/*
+ * The allocations are counted by wrapping malloc, calloc, realloc and free at link time, so
+ * the executables must be linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free.
+ * Only the allocations of the objects of the project are counted (not the ones of the MPI
+ * library), and each thread has its own counters.
+ */
+
+/**
+ * @brief Memory used by a phase of the program.
+ */
+typedef struct {
+    long long peak_rss;           /**< Peak resident set size of the process during the phase, without the share of the other processes of its shared pages, in bytes. */
+    long long allocated;          /**< Highest number of bytes allocated during the phase, on top of the ones allocated at its start. */
+    long long thread_allocated;   /**< The same, for the thread that allocated the most. */
+    long long allocations;        /**< Number of allocations of the phase. */
+} MemoryPhase;
+
+/**
+ * @brief Starts a phase: resets the peak resident set size and the high-water marks.
+ */
+void memoryPhaseStart(void);
+
+/**
+ * @brief Stops a phase and reads its memory usage.
+ *
+ * @param phase The memory usage to fill.
+ */
+void memoryPhaseStop(MemoryPhase* phase);
+
+/**
+ * @brief Prints the memory columns of a line of the Informations files.
+ *
+ * The columns are the peak RSS of the phases (generation, partitioning, kernel), their
+ * allocated bytes, the bytes allocated by the busiest thread of the kernel, the number of
+ * allocations of all the phases and the bytes allocated by the kernel per DP cell it computed
+ * (0 if no cell was computed). The line is not ended.
+ *
+ * @param fp     The file.
+ * @param phases Memory used by the phases.
+ * @param cells  DP cells computed by the kernel.
+ */
+void printMemoryToCSV(FILE* fp, const MemoryPhase* phases, double cells);
+
+#endif
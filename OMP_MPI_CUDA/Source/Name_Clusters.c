@@ -0,0 +1,402 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <omp.h>
+#include "Name_Clusters.h"
+#include "Edit_Distance_Kernels.h"
+
+/**
+ * @brief A name with its length and its position in the input.
+ */
+typedef struct {
+    const char* name;
+    int length;
+    int input;
+} SortedName;
+
+/**
+ * @brief A segment of a name in the segment index: the hash of (length, segment, text) and the name id.
+ */
+typedef struct {
+    uint64_t key;
+    int id;
+} SegmentEntry;
+
+/**
+ * @brief Comparison function for qsort, ordering the names by length and input position.
+ */
+static int compareByLength(const void* a, const void* b) {
+    const SortedName* x = (const SortedName*)a;
+    const SortedName* y = (const SortedName*)b;
+    if (x->length != y->length)
+        return x->length - y->length;
+    return x->input - y->input;
+}
+
+/**
+ * @brief Comparison function for qsort, ordering the q-grams.
+ */
+static int compareGrams(const void* a, const void* b) {
+    return (int)*(const unsigned short*)a - (int)*(const unsigned short*)b;
+}
+
+/**
+ * @brief Comparison function for qsort, ordering the segment entries by key and name id.
+ */
+static int compareSegments(const void* a, const void* b) {
+    const SegmentEntry* x = (const SegmentEntry*)a;
+    const SegmentEntry* y = (const SegmentEntry*)b;
+    if (x->key != y->key)
+        return (x->key < y->key) ? -1 : 1;
+    return x->id - y->id;
+}
+
+/**
+ * @brief Hash of a segment of a name, together with the length of the name and the index of the segment (FNV-1a).
+ */
+static uint64_t segmentKey(int length, int segment, const char* text, int text_length) {
+    uint64_t hash = 14695981039346656037ull;
+    hash = (hash ^ (uint64_t)length) * 1099511628211ull;
+    hash = (hash ^ (uint64_t)segment) * 1099511628211ull;
+    for (int i = 0; i < text_length; i++)
+        hash = (hash ^ (unsigned char)text[i]) * 1099511628211ull;
+    return hash;
+}
+
+/**
+ * @brief Start of a segment of a name of the given length split in k + 1 segments.
+ *
+ * The first segments are one character shorter when the length is not a multiple of k + 1.
+ */
+static int segmentStart(int length, int k, int segment) {
+    int parts = k + 1, base = length / parts, longer = length % parts;
+    int shorter = parts - longer;
+    return (segment <= shorter) ? segment * base : shorter * base + (segment - shorter) * (base + 1);
+}
+
+/**
+ * @brief Number of q-grams shared by two names, merging their sorted (q-gram, multiplicity) lists.
+ */
+static int sharedGrams(const unsigned short* grams, const unsigned short* gram_count, unsigned int first1, unsigned int end1,
+                       unsigned int first2, unsigned int end2) {
+    int shared = 0;
+    while (first1 < end1 && first2 < end2) {
+        if (grams[first1] < grams[first2]) {
+            first1++;
+        } else if (grams[first1] > grams[first2]) {
+            first2++;
+        } else {
+            shared += (gram_count[first1] < gram_count[first2]) ? gram_count[first1] : gram_count[first2];
+            first1++;
+            first2++;
+        }
+    }
+    return shared;
+}
+
+/**
+ * @brief Finds the root of a set of the union-find, halving the path with compare-and-swap.
+ */
+static int findRoot(int* parent, int x) {
+    while (1) {
+        int p = __atomic_load_n(&parent[x], __ATOMIC_RELAXED);
+        if (p == x)
+            return x;
+        int grandparent = __atomic_load_n(&parent[p], __ATOMIC_RELAXED);
+        if (grandparent != p)
+            __sync_bool_compare_and_swap(&parent[x], p, grandparent);
+        x = grandparent;
+    }
+}
+
+/**
+ * @brief Merges the sets of two elements of the union-find, without locks.
+ *
+ * The root with the larger index is linked below the other one with compare-and-swap; if
+ * another thread changed it in the meantime the roots are found again.
+ */
+static void unionSets(int* parent, int a, int b) {
+    while (1) {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a == b)
+            return;
+        if (a < b) {
+            int swap = a;
+            a = b;
+            b = swap;
+        }
+        if (__sync_bool_compare_and_swap(&parent[a], a, b))
+            return;
+    }
+}
+
+/**
+ * @brief Groups the names that are within edit distance k of each other (transitively).
+ *
+ * The names are sorted by length, so each name is only compared with the longer names of the
+ * length buckets within k of its own. Inside that window the candidates come from blocks of
+ * names sharing a q-gram: every name is split in k + 1 segments, and a name at distance at most
+ * k from it must contain one of the segments, shifted by at most (k + length difference) / 2
+ * positions (pigeonhole principle). The candidates must also share max(len1, len2) - 1 - 2 * k q-grams of length 2,
+ * then they are verified in parallel by the OpenMP threads with the bounded edit distance
+ * kernel, and the matching pairs are merged in a lock-free union-find.
+ *
+ * @param names     The names (distinct).
+ * @param n_names   The number of names.
+ * @param k         The maximum edit distance between two names of the same cluster.
+ * @param n_threads The number of OpenMP threads.
+ * @param cluster   Output array: for each name, the index of the first name of its cluster.
+ * @param stats     Output statistics (can be NULL).
+ *
+ * @return          The number of clusters, -1 on allocation failure.
+ */
+int clusterNames(char** names, int n_names, int k, int n_threads, int* cluster, ClusterStatistics* stats) {
+    // Sort the names by length: the length buckets are contiguous ranges of ids
+    SortedName* sorted = (SortedName*)malloc((n_names + 1) * sizeof(SortedName));
+    int* last_in_window = (int*)malloc((n_names + 1) * sizeof(int));
+    int* parent = (int*)malloc((n_names + 1) * sizeof(int));
+    unsigned int* gram_start = (unsigned int*)malloc((n_names + 1) * sizeof(unsigned int));
+    unsigned int* gram_end = (unsigned int*)malloc((n_names + 1) * sizeof(unsigned int));
+    if (sorted == NULL || last_in_window == NULL || parent == NULL || gram_start == NULL || gram_end == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(sorted);
+        free(last_in_window);
+        free(parent);
+        free(gram_start);
+        free(gram_end);
+        return -1;
+    }
+
+    for (int i = 0; i < n_names; i++) {
+        sorted[i].name = names[i];
+        sorted[i].length = strlen(names[i]);
+        sorted[i].input = i;
+    }
+    qsort(sorted, n_names, sizeof(SortedName), compareByLength);
+
+    // Last name of the length window of each name (lengths within k)
+    for (int i = 0, j = 0; i < n_names; i++) {
+        if (j < i)
+            j = i;
+        while (j + 1 < n_names && sorted[j + 1].length <= sorted[i].length + k)
+            j++;
+        last_in_window[i] = j;
+    }
+
+    // Names up to 2 * k + 1 characters share too few q-grams to be filtered: they are compared directly
+    int first_segmented = 0;
+    while (first_segmented < n_names && sorted[first_segmented].length <= 2 * k + 1)
+        first_segmented++;
+
+    unsigned int total_grams = 0;
+    for (int i = 0; i < n_names; i++) {
+        gram_start[i] = total_grams;
+        total_grams += (sorted[i].length > 1) ? sorted[i].length - 1 : 0;
+    }
+    gram_start[n_names] = total_grams;
+
+    long long n_segments = (long long)(n_names - first_segmented) * (k + 1);
+    unsigned short* grams = (unsigned short*)malloc((total_grams + 1) * sizeof(unsigned short));
+    unsigned short* gram_count = (unsigned short*)malloc((total_grams + 1) * sizeof(unsigned short));
+    SegmentEntry* segments = (SegmentEntry*)malloc((n_segments + 1) * sizeof(SegmentEntry));
+    if (grams == NULL || gram_count == NULL || segments == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(sorted);
+        free(last_in_window);
+        free(parent);
+        free(gram_start);
+        free(gram_end);
+        free(grams);
+        free(gram_count);
+        free(segments);
+        return -1;
+    }
+
+    #pragma omp parallel for num_threads(n_threads) schedule(dynamic, 256)
+    for (int i = 0; i < n_names; i++) {
+        // Sorted q-grams of the name, compressed into (q-gram, multiplicity) pairs
+        const unsigned char* str = (const unsigned char*)sorted[i].name;
+        unsigned short* own = grams + gram_start[i];
+        int n_grams = (sorted[i].length > 1) ? sorted[i].length - 1 : 0;
+        for (int p = 0; p < n_grams; p++)
+            own[p] = (unsigned short)(str[p] << 8 | str[p + 1]);
+        qsort(own, n_grams, sizeof(unsigned short), compareGrams);
+
+        int distinct = 0;
+        for (int p = 0; p < n_grams; p++) {
+            if (distinct > 0 && own[distinct - 1] == own[p]) {
+                gram_count[gram_start[i] + distinct - 1]++;
+            } else {
+                own[distinct] = own[p];
+                gram_count[gram_start[i] + distinct] = 1;
+                distinct++;
+            }
+        }
+        gram_end[i] = gram_start[i] + distinct;
+        parent[i] = i;
+
+        // The k + 1 segments of the name
+        if (i >= first_segmented) {
+            for (int s = 0; s <= k; s++) {
+                int start = segmentStart(sorted[i].length, k, s);
+                int stop = segmentStart(sorted[i].length, k, s + 1);
+                SegmentEntry* entry = &segments[(long long)(i - first_segmented) * (k + 1) + s];
+                entry->key = segmentKey(sorted[i].length, s, sorted[i].name + start, stop - start);
+                entry->id = i;
+            }
+        }
+    }
+
+    // Segment index: the blocks are the ranges of entries with the same key, sorted by id (so by length)
+    qsort(segments, n_segments, sizeof(SegmentEntry), compareSegments);
+
+    long long blocked = 0, verified = 0, matched = 0;
+    int failed = 0;
+
+    #pragma omp parallel num_threads(n_threads) reduction(+:blocked, verified, matched)
+    {
+        // Candidates of the current name
+        char* touched_flag = (char*)calloc(n_names + 1, 1);
+        int* touched = (int*)malloc((n_names + 1) * sizeof(int));
+        if (touched_flag == NULL || touched == NULL) {
+            #pragma omp atomic write
+            failed = 1;
+        }
+
+        #pragma omp for schedule(dynamic, 64)
+        for (int i = 0; i < n_names; i++) {
+            if (touched_flag == NULL || touched == NULL)
+                continue;
+
+            int last = last_in_window[i];
+            int n_touched = 0;
+
+            // Short names of the window
+            for (int j = i + 1; j <= last && j < first_segmented; j++) {
+                touched_flag[j] = 1;
+                touched[n_touched++] = j;
+            }
+
+            // Longer names of the window, from the blocks of the segments contained in this name
+            int length = sorted[i].length;
+            for (int other = (length > 2 * k + 1) ? length : 2 * k + 2; other <= length + k; other++) {
+                for (int s = 0; s <= k; s++) {
+                    int start = segmentStart(other, k, s);
+                    int segment_length = segmentStart(other, k, s + 1) - start;
+                    // Edits before the segment shift it by d with |d| + |other - length + d| <= k
+                    int first_position = start - (k + other - length) / 2;
+                    int last_position = start + (k - other + length) / 2;
+                    if (first_position < 0)
+                        first_position = 0;
+                    if (last_position > length - segment_length)
+                        last_position = length - segment_length;
+
+                    for (int position = first_position; position <= last_position; position++) {
+                        uint64_t key = segmentKey(other, s, sorted[i].name + position, segment_length);
+
+                        // First entry of the block with a key and an id after this name
+                        long long low = 0, high = n_segments;
+                        while (low < high) {
+                            long long middle = low + (high - low) / 2;
+                            if (segments[middle].key < key || (segments[middle].key == key && segments[middle].id <= i))
+                                low = middle + 1;
+                            else
+                                high = middle;
+                        }
+                        for (long long e = low; e < n_segments && segments[e].key == key && segments[e].id <= last; e++) {
+                            if (!touched_flag[segments[e].id]) {
+                                touched_flag[segments[e].id] = 1;
+                                touched[n_touched++] = segments[e].id;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Count filter on the q-grams, then verify the surviving candidates
+            blocked += n_touched;
+            for (int t = 0; t < n_touched; t++) {
+                int candidate = touched[t];
+                touched_flag[candidate] = 0;
+                if (sharedGrams(grams, gram_count, gram_start[i], gram_end[i], gram_start[candidate], gram_end[candidate]) <
+                    sorted[candidate].length - 1 - 2 * k)
+                    continue;
+
+                verified++;
+                int distance = boundedLevenshtein(sorted[i].name, sorted[i].length, sorted[candidate].name, sorted[candidate].length, k);
+                if (distance >= 0 && distance <= k) {
+                    matched++;
+                    unionSets(parent, i, candidate);
+                }
+            }
+        }
+
+        free(touched_flag);
+        free(touched);
+    }
+
+    // Label every name with the first name (in input order) of its cluster
+    int n_clusters = 0;
+    if (!failed) {
+        for (int i = 0; i < n_names; i++)
+            cluster[i] = n_names;
+        for (int i = 0; i < n_names; i++) {
+            int root = findRoot(parent, i);
+            if (sorted[i].input < cluster[sorted[root].input])
+                cluster[sorted[root].input] = sorted[i].input;
+        }
+        for (int i = 0; i < n_names; i++) {
+            int root = findRoot(parent, i);
+            cluster[sorted[i].input] = cluster[sorted[root].input];
+        }
+        for (int i = 0; i < n_names; i++)
+            if (cluster[i] == i)
+                n_clusters++;
+    } else {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+    }
+
+    if (stats != NULL) {
+        stats->blocked_pairs = blocked;
+        stats->verified_pairs = verified;
+        stats->matched_pairs = matched;
+    }
+
+    // Free allocated memory
+    free(sorted);
+    free(last_in_window);
+    free(parent);
+    free(gram_start);
+    free(gram_end);
+    free(grams);
+    free(gram_count);
+    free(segments);
+
+    return failed ? -1 : n_clusters;
+}
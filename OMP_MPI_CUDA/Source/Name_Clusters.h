@@ -0,0 +1,59 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#ifndef NAME_CLUSTERS_H
+#define NAME_CLUSTERS_H
+
+/**
+ * @brief Work done by each stage of the clustering.
+ */
+typedef struct {
+    long long blocked_pairs;   /**< Pairs in the same length window and segment block. */
+    long long verified_pairs;  /**< Pairs that passed the q-gram count filter and were verified. */
+    long long matched_pairs;   /**< Verified pairs within the distance threshold. */
+} ClusterStatistics;
+
+/**
+ * @brief Groups the names that are within edit distance k of each other (transitively).
+ *
+ * The names are sorted by length, so each name is only compared with the longer names of the
+ * length buckets within k of its own. Inside that window the candidates come from blocks of
+ * names sharing a q-gram: every name is split in k + 1 segments, and a name at distance at most
+ * k from it must contain one of the segments, shifted by at most (k + length difference) / 2
+ * positions (pigeonhole principle). The candidates must also share max(len1, len2) - 1 - 2 * k q-grams of length 2,
+ * then they are verified in parallel by the OpenMP threads with the bounded edit distance
+ * kernel, and the matching pairs are merged in a lock-free union-find.
+ *
+ * @param names     The names (distinct).
+ * @param n_names   The number of names.
+ * @param k         The maximum edit distance between two names of the same cluster.
+ * @param n_threads The number of OpenMP threads.
+ * @param cluster   Output array: for each name, the index of the first name of its cluster.
+ * @param stats     Output statistics (can be NULL).
+ *
+ * @return          The number of clusters, -1 on allocation failure.
+ */
+int clusterNames(char** names, int n_names, int k, int n_threads, int* cluster, ClusterStatistics* stats);
+
+#endif
@@ -0,0 +1,218 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Pattern_Search.h"
+
+/**
+ * @brief Builds the bit masks of a pattern.
+ *
+ * @param pattern The pattern.
+ * @param length  The length of the pattern (at least 1).
+ * @param mask    The masks to fill.
+ *
+ * @return        0 on success, -1 if memory allocation fails.
+ */
+int compilePattern(const char* pattern, int length, PatternMask* mask) {
+    mask->length = length;
+    mask->n_blocks = (length + 63) / 64;
+    mask->peq = (uint64_t*)calloc(256 * (size_t)mask->n_blocks, sizeof(uint64_t));
+
+    // Check for memory allocation failure
+    if (mask->peq == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+
+    // One bit for each position of each character
+    for (int i = 0; i < length; i++)
+        mask->peq[(unsigned char)pattern[i] * mask->n_blocks + i / 64] |= (uint64_t)1 << (i % 64);
+
+    return 0;
+}
+
+/**
+ * @brief Releases the masks of a pattern.
+ */
+void freePattern(PatternMask* mask) {
+    free(mask->peq);
+    mask->peq = NULL;
+}
+
+/**
+ * @brief Advances a block of 64 cells of a DP column by one text character (Myers, Hyyrö).
+ *
+ * @param pv   Positive vertical differences of the block, updated.
+ * @param mv   Negative vertical differences of the block, updated.
+ * @param eq   Match mask of the text character for the block.
+ * @param hin  Horizontal difference entering the top of the block (-1, 0 or 1).
+ * @param high Bit of the last cell of the block.
+ *
+ * @return     Horizontal difference leaving the last cell of the block.
+ */
+static inline int advanceBlock(uint64_t* pv, uint64_t* mv, uint64_t eq, int hin, uint64_t high) {
+    uint64_t Pv = *pv;
+    uint64_t Mv = *mv;
+    uint64_t Xv = eq | Mv;
+    if (hin < 0)
+        eq |= 1;
+    uint64_t Xh = (((eq & Pv) + Pv) ^ Pv) | eq;
+    uint64_t Ph = Mv | ~(Xh | Pv);
+    uint64_t Mh = Pv & Xh;
+
+    int hout = (Ph & high) ? 1 : ((Mh & high) ? -1 : 0);
+
+    // Shift the horizontal differences down, bringing in the one from the block above
+    Ph <<= 1;
+    Mh <<= 1;
+    if (hin < 0)
+        Mh |= 1;
+    else if (hin > 0)
+        Ph |= 1;
+
+    *pv = Mh | ~(Xv | Ph);
+    *mv = Ph & Xv;
+
+    return hout;
+}
+
+/**
+ * @brief Finds the occurrences of the pattern with at most k errors ending in a range of the text.
+ *
+ * This is the semi-global alignment of the pattern against the text: the occurrence can start
+ * anywhere, so row 0 of the DP is all zeros, and every column whose last cell is at most k is
+ * an occurrence. The columns are advanced with the bit-parallel algorithm of Myers, 64 cells
+ * per word. The scan starts at scan_begin, before the range, so that the occurrences crossing
+ * its left end are found too: with scan_begin <= begin - (length + k) the costs in the range
+ * are exact.
+ *
+ * @param mask        The masks of the pattern.
+ * @param text        The text.
+ * @param scan_begin  First position scanned.
+ * @param begin       First position where an occurrence can end.
+ * @param end         End of the range (excluded).
+ * @param k           The maximum number of errors.
+ * @param matches     Array of the occurrences, grown with realloc (can be NULL at the start).
+ * @param n_matches   Number of occurrences in the array, increased by the function.
+ * @param capacity    Capacity of the array, updated by the function.
+ *
+ * @return            0 on success, -1 if memory allocation fails.
+ */
+int searchPattern(const PatternMask* mask, const char* text, long long scan_begin, long long begin, long long end, int k,
+                  PatternMatch** matches, int* n_matches, int* capacity) {
+    int n_blocks = mask->n_blocks;
+    uint64_t last_high = (uint64_t)1 << ((mask->length - 1) % 64);
+
+    // Vertical differences of the column: the first column is 0, 1, ..., length
+    uint64_t* pv = (uint64_t*)malloc(2 * n_blocks * sizeof(uint64_t));
+    if (pv == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+    uint64_t* mv = pv + n_blocks;
+    for (int b = 0; b < n_blocks; b++) {
+        pv[b] = ~(uint64_t)0;
+        mv[b] = 0;
+    }
+    int score = mask->length;
+
+    for (long long j = scan_begin; j < end; j++) {
+        const uint64_t* eq = mask->peq + (unsigned char)text[j] * n_blocks;
+
+        // Row 0 is all zeros, so no difference enters the first block
+        int carry = 0;
+        for (int b = 0; b < n_blocks - 1; b++)
+            carry = advanceBlock(&pv[b], &mv[b], eq[b], carry, (uint64_t)1 << 63);
+        score += advanceBlock(&pv[n_blocks - 1], &mv[n_blocks - 1], eq[n_blocks - 1], carry, last_high);
+
+        // Report the occurrences ending in the range
+        if (score <= k && j >= begin) {
+            if (*n_matches == *capacity) {
+                int new_capacity = (*capacity == 0) ? 1024 : 2 * *capacity;
+                PatternMatch* grown = (PatternMatch*)realloc(*matches, new_capacity * sizeof(PatternMatch));
+                if (grown == NULL) {
+                    fprintf(stderr, "ERROR in memory allocation.\n");
+                    free(pv);
+                    return -1;
+                }
+                *matches = grown;
+                *capacity = new_capacity;
+            }
+            (*matches)[*n_matches].position = j;
+            (*matches)[*n_matches].cost = score;
+            (*n_matches)++;
+        }
+    }
+
+    free(pv);
+
+    return 0;
+}
+
+/**
+ * @brief Levenshtein distance between the pattern and a whole text, with the bit-parallel kernel.
+ *
+ * This is the global alignment: row 0 of the DP is 0, 1, ..., n, so a horizontal difference of
+ * +1 enters the first block at every column, and the last cell of the last column is the distance.
+ *
+ * @param mask The masks of the pattern.
+ * @param text The text.
+ * @param n    The length of the text.
+ *
+ * @return     The Levenshtein distance, -1 if memory allocation fails.
+ */
+int levenshteinBitParallel(const PatternMask* mask, const char* text, int n) {
+    int n_blocks = mask->n_blocks;
+    uint64_t last_high = (uint64_t)1 << ((mask->length - 1) % 64);
+
+    // Vertical differences of the column: the first column is 0, 1, ..., length
+    uint64_t* pv = (uint64_t*)malloc(2 * n_blocks * sizeof(uint64_t));
+    if (pv == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+    uint64_t* mv = pv + n_blocks;
+    for (int b = 0; b < n_blocks; b++) {
+        pv[b] = ~(uint64_t)0;
+        mv[b] = 0;
+    }
+    int score = mask->length;
+
+    for (int j = 0; j < n; j++) {
+        const uint64_t* eq = mask->peq + (unsigned char)text[j] * n_blocks;
+
+        // Row 0 grows by one at each column
+        int carry = 1;
+        for (int b = 0; b < n_blocks - 1; b++)
+            carry = advanceBlock(&pv[b], &mv[b], eq[b], carry, (uint64_t)1 << 63);
+        score += advanceBlock(&pv[n_blocks - 1], &mv[n_blocks - 1], eq[n_blocks - 1], carry, last_high);
+    }
+
+    free(pv);
+
+    return score;
+}
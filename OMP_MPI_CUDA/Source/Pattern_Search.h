@@ -0,0 +1,106 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef PATTERN_SEARCH_H
+#define PATTERN_SEARCH_H
+
+#include <stdint.h>
+
+/**
+ * @brief An occurrence of the pattern in the text.
+ */
+typedef struct {
+    long long position;  /**< Position in the text of the last character of the occurrence. */
+    int cost;            /**< Edit distance between the pattern and the best occurrence ending there. */
+} PatternMatch;
+
+/**
+ * @brief The bit masks of a pattern for the bit-parallel kernel.
+ *
+ * The pattern is split in blocks of 64 characters; peq[c * n_blocks + b] has the bit i set
+ * if the character i of the block b is c.
+ */
+typedef struct {
+    int length;     /**< Length of the pattern. */
+    int n_blocks;   /**< Number of 64 bit blocks. */
+    uint64_t* peq;  /**< The masks, 256 * n_blocks words. */
+} PatternMask;
+
+/**
+ * @brief Builds the bit masks of a pattern.
+ *
+ * @param pattern The pattern.
+ * @param length  The length of the pattern (at least 1).
+ * @param mask    The masks to fill.
+ *
+ * @return        0 on success, -1 if memory allocation fails.
+ */
+int compilePattern(const char* pattern, int length, PatternMask* mask);
+
+/**
+ * @brief Releases the masks of a pattern.
+ */
+void freePattern(PatternMask* mask);
+
+/**
+ * @brief Finds the occurrences of the pattern with at most k errors ending in a range of the text.
+ *
+ * This is the semi-global alignment of the pattern against the text: the occurrence can start
+ * anywhere, so row 0 of the DP is all zeros, and every column whose last cell is at most k is
+ * an occurrence. The columns are advanced with the bit-parallel algorithm of Myers, 64 cells
+ * per word. The scan starts at scan_begin, before the range, so that the occurrences crossing
+ * its left end are found too: with scan_begin <= begin - (length + k) the costs in the range
+ * are exact.
+ *
+ * @param mask        The masks of the pattern.
+ * @param text        The text.
+ * @param scan_begin  First position scanned.
+ * @param begin       First position where an occurrence can end.
+ * @param end         End of the range (excluded).
+ * @param k           The maximum number of errors.
+ * @param matches     Array of the occurrences, grown with realloc (can be NULL at the start).
+ * @param n_matches   Number of occurrences in the array, increased by the function.
+ * @param capacity    Capacity of the array, updated by the function.
+ *
+ * @return            0 on success, -1 if memory allocation fails.
+ */
+int searchPattern(const PatternMask* mask, const char* text, long long scan_begin, long long begin, long long end, int k,
+                  PatternMatch** matches, int* n_matches, int* capacity);
+
+/**
+ * @brief Levenshtein distance between the pattern and a whole text, with the bit-parallel kernel.
+ *
+ * This is the global alignment: row 0 of the DP is 0, 1, ..., n, so a horizontal difference of
+ * +1 enters the first block at every column, and the last cell of the last column is the distance.
+ *
+ * @param mask The masks of the pattern.
+ * @param text The text.
+ * @param n    The length of the text.
+ *
+ * @return     The Levenshtein distance, -1 if memory allocation fails.
+ */
+int levenshteinBitParallel(const PatternMask* mask, const char* text, int n);
+
+#endif
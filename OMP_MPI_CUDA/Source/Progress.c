@@ -0,0 +1,118 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include "Progress.h"
+
+ProgressCounters* progress_counters = NULL;
+int progress_slots = 0;
+_Thread_local int progress_slot = -1;
+
+// The whole segment and its name
+static ProgressHeader* progress_header = NULL;
+static size_t progress_size = 0;
+static char progress_name[64];
+static _Atomic int progress_next_slot = 0;
+
+/**
+ * @brief Creates the progress segment of this process.
+ *
+ * Without the segment (e.g. /dev/shm is not available) the counters are not updated.
+ *
+ * @param n_threads   The number of threads with their own counters (the others share the last ones).
+ * @param rank        The MPI rank of the process.
+ * @param total_cells The expected number of DP cells of the process.
+ *
+ * @return            0 on success, -1 if the segment cannot be created.
+ */
+int progressOpen(int n_threads, int rank, long long total_cells) {
+    if (n_threads < 1)
+        n_threads = 1;
+
+    snprintf(progress_name, sizeof(progress_name), "/" PROGRESS_PREFIX "%d", (int)getpid());
+    progress_size = sizeof(ProgressHeader) + n_threads * sizeof(ProgressCounters);
+
+    int fd = shm_open(progress_name, O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+    if (ftruncate(fd, progress_size) != 0) {
+        close(fd);
+        shm_unlink(progress_name);
+        return -1;
+    }
+
+    void* segment = mmap(NULL, progress_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (segment == MAP_FAILED) {
+        shm_unlink(progress_name);
+        return -1;
+    }
+
+    // Fill the header (the counters are zero, as the segment is new)
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    progress_header = (ProgressHeader*)segment;
+    progress_header->n_threads = n_threads;
+    progress_header->pid = (int)getpid();
+    progress_header->rank = rank;
+    progress_header->total_cells = total_cells;
+    progress_header->start_time = now.tv_sec + now.tv_usec / 1e6;
+    atomic_store(&progress_header->finished, 0);
+    atomic_thread_fence(memory_order_release);
+    progress_header->magic = PROGRESS_MAGIC;
+
+    progress_slots = n_threads;
+    progress_counters = (ProgressCounters*)(progress_header + 1);
+
+    return 0;
+}
+
+/**
+ * @brief Marks the run as finished and removes the progress segment.
+ */
+void progressClose(void) {
+    if (progress_header == NULL)
+        return;
+
+    atomic_store(&progress_header->finished, 1);
+    progress_counters = NULL;
+    munmap(progress_header, progress_size);
+    shm_unlink(progress_name);
+    progress_header = NULL;
+}
+
+/**
+ * @brief Assigns the counters of the calling thread, on its first update.
+ */
+int progressAssignSlot(void) {
+    int slot = atomic_fetch_add(&progress_next_slot, 1);
+    return (slot < progress_slots) ? slot : progress_slots - 1;
+}
@@ -0,0 +1,107 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+#include <stdatomic.h>
+
+//Identifier of a progress segment
+#define PROGRESS_MAGIC 0x45445052
+//Prefix of the name of the progress segments in /dev/shm, followed by the process id
+#define PROGRESS_PREFIX "edit_distance."
+
+/*
+ * Each process of a run publishes its progress in a small shared-memory segment,
+ * /dev/shm/edit_distance.<pid>, that Edit_Distance_Stat (edstat) can map while the run is
+ * going on. The threads only add to their own counters with relaxed atomic increments, once
+ * for each row, block or strip of the DP, so the counters can be left on.
+ */
+
+/**
+ * @brief The header of a progress segment.
+ */
+typedef struct {
+    int magic;               /**< PROGRESS_MAGIC. */
+    int n_threads;           /**< Number of counters after the header. */
+    int pid;                 /**< Process id of the run. */
+    int rank;                /**< MPI rank of the process. */
+    long long total_cells;   /**< Expected number of DP cells of the process. */
+    double start_time;       /**< Start of the run, in seconds since the epoch. */
+    _Atomic int finished;    /**< Set when the run is done. */
+    char padding[28];
+} ProgressHeader;
+
+/**
+ * @brief The counters of a thread, on their own cache line.
+ */
+typedef struct {
+    _Atomic long long cells;   /**< DP cells computed by the thread. */
+    _Atomic long long units;   /**< Work units (sections, blocks) finished by the thread. */
+    char padding[48];
+} ProgressCounters;
+
+// Counters of the segment of this process (NULL if there is none) and slot of the thread
+extern ProgressCounters* progress_counters;
+extern int progress_slots;
+extern _Thread_local int progress_slot;
+
+/**
+ * @brief Creates the progress segment of this process.
+ *
+ * Without the segment (e.g. /dev/shm is not available) the counters are not updated.
+ *
+ * @param n_threads   The number of threads with their own counters (the others share the last ones).
+ * @param rank        The MPI rank of the process.
+ * @param total_cells The expected number of DP cells of the process.
+ *
+ * @return            0 on success, -1 if the segment cannot be created.
+ */
+int progressOpen(int n_threads, int rank, long long total_cells);
+
+/**
+ * @brief Marks the run as finished and removes the progress segment.
+ */
+void progressClose(void);
+
+/**
+ * @brief Assigns the counters of the calling thread, on its first update.
+ */
+int progressAssignSlot(void);
+
+/**
+ * @brief Adds computed cells and finished units to the counters of the calling thread.
+ */
+static inline void progressAdd(long long cells, long long units) {
+    if (progress_counters == NULL)
+        return;
+    if (progress_slot < 0)
+        progress_slot = progressAssignSlot();
+    atomic_fetch_add_explicit(&progress_counters[progress_slot].cells, cells, memory_order_relaxed);
+    if (units != 0)
+        atomic_fetch_add_explicit(&progress_counters[progress_slot].units, units, memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "Qgram_Sketch.h"
+//Seed of the hash functions of the sketches (the sketches of different runs can be compared)
+#define SKETCH_SEED 0x9e3779b97f4a7c15ull
+
+/**
+ * @brief Next value of a splitmix64 generator.
+ */
+static uint64_t splitMix(uint64_t* state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Hash of the q-gram starting at a position (murmur3 finalizer of its characters).
+ */
+static inline uint32_t qgramHash(const char* str, int pos) {
+    uint32_t h = 0;
+    for (int q = 0; q < SKETCH_QGRAM; q++)
+        h = h * 0x01000193u ^ (unsigned char)str[pos + q];
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    return h ^ (h >> 16);
+}
+
+/**
+ * @brief Comparison function for qsort on 32-bit hashes.
+ */
+static int compareHashes(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Computes the sketch of a string.
+ *
+ * @param str         The string.
+ * @param len         The length of the string.
+ * @param multipliers The odd multipliers of the hash functions.
+ * @param keys        The keys of the hash functions.
+ * @param hashes      Scratch array of at least len hashes.
+ * @param sketch      Output parameter: the SKETCH_SIZE minima.
+ *
+ * @return            The number of distinct q-grams of the string.
+ */
+static int sketchString(const char* str, int len, const uint32_t* multipliers, const uint32_t* keys, uint32_t* hashes, uint32_t* restrict sketch) {
+    for (int i = 0; i < SKETCH_SIZE; i++)
+        sketch[i] = UINT32_MAX;
+
+    // Hash the q-grams and keep the distinct ones
+    int n_hashes = 0;
+    for (int pos = 0; pos + SKETCH_QGRAM <= len; pos++)
+        hashes[n_hashes++] = qgramHash(str, pos);
+    qsort(hashes, n_hashes, sizeof(uint32_t), compareHashes);
+
+    int distinct = 0;
+    for (int h = 0; h < n_hashes; h++) {
+        if (h > 0 && hashes[h] == hashes[h - 1])
+            continue;
+        distinct++;
+
+        // Apply every hash function to the q-gram, one 32-bit lane each
+        uint32_t x = hashes[h];
+        for (int i = 0; i < SKETCH_SIZE; i++) {
+            uint32_t value = (x ^ keys[i]) * multipliers[i];
+            value ^= value >> 15;
+            sketch[i] = (value < sketch[i]) ? value : sketch[i];
+        }
+    }
+
+    return distinct;
+}
+
+/**
+ * @brief Computes the sketches of a set of strings, in parallel with the OpenMP threads.
+ *
+ * The distinct q-grams of each string are hashed once, and the SKETCH_SIZE hash functions are
+ * applied to each of them in a loop over 32-bit lanes that the compiler vectorizes.
+ *
+ * @param strings   The strings.
+ * @param n_strings The number of strings.
+ * @param set       Output parameter: the sketches, to be released with freeSketches().
+ *
+ * @return          0 on success, -1 if memory allocation fails.
+ */
+int buildSketches(char** strings, int n_strings, SketchSet* set) {
+    set->n_strings = n_strings;
+    set->minima = (uint32_t*)aligned_alloc(64, ((size_t)n_strings + 1) * SKETCH_SIZE * sizeof(uint32_t));
+    set->qgrams = (int*)malloc((n_strings + 1) * sizeof(int));
+    set->lengths = (int*)malloc((n_strings + 1) * sizeof(int));
+    if (set->minima == NULL || set->qgrams == NULL || set->lengths == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        freeSketches(set);
+        return -1;
+    }
+
+    // The same hash functions for every set, so the sketches of two sets can be compared
+    uint32_t multipliers[SKETCH_SIZE], keys[SKETCH_SIZE];
+    uint64_t state = SKETCH_SEED;
+    for (int i = 0; i < SKETCH_SIZE; i++) {
+        uint64_t random = splitMix(&state);
+        multipliers[i] = (uint32_t)random | 1u;
+        keys[i] = (uint32_t)(random >> 32);
+    }
+
+    int max_length = 0;
+    for (int s = 0; s < n_strings; s++) {
+        set->lengths[s] = strlen(strings[s]);
+        if (set->lengths[s] > max_length)
+            max_length = set->lengths[s];
+    }
+
+    int failed = 0;
+    #pragma omp parallel
+    {
+        // Thread-local scratch array of the q-gram hashes
+        uint32_t* hashes = (uint32_t*)malloc((max_length + 1) * sizeof(uint32_t));
+        if (hashes == NULL) {
+            #pragma omp atomic write
+            failed = 1;
+        } else {
+            #pragma omp for schedule(dynamic, 64)
+            for (int s = 0; s < n_strings; s++)
+                set->qgrams[s] = sketchString(strings[s], set->lengths[s], multipliers, keys, hashes, &set->minima[(size_t)s * SKETCH_SIZE]);
+        }
+        free(hashes);
+    }
+
+    if (failed) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        freeSketches(set);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Releases the sketches created by buildSketches().
+ */
+void freeSketches(SketchSet* set) {
+    free(set->minima);
+    free(set->qgrams);
+    free(set->lengths);
+    set->minima = NULL;
+    set->qgrams = NULL;
+    set->lengths = NULL;
+}
+
+/**
+ * @brief Counts the equal minima of two sketches.
+ */
+int sketchMatches(const uint32_t* sketch1, const uint32_t* sketch2) {
+    int matches = 0;
+    for (int i = 0; i < SKETCH_SIZE; i++)
+        matches += (sketch1[i] == sketch2[i]);
+    return matches;
+}
+
+/**
+ * @brief Edit distance estimated from the Jaccard similarity of the q-gram sets.
+ *
+ * The shared q-grams are J * (n1 + n2) / (1 + J), and each edit removes at most SKETCH_QGRAM of
+ * the max(n1, n2) q-grams of the larger set; the length difference is also a lower bound.
+ */
+static double jaccardDistance(double jaccard, int qgrams1, int qgrams2, int length_difference) {
+    double shared = jaccard * (qgrams1 + qgrams2) / (1 + jaccard);
+    double largest = (qgrams1 > qgrams2) ? qgrams1 : qgrams2;
+    double distance = (largest - shared) / SKETCH_QGRAM;
+    return (distance > length_difference) ? distance : length_difference;
+}
+
+/**
+ * @brief Estimates the edit distance between a string of a set and a string of another set.
+ *
+ * @param set1     The sketches of the first set.
+ * @param i        The index of the string in the first set.
+ * @param set2     The sketches of the second set.
+ * @param j        The index of the string in the second set.
+ * @param estimate Output parameter: the estimate and its bounds.
+ */
+void sketchEstimate(const SketchSet* set1, int i, const SketchSet* set2, int j, SketchEstimate* estimate) {
+    int qgrams1 = set1->qgrams[i], qgrams2 = set2->qgrams[j];
+    int length_difference = abs(set1->lengths[i] - set2->lengths[j]);
+
+    // Strings without q-grams: only the length difference is known
+    if (qgrams1 == 0 || qgrams2 == 0) {
+        int longest = (set1->lengths[i] > set2->lengths[j]) ? set1->lengths[i] : set2->lengths[j];
+        estimate->matches = 0;
+        estimate->jaccard = estimate->jaccard_low = estimate->jaccard_high = (qgrams1 == qgrams2);
+        estimate->distance = estimate->distance_low = length_difference;
+        estimate->distance_high = longest;
+        return;
+    }
+
+    estimate->matches = sketchMatches(&set1->minima[(size_t)i * SKETCH_SIZE], &set2->minima[(size_t)j * SKETCH_SIZE]);
+
+    // Wilson score interval of the binomial proportion of equal minima
+    double n = SKETCH_SIZE;
+    double p = estimate->matches / n;
+    double z2 = SKETCH_Z * SKETCH_Z;
+    double center = (p + z2 / (2 * n)) / (1 + z2 / n);
+    double half = SKETCH_Z / (1 + z2 / n) * sqrt(p * (1 - p) / n + z2 / (4 * n * n));
+    estimate->jaccard = p;
+    estimate->jaccard_low = fmax(0.0, center - half);
+    estimate->jaccard_high = fmin(1.0, center + half);
+
+    estimate->distance = jaccardDistance(estimate->jaccard, qgrams1, qgrams2, length_difference);
+    estimate->distance_low = jaccardDistance(estimate->jaccard_high, qgrams1, qgrams2, length_difference);
+    estimate->distance_high = jaccardDistance(estimate->jaccard_low, qgrams1, qgrams2, length_difference);
+}
@@ -0,0 +1,108 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef QGRAM_SKETCH_H
+#define QGRAM_SKETCH_H
+
+#include <stdint.h>
+
+//Length of the q-grams of the sketches
+#define SKETCH_QGRAM 3
+//Number of hash functions of a sketch (one minimum value each)
+#define SKETCH_SIZE 64
+//Standard normal quantile of the one-sided confidence of the bounds (2.326 for 99%)
+#define SKETCH_Z 2.326
+
+/*
+ * MinHash sketches of the q-gram sets of the strings. For each of SKETCH_SIZE hash functions a
+ * sketch keeps the minimum hash of the distinct q-grams of a string; two strings have the same
+ * minimum with probability equal to the Jaccard similarity J of their q-gram sets, so the number
+ * of equal minima of two sketches is Binomial(SKETCH_SIZE, J) and estimates J in O(SKETCH_SIZE)
+ * time, whatever the lengths of the strings. An edit operation removes at most SKETCH_QGRAM
+ * q-grams from a set, so two strings at distance d share at least max(n1, n2) - SKETCH_QGRAM * d
+ * of their n1 and n2 distinct q-grams: the shared q-grams estimated from J give an estimate of
+ * the distance, and the upper bound of J gives a lower bound of the distance that holds with the
+ * confidence of SKETCH_Z, used to discard the pairs before the exact kernels.
+ */
+
+/**
+ * @brief The sketches of a set of strings, stored contiguously (SKETCH_SIZE minima per string).
+ */
+typedef struct {
+    uint32_t* minima;  /**< SKETCH_SIZE minima for each string, aligned to 64 bytes. */
+    int* qgrams;       /**< Number of distinct q-grams of each string. */
+    int* lengths;      /**< Length of each string. */
+    int n_strings;     /**< Number of strings. */
+} SketchSet;
+
+/**
+ * @brief Estimate of the distance between two strings obtained from their sketches.
+ */
+typedef struct {
+    int matches;          /**< Equal minima of the two sketches. */
+    double jaccard;       /**< Estimated Jaccard similarity of the q-gram sets. */
+    double jaccard_low;   /**< Lower bound of the Jaccard similarity (Wilson score interval). */
+    double jaccard_high;  /**< Upper bound of the Jaccard similarity (Wilson score interval). */
+    double distance;      /**< Estimated edit distance. */
+    double distance_low;  /**< Lower bound of the edit distance, with the confidence of SKETCH_Z. */
+    double distance_high; /**< Estimated edit distance from the lower bound of the Jaccard similarity. */
+} SketchEstimate;
+
+/**
+ * @brief Computes the sketches of a set of strings, in parallel with the OpenMP threads.
+ *
+ * The distinct q-grams of each string are hashed once, and the SKETCH_SIZE hash functions are
+ * applied to each of them in a loop over 32-bit lanes that the compiler vectorizes.
+ *
+ * @param strings   The strings.
+ * @param n_strings The number of strings.
+ * @param set       Output parameter: the sketches, to be released with freeSketches().
+ *
+ * @return          0 on success, -1 if memory allocation fails.
+ */
+int buildSketches(char** strings, int n_strings, SketchSet* set);
+
+/**
+ * @brief Releases the sketches created by buildSketches().
+ */
+void freeSketches(SketchSet* set);
+
+/**
+ * @brief Counts the equal minima of two sketches.
+ */
+int sketchMatches(const uint32_t* sketch1, const uint32_t* sketch2);
+
+/**
+ * @brief Estimates the edit distance between a string of a set and a string of another set.
+ *
+ * @param set1     The sketches of the first set.
+ * @param i        The index of the string in the first set.
+ * @param set2     The sketches of the second set.
+ * @param j        The index of the string in the second set.
+ * @param estimate Output parameter: the estimate and its bounds.
+ */
+void sketchEstimate(const SketchSet* set1, int i, const SketchSet* set2, int j, SketchEstimate* estimate);
+
+#endif
@@ -24,8 +24,38 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
+// Define the character alphabet for generating random strings
+static const char alphabet[] = "abcde fghijklmn opqrst uvwxyz";
+
+/**
+ * @brief Fills a buffer with a random string of specified length using the given seed.
+ *
+ * The string is the same returned by generateRandomString() with the same length and seed,
+ * so it can be generated directly in memory that is not owned by the caller (e.g. an MPI
+ * shared-memory window).
+ *
+ * @param buffer       The buffer to fill, of at least n_characters + 1 characters.
+ * @param n_characters The desired length of the generated string.
+ * @param seed         The seed value for the random number generator.
+ */
+void fillRandomString(char* buffer, int n_characters, int seed) {
+    // Calculate the size of the alphabet (excluding the null terminator)
+    int alphabetSize = sizeof(alphabet) - 1;
+
+    // Seed the random number generator
+    srand(seed);
+
+    // Generate random characters based on the alphabet and fill the string
+    for (int i = 0; i < n_characters; ++i)
+        buffer[i] = alphabet[rand() % alphabetSize];
+
+    // Add the null terminator at the end of the generated string
+    buffer[n_characters] = '\0';
+}
+
 /**
  * @brief Generates a random string of specified length using the given seed.
  *
@@ -39,12 +69,6 @@
  *                     Returns NULL in case of memory allocation failure.
  */
 char* generateRandomString(int n_characters, int seed) {
-    // Define the character alphabet for generating random strings
-    static const char alphabet[] = "abcde fghijklmn opqrst uvwxyz";
-    
-    // Calculate the size of the alphabet (excluding the null terminator)
-    int alphabetSize = sizeof(alphabet) - 1;
-
     // Allocate memory for the generated string, including space for the null terminator
     char* generatedString = (char*)malloc((n_characters + 1) * sizeof(char));
 
@@ -54,16 +78,66 @@ char* generateRandomString(int n_characters, int seed) {
         exit(EXIT_FAILURE);
     }
 
+    // Fill the string
+    fillRandomString(generatedString, n_characters, seed);
+
+    // Return the generated random string
+    return generatedString;
+}
+
+/**
+ * @brief Generates a near-duplicate of a string with random edits.
+ *
+ * Each edit is a substitution, an insertion or a deletion (with the same probability) at a
+ * random position, with the characters of the alphabet of generateRandomString(), so the
+ * distance between the two strings is at most n_edits.
+ *
+ * @param str          The original string.
+ * @param n_characters The length of the original string.
+ * @param n_edits      The number of random edits.
+ * @param seed         The seed value for the random number generator.
+ * @param length       Output parameter: the length of the new string.
+ *
+ * @return             A dynamically allocated string, to be freed by the caller.
+ */
+char* mutateString(const char* str, int n_characters, int n_edits, int seed, int* length) {
+    int alphabetSize = sizeof(alphabet) - 1;
+
+    // Allocate memory for the longest result (one insertion for each edit)
+    char* mutated = (char*)malloc((n_characters + n_edits + 1) * sizeof(char));
+    if (mutated == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(mutated, str, n_characters);
+    int n = n_characters;
+
     // Seed the random number generator
     srand(seed);
 
-    // Generate random characters based on the alphabet and fill the string
-    for (int i = 0; i < n_characters; ++i)
-        generatedString[i] = alphabet[rand() % alphabetSize];
+    for (int e = 0; e < n_edits; e++) {
+        int operation = rand() % 3;
+        if (n == 0)
+            operation = 1;
+        if (operation == 0) {
+            // Substitution
+            mutated[rand() % n] = alphabet[rand() % alphabetSize];
+        } else if (operation == 1) {
+            // Insertion
+            int position = rand() % (n + 1);
+            memmove(mutated + position + 1, mutated + position, n - position);
+            mutated[position] = alphabet[rand() % alphabetSize];
+            n++;
+        } else {
+            // Deletion
+            int position = rand() % n;
+            memmove(mutated + position, mutated + position + 1, n - position - 1);
+            n--;
+        }
+    }
 
-    // Add the null terminator at the end of the generated string
-    generatedString[n_characters] = '\0';
+    mutated[n] = '\0';
+    *length = n;
 
-    // Return the generated random string
-    return generatedString;
-}
\ No newline at end of file
+    return mutated;
+}
@@ -34,4 +34,34 @@
  *                     the generated string.
  *                     Returns NULL in case of memory allocation failure.
  */
-char* generateRandomString(int n_characters, int seed);
\ No newline at end of file
+char* generateRandomString(int n_characters, int seed);
+
+/**
+ * @brief Fills a buffer with a random string of specified length using the given seed.
+ *
+ * The string is the same returned by generateRandomString() with the same length and seed,
+ * so it can be generated directly in memory that is not owned by the caller (e.g. an MPI
+ * shared-memory window).
+ *
+ * @param buffer       The buffer to fill, of at least n_characters + 1 characters.
+ * @param n_characters The desired length of the generated string.
+ * @param seed         The seed value for the random number generator.
+ */
+void fillRandomString(char* buffer, int n_characters, int seed);
+
+/**
+ * @brief Generates a near-duplicate of a string with random edits.
+ *
+ * Each edit is a substitution, an insertion or a deletion (with the same probability) at a
+ * random position, with the characters of the alphabet of generateRandomString(), so the
+ * distance between the two strings is at most n_edits.
+ *
+ * @param str          The original string.
+ * @param n_characters The length of the original string.
+ * @param n_edits      The number of random edits.
+ * @param seed         The seed value for the random number generator.
+ * @param length       Output parameter: the length of the new string.
+ *
+ * @return             A dynamically allocated string, to be freed by the caller.
+ */
+char* mutateString(const char* str, int n_characters, int n_edits, int seed, int* length);
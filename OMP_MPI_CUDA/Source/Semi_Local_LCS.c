@@ -0,0 +1,299 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Semi_Local_LCS.h"
+#include "Progress.h"
+
+/**
+ * @brief Seaweed permutation of the comparison between a block of the first string and the second string.
+ *
+ * The edit distance is reduced to the longest common subsequence of the blown-up strings, where
+ * each character c becomes "$c" ('$' only matches '$'): a mismatch then counts half a match, so
+ * editDistance(a, b) = m + n - LCS(blown a, blown b). The seaweeds of the blown-up grid are
+ * combed row by row, in O(m + n) memory. The seaweeds start on the left edge (bottom to top)
+ * and on the top edge (left to right), and end on the bottom edge (left to right) and on the
+ * right edge (bottom to top).
+ *
+ * @param a The block of the first string.
+ * @param m The length of the block.
+ * @param b The second string.
+ * @param n The length of the second string.
+ *
+ * @return  A dynamically allocated permutation of 2 * (m + n) elements (start -> end), NULL if
+ *          memory allocation fails. It is the responsibility of the caller to free it using free().
+ */
+int* seaweedPermutation(const char* a, int m, const char* b, int n) {
+    int rows = 2 * m, columns = 2 * n;
+    int* vertical = (int*)malloc((columns + 1) * sizeof(int));
+    int* permutation = (int*)malloc((rows + columns + 1) * sizeof(int));
+    if (vertical == NULL || permutation == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(vertical);
+        free(permutation);
+        return NULL;
+    }
+
+    // The seaweeds of the top edge
+    for (int c = 0; c < columns; c++)
+        vertical[c] = rows + c;
+
+    for (int r = 0; r < rows; r++) {
+        // The seaweed of the left edge of this row
+        int horizontal = rows - 1 - r;
+
+        // Two seaweeds meeting in a cell swap (do not cross) on a match, or if they crossed already
+        if (r % 2 == 0) {
+            // '$' row: it matches the '$' columns
+            for (int c = 0; c < columns; c += 2) {
+                int swap = vertical[c];
+                vertical[c] = horizontal;
+                horizontal = swap;
+
+                int v = vertical[c + 1];
+                int cross = horizontal < v;
+                vertical[c + 1] = cross ? v : horizontal;
+                horizontal = cross ? horizontal : v;
+            }
+        } else {
+            char x = a[r / 2];
+            for (int c = 0; c < columns; c += 2) {
+                int v = vertical[c];
+                int cross = horizontal < v;
+                vertical[c] = cross ? v : horizontal;
+                horizontal = cross ? horizontal : v;
+
+                v = vertical[c + 1];
+                cross = horizontal < v && x != b[c / 2];
+                vertical[c + 1] = cross ? v : horizontal;
+                horizontal = cross ? horizontal : v;
+            }
+
+            // A character of the block compared with the whole second string
+            progressAdd(n, 0);
+        }
+
+        permutation[horizontal] = columns + rows - 1 - r;
+    }
+
+    for (int c = 0; c < columns; c++)
+        permutation[vertical[c]] = c;
+
+    free(vertical);
+    return permutation;
+}
+
+/**
+ * @brief Steady ant recursion: PC = PA (sticky product) PB, all of size N.
+ *
+ * The inner index is split in half: the points of PA in the low columns with the points of PB
+ * in the low rows give a low subproblem, the others a high subproblem. The two results are
+ * merged by walking the boundary between the regions where each one gives the minimum.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int steadyAnt(const int* PA, const int* PB, int N, int* PC) {
+    if (N == 1) {
+        PC[0] = 0;
+        return 0;
+    }
+
+    int h = N / 2;
+    int* work = (int*)malloc((size_t)12 * (N + 1) * sizeof(int));
+    if (work == NULL)
+        return -1;
+
+    int* inverse_b = work;            // row of PB for each column
+    int* low_rows = inverse_b + N;    // rows of PA in the low subproblem
+    int* high_rows = low_rows + h;    // rows of PA in the high subproblem
+    int* sub_a = high_rows + (N - h); // PA restricted to each subproblem (low then high)
+    int* columns = sub_a + N;         // columns of PB in each subproblem (low then high)
+    int* sub_b = columns + N;         // PB restricted to each subproblem (low then high)
+    int* sub_c = sub_b + N;           // results of the subproblems (low then high)
+    int* rank = sub_c + N;            // rank of each column of PB within its subproblem
+    int* row_column = rank + N;       // merged points: column of each row
+    int* column_row = row_column + N; // merged points: row of each column
+    int* high = column_row + N;       // 1 if the point of the row comes from the high subproblem
+    int* K = high + N;                // first column where the high subproblem gives the minimum
+
+    // Split PA by column
+    int n_low = 0, n_high = 0;
+    for (int i = 0; i < N; i++) {
+        if (PA[i] < h) {
+            low_rows[n_low] = i;
+            sub_a[n_low++] = PA[i];
+        } else {
+            high_rows[n_high] = i;
+            sub_a[h + n_high++] = PA[i] - h;
+        }
+    }
+
+    // Split PB by row, compressing its columns
+    for (int j = 0; j < N; j++)
+        inverse_b[PB[j]] = j;
+    n_low = 0;
+    n_high = 0;
+    for (int c = 0; c < N; c++) {
+        if (inverse_b[c] < h) {
+            columns[n_low] = c;
+            rank[c] = n_low++;
+        } else {
+            columns[h + n_high] = c;
+            rank[c] = n_high++;
+        }
+    }
+    for (int j = 0; j < N; j++)
+        sub_b[j] = rank[PB[j]];
+
+    if (steadyAnt(sub_a, sub_b, h, sub_c) != 0 || steadyAnt(sub_a + h, sub_b + h, N - h, sub_c + h) != 0) {
+        free(work);
+        return -1;
+    }
+
+    // Merge the points of the two subproblems (together they are a permutation)
+    for (int t = 0; t < h; t++) {
+        row_column[low_rows[t]] = columns[sub_c[t]];
+        high[low_rows[t]] = 0;
+    }
+    for (int t = 0; t < N - h; t++) {
+        row_column[high_rows[t]] = columns[h + sub_c[h + t]];
+        high[high_rows[t]] = 1;
+    }
+    for (int i = 0; i < N; i++)
+        column_row[row_column[i]] = i;
+
+    // The ant walks from the bottom-left corner to the top-right one, following
+    // delta(i, k) = #low points (row >= i, column >= k) - #high points (row < i, column < k)
+    long long delta = 0;
+    int k = 0;
+    for (int i = N; i >= 0; i--) {
+        if (i < N) {
+            if (!high[i] && row_column[i] >= k)
+                delta++;
+            if (high[i] && row_column[i] < k)
+                delta++;
+        }
+        while (k <= N && delta >= 0) {
+            if (k == N) {
+                k = N + 1;
+                break;
+            }
+            int r = column_row[k];
+            if (!high[r] && r >= i)
+                delta--;
+            if (high[r] && r < i)
+                delta--;
+            k++;
+        }
+        K[i] = k;
+    }
+
+    // Points of the low subproblem before the boundary, of the high one after it, moved on the boundary
+    for (int r = 0; r < N; r++) {
+        if (!high[r])
+            PC[r] = (row_column[r] < K[r + 1] - 1) ? row_column[r] : K[r + 1] - 1;
+        else if (K[r + 1] < K[r])
+            PC[r] = K[r + 1] - 1;
+        else
+            PC[r] = (row_column[r] > K[r] - 1) ? row_column[r] : K[r] - 1;
+    }
+
+    free(work);
+    return 0;
+}
+
+/**
+ * @brief Sticky (min-plus) product of two seaweed permutations, computed with the steady ant algorithm.
+ *
+ * The result is the permutation of the grid made by the grid of PA followed by the grid of PB,
+ * so the product of the blocks of the first string, from the first block to the last one, is
+ * the permutation of the whole comparison. It takes O(N log N) time.
+ *
+ * @param PA The first permutation.
+ * @param PB The second permutation.
+ * @param N  The size of the permutations.
+ *
+ * @return   A dynamically allocated permutation of N elements, NULL if memory allocation fails.
+ *           It is the responsibility of the caller to free it using free().
+ */
+int* stickyProduct(const int* PA, const int* PB, int N) {
+    int* PC = (int*)malloc((N + 1) * sizeof(int));
+    if (PC == NULL || (N > 0 && steadyAnt(PA, PB, N, PC) != 0)) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(PC);
+        return NULL;
+    }
+    return PC;
+}
+
+/**
+ * @brief Extends the permutation of a block to a grid with more rows, above and below the block.
+ *
+ * @param P     The permutation of the block.
+ * @param size  The size of the permutation of the block.
+ * @param below The number of blown-up rows after the block (2 characters per character).
+ * @param total The size of the extended permutation.
+ *
+ * @return      A dynamically allocated permutation of total elements, NULL if memory allocation
+ *              fails. It is the responsibility of the caller to free it using free().
+ */
+int* padPermutation(const int* P, int size, int below, int total) {
+    int* padded = (int*)malloc((total + 1) * sizeof(int));
+    if (padded == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return NULL;
+    }
+
+    // The seaweeds of the rows below and above the block go straight through it
+    for (int i = 0; i < total; i++)
+        padded[i] = i;
+    for (int i = 0; i < size; i++)
+        padded[below + i] = below + P[i];
+
+    return padded;
+}
+
+/**
+ * @brief Edit distance of the whole comparison, from its seaweed permutation.
+ *
+ * @param P The permutation of the comparison of the first string with the second one.
+ * @param m The length of the first string.
+ * @param n The length of the second string.
+ *
+ * @return  The edit distance between the two strings.
+ */
+int permutationDistance(const int* P, int m, int n) {
+    int rows = 2 * m, columns = 2 * n;
+
+    // Every seaweed from the top edge to the bottom edge is a column without a match
+    int straight = 0;
+    for (int c = 0; c < columns; c++)
+        if (P[rows + c] < columns)
+            straight++;
+
+    int lcs = columns - straight;
+    return m + n - lcs;
+}
@@ -0,0 +1,88 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#ifndef SEMI_LOCAL_LCS_H
+#define SEMI_LOCAL_LCS_H
+
+/**
+ * @brief Seaweed permutation of the comparison between a block of the first string and the second string.
+ *
+ * The edit distance is reduced to the longest common subsequence of the blown-up strings, where
+ * each character c becomes "$c" ('$' only matches '$'): a mismatch then counts half a match, so
+ * editDistance(a, b) = m + n - LCS(blown a, blown b). The seaweeds of the blown-up grid are
+ * combed row by row, in O(m + n) memory. The seaweeds start on the left edge (bottom to top)
+ * and on the top edge (left to right), and end on the bottom edge (left to right) and on the
+ * right edge (bottom to top).
+ *
+ * @param a The block of the first string.
+ * @param m The length of the block.
+ * @param b The second string.
+ * @param n The length of the second string.
+ *
+ * @return  A dynamically allocated permutation of 2 * (m + n) elements (start -> end), NULL if
+ *          memory allocation fails. It is the responsibility of the caller to free it using free().
+ */
+int* seaweedPermutation(const char* a, int m, const char* b, int n);
+
+/**
+ * @brief Sticky (min-plus) product of two seaweed permutations, computed with the steady ant algorithm.
+ *
+ * The result is the permutation of the grid made by the grid of PA followed by the grid of PB,
+ * so the product of the blocks of the first string, from the first block to the last one, is
+ * the permutation of the whole comparison. It takes O(N log N) time.
+ *
+ * @param PA The first permutation.
+ * @param PB The second permutation.
+ * @param N  The size of the permutations.
+ *
+ * @return   A dynamically allocated permutation of N elements, NULL if memory allocation fails.
+ *           It is the responsibility of the caller to free it using free().
+ */
+int* stickyProduct(const int* PA, const int* PB, int N);
+
+/**
+ * @brief Extends the permutation of a block to a grid with more rows, above and below the block.
+ *
+ * @param P     The permutation of the block.
+ * @param size  The size of the permutation of the block.
+ * @param below The number of blown-up rows after the block (2 characters per character).
+ * @param total The size of the extended permutation.
+ *
+ * @return      A dynamically allocated permutation of total elements, NULL if memory allocation
+ *              fails. It is the responsibility of the caller to free it using free().
+ */
+int* padPermutation(const int* P, int size, int below, int total);
+
+/**
+ * @brief Edit distance of the whole comparison, from its seaweed permutation.
+ *
+ * @param P The permutation of the comparison of the first string with the second one.
+ * @param m The length of the first string.
+ * @param n The length of the second string.
+ *
+ * @return  The edit distance between the two strings.
+ */
+int permutationDistance(const int* P, int m, int n);
+
+#endif
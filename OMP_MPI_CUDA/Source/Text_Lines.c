@@ -0,0 +1,110 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Text_Lines.h"
+
+/**
+ * @brief Loads the lines of a text file, without the line terminators.
+ *
+ * @param path    Path of the file.
+ * @param n_lines Output parameter that receives the number of lines.
+ *
+ * @return        A dynamically allocated array of dynamically allocated strings.
+ *                It is the responsibility of the caller to free it using freeLines().
+ *                Returns NULL if the file cannot be opened or memory allocation fails.
+ */
+char** loadLines(const char* path, int* n_lines) {
+    FILE* fp = fopen(path, "r");
+
+    // Check if the file can be opened
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", path);
+        return NULL;
+    }
+
+    int capacity = 1024;
+    char** lines = (char**)malloc(capacity * sizeof(char*));
+    *n_lines = 0;
+
+    // Check for memory allocation failure
+    if (lines == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        fclose(fp);
+        return NULL;
+    }
+
+    char* line = NULL;
+    size_t size = 0;
+    ssize_t len;
+    int failed = 0;
+    while (!failed && (len = getline(&line, &size, fp)) != -1) {
+        // Strip the line terminator
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+            line[--len] = '\0';
+
+        // Grow the array if needed
+        if (*n_lines == capacity) {
+            char** grown = (char**)realloc(lines, 2 * capacity * sizeof(char*));
+            if (grown == NULL) {
+                failed = 1;
+                break;
+            }
+            lines = grown;
+            capacity *= 2;
+        }
+        lines[*n_lines] = strdup(line);
+        if (lines[*n_lines] == NULL)
+            failed = 1;
+        else
+            (*n_lines)++;
+    }
+
+    free(line);
+    fclose(fp);
+
+    if (failed) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        freeLines(lines, *n_lines);
+        return NULL;
+    }
+
+    return lines;
+}
+
+/**
+ * @brief Frees the lines loaded by loadLines().
+ *
+ * @param lines   The lines.
+ * @param n_lines The number of lines.
+ */
+void freeLines(char** lines, int n_lines) {
+    for (int i = 0; i < n_lines; i++)
+        free(lines[i]);
+    free(lines);
+}
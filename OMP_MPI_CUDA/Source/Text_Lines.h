@@ -0,0 +1,49 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef TEXT_LINES_H
+#define TEXT_LINES_H
+
+/**
+ * @brief Loads the lines of a text file, without the line terminators.
+ *
+ * @param path    Path of the file.
+ * @param n_lines Output parameter that receives the number of lines.
+ *
+ * @return        A dynamically allocated array of dynamically allocated strings.
+ *                It is the responsibility of the caller to free it using freeLines().
+ *                Returns NULL if the file cannot be opened or memory allocation fails.
+ */
+char** loadLines(const char* path, int* n_lines);
+
+/**
+ * @brief Frees the lines loaded by loadLines().
+ *
+ * @param lines   The lines.
+ * @param n_lines The number of lines.
+ */
+void freeLines(char** lines, int n_lines);
+
+#endif
@@ -0,0 +1,277 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <omp.h>
+#include "Edit_Distance_Kernels.h"
+#include "Top_K_Search.h"
+
+/**
+ * @brief Hash of the q-gram starting at the given position.
+ *
+ * @param str The string.
+ * @param pos The position of the first character of the q-gram.
+ *
+ * @return    The bucket of the q-gram, in [0, QGRAM_BUCKETS).
+ */
+static inline int qgramBucket(const char* str, int pos) {
+    unsigned int hash = 0;
+    for (int q = 0; q < QGRAM_LENGTH; ++q)
+        hash = hash * 31 + (unsigned char)str[pos + q];
+    return (int)(hash % QGRAM_BUCKETS);
+}
+
+/**
+ * @brief Fills the hashed q-gram histogram of a string.
+ *
+ * @param str       The string.
+ * @param len       The length of the string.
+ * @param histogram Array of QGRAM_BUCKETS counters, overwritten by the function.
+ */
+void qgramHistogram(const char* str, int len, unsigned short* histogram) {
+    memset(histogram, 0, QGRAM_BUCKETS * sizeof(unsigned short));
+
+    for (int pos = 0; pos + QGRAM_LENGTH <= len; ++pos)
+        histogram[qgramBucket(str, pos)]++;
+}
+
+/**
+ * @brief Lower bound of the edit distance obtained by counting the shared q-grams.
+ *
+ * Each edit operation destroys at most QGRAM_LENGTH q-grams, so two strings at distance d
+ * share at least max(len1, len2) - QGRAM_LENGTH + 1 - QGRAM_LENGTH * d q-grams. Hash
+ * collisions can only increase the shared count, so the bound stays valid.
+ *
+ * @param query_histogram Hashed q-gram histogram of the first string.
+ * @param query_len       Length of the first string.
+ * @param str             The second string.
+ * @param len             Length of the second string.
+ * @param scratch         Array of QGRAM_BUCKETS zeroed counters, left zeroed on return.
+ *
+ * @return                A lower bound of the edit distance between the two strings.
+ */
+int qgramLowerBound(const unsigned short* query_histogram, int query_len, const char* str, int len, unsigned short* scratch) {
+    int shared = 0;
+
+    // Count the q-grams of the string that can be matched with one of the query
+    for (int pos = 0; pos + QGRAM_LENGTH <= len; ++pos) {
+        int bucket = qgramBucket(str, pos);
+        if (scratch[bucket] < query_histogram[bucket])
+            shared++;
+        scratch[bucket]++;
+    }
+
+    // Reset the scratch histogram for the next call
+    for (int pos = 0; pos + QGRAM_LENGTH <= len; ++pos)
+        scratch[qgramBucket(str, pos)] = 0;
+
+    int longest = (len > query_len) ? len : query_len;
+    int missing = longest - QGRAM_LENGTH + 1 - shared;
+    if (missing <= 0)
+        return 0;
+
+    return (missing + QGRAM_LENGTH - 1) / QGRAM_LENGTH;
+}
+
+/**
+ * @brief Tells if the first match is worse than the second one (greater distance, then greater index).
+ */
+static inline int isWorse(SearchMatch a, SearchMatch b) {
+    return a.distance > b.distance || (a.distance == b.distance && a.index > b.index);
+}
+
+/**
+ * @brief Moves the element at the given position down the max-heap of the worst matches.
+ */
+static void siftDown(SearchMatch* heap, int size, int pos) {
+    while (1) {
+        int worst = pos;
+        int left = 2 * pos + 1;
+        int right = left + 1;
+        if (left < size && isWorse(heap[left], heap[worst]))
+            worst = left;
+        if (right < size && isWorse(heap[right], heap[worst]))
+            worst = right;
+        if (worst == pos)
+            return;
+        SearchMatch swap = heap[pos];
+        heap[pos] = heap[worst];
+        heap[worst] = swap;
+        pos = worst;
+    }
+}
+
+/**
+ * @brief Moves the element at the given position up the max-heap of the worst matches.
+ */
+static void siftUp(SearchMatch* heap, int pos) {
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!isWorse(heap[pos], heap[parent]))
+            return;
+        SearchMatch swap = heap[pos];
+        heap[pos] = heap[parent];
+        heap[parent] = swap;
+        pos = parent;
+    }
+}
+
+/**
+ * @brief Comparison function for qsort, ordering the matches from the best to the worst.
+ */
+static int compareMatches(const void* a, const void* b) {
+    const SearchMatch* x = (const SearchMatch*)a;
+    const SearchMatch* y = (const SearchMatch*)b;
+    if (isWorse(*x, *y))
+        return 1;
+    if (isWorse(*y, *x))
+        return -1;
+    return 0;
+}
+
+/**
+ * @brief Finds the k strings of the corpus closest to the query.
+ *
+ * The candidates are processed in parallel by the OpenMP threads. Each one goes through a
+ * cascade of filters against the shared threshold (the distance of the current k-th best
+ * match): the length difference, the q-gram lower bound, and a banded distance computation
+ * bounded by the threshold. The threshold tightens as better candidates are found. Ties are
+ * broken by corpus index, so the result does not depend on the scheduling.
+ *
+ * @param query     The query string.
+ * @param corpus    The strings to search.
+ * @param n_strings The number of strings in the corpus.
+ * @param k         The number of matches to find.
+ * @param matches   Output array of at least k elements, sorted by distance and index.
+ * @param stats     Output statistics about the filters (can be NULL).
+ *
+ * @return          The number of matches found (min(k, n_strings)), -1 on allocation failure.
+ */
+int topKSearch(const char* query, char** corpus, int n_strings, int k, SearchMatch* matches, SearchStatistics* stats) {
+    if (k > n_strings)
+        k = n_strings;
+    if (k <= 0)
+        return 0;
+
+    int query_len = strlen(query);
+    unsigned short query_histogram[QGRAM_BUCKETS];
+    qgramHistogram(query, query_len, query_histogram);
+
+    // Max-heap of the best k matches found so far, the worst one on top
+    SearchMatch* heap = (SearchMatch*)malloc(k * sizeof(SearchMatch));
+
+    // Check for memory allocation failure
+    if (heap == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+
+    int heap_size = 0;
+    int threshold = INT_MAX;
+    int failed = 0;
+    long long length_pruned = 0, qgram_pruned = 0, band_pruned = 0, accepted = 0;
+
+    #pragma omp parallel reduction(+:length_pruned, qgram_pruned, band_pruned, accepted)
+    {
+        // Thread-local scratch histogram for the q-gram filter
+        unsigned short scratch[QGRAM_BUCKETS];
+        memset(scratch, 0, sizeof(scratch));
+
+        #pragma omp for schedule(dynamic, 64)
+        for (int c = 0; c < n_strings; ++c) {
+            // Read the current threshold (it can only decrease)
+            int limit;
+            #pragma omp atomic read
+            limit = threshold;
+
+            const char* str = corpus[c];
+            int len = strlen(str);
+
+            // Filter 1: length difference
+            int difference = (len > query_len) ? len - query_len : query_len - len;
+            if (difference > limit) {
+                length_pruned++;
+                continue;
+            }
+
+            // Filter 2: q-gram count lower bound
+            if (qgramLowerBound(query_histogram, query_len, str, len, scratch) > limit) {
+                qgram_pruned++;
+                continue;
+            }
+
+            // Filter 3: banded distance bounded by the threshold
+            int longest = (len > query_len) ? len : query_len;
+            int bound = (limit < longest) ? limit : longest;
+            int distance = boundedLevenshtein(query, query_len, str, len, bound);
+            if (distance < 0) {
+                #pragma omp atomic write
+                failed = 1;
+                continue;
+            }
+            if (distance > bound) {
+                band_pruned++;
+                continue;
+            }
+            accepted++;
+
+            // Insert the candidate among the best matches
+            SearchMatch candidate = { c, distance };
+            #pragma omp critical(top_k_heap)
+            {
+                if (heap_size < k) {
+                    heap[heap_size] = candidate;
+                    siftUp(heap, heap_size);
+                    heap_size++;
+                } else if (isWorse(heap[0], candidate)) {
+                    heap[0] = candidate;
+                    siftDown(heap, heap_size, 0);
+                }
+
+                // Tighten the shared threshold once k matches are known
+                if (heap_size == k) {
+                    #pragma omp atomic write
+                    threshold = heap[0].distance;
+                }
+            }
+        }
+    }
+
+    // Return the matches from the best to the worst
+    qsort(heap, heap_size, sizeof(SearchMatch), compareMatches);
+    memcpy(matches, heap, heap_size * sizeof(SearchMatch));
+    free(heap);
+
+    if (stats != NULL) {
+        stats->length_pruned = length_pruned;
+        stats->qgram_pruned = qgram_pruned;
+        stats->band_pruned = band_pruned;
+        stats->accepted = accepted;
+    }
+
+    return failed ? -1 : heap_size;
+}
@@ -0,0 +1,97 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#ifndef TOP_K_SEARCH_H
+#define TOP_K_SEARCH_H
+
+//Length of the q-grams used by the q-gram lower bound
+#define QGRAM_LENGTH 2
+//Number of buckets of the hashed q-gram histograms
+#define QGRAM_BUCKETS 1024
+
+/**
+ * @brief A string of the corpus with its distance from the query.
+ */
+typedef struct {
+    int index;     /**< Index of the string in the corpus. */
+    int distance;  /**< Edit distance from the query. */
+} SearchMatch;
+
+/**
+ * @brief Number of candidates rejected by each filter of the search.
+ */
+typedef struct {
+    long long length_pruned;  /**< Rejected by the length difference. */
+    long long qgram_pruned;   /**< Rejected by the q-gram count lower bound. */
+    long long band_pruned;    /**< Rejected by the banded check at the current threshold. */
+    long long accepted;       /**< Distance computed within the threshold. */
+} SearchStatistics;
+
+/**
+ * @brief Fills the hashed q-gram histogram of a string.
+ *
+ * @param str       The string.
+ * @param len       The length of the string.
+ * @param histogram Array of QGRAM_BUCKETS counters, overwritten by the function.
+ */
+void qgramHistogram(const char* str, int len, unsigned short* histogram);
+
+/**
+ * @brief Lower bound of the edit distance obtained by counting the shared q-grams.
+ *
+ * Each edit operation destroys at most QGRAM_LENGTH q-grams, so two strings at distance d
+ * share at least max(len1, len2) - QGRAM_LENGTH + 1 - QGRAM_LENGTH * d q-grams. Hash
+ * collisions can only increase the shared count, so the bound stays valid.
+ *
+ * @param query_histogram Hashed q-gram histogram of the first string.
+ * @param query_len       Length of the first string.
+ * @param str             The second string.
+ * @param len             Length of the second string.
+ * @param scratch         Array of QGRAM_BUCKETS zeroed counters, left zeroed on return.
+ *
+ * @return                A lower bound of the edit distance between the two strings.
+ */
+int qgramLowerBound(const unsigned short* query_histogram, int query_len, const char* str, int len, unsigned short* scratch);
+
+/**
+ * @brief Finds the k strings of the corpus closest to the query.
+ *
+ * The candidates are processed in parallel by the OpenMP threads. Each one goes through a
+ * cascade of filters against the shared threshold (the distance of the current k-th best
+ * match): the length difference, the q-gram lower bound, and a banded distance computation
+ * bounded by the threshold. The threshold tightens as better candidates are found. Ties are
+ * broken by corpus index, so the result does not depend on the scheduling.
+ *
+ * @param query     The query string.
+ * @param corpus    The strings to search.
+ * @param n_strings The number of strings in the corpus.
+ * @param k         The number of matches to find.
+ * @param matches   Output array of at least k elements, sorted by distance and index.
+ * @param stats     Output statistics about the filters (can be NULL).
+ *
+ * @return          The number of matches found (min(k, n_strings)), -1 on allocation failure.
+ */
+int topKSearch(const char* query, char** corpus, int n_strings, int k, SearchMatch* matches, SearchStatistics* stats);
+
+#endif
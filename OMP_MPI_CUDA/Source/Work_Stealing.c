@@ -0,0 +1,342 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sched.h>
+#include <omp.h>
+#include "Work_Stealing.h"
+#include "Progress.h"
+
+/**
+ * @brief The blocks of the distance matrix of a pair of strings.
+ */
+typedef struct {
+    const char* str1;  /**< The first string (rows). */
+    const char* str2;  /**< The second string (columns). */
+    int len1;          /**< Length of the first string. */
+    int len2;          /**< Length of the second string. */
+    int block_rows;    /**< Number of rows of blocks. */
+    int block_cols;    /**< Number of columns of blocks. */
+    int first_unit;    /**< Index of the first block among the units of all the pairs. */
+    int* top;          /**< Last row computed in each column of blocks (len2 + 1 cells). */
+    int* left;         /**< Last column computed in each row of blocks (len1 + 1 cells). */
+    int* corner;       /**< Bottom-right cell of each block. */
+    int* pending;      /**< Number of blocks above and on the left of each block not yet done. */
+} PairBlocks;
+
+/**
+ * @brief The deque of the ready units of a thread, on its own cache lines.
+ */
+typedef struct {
+    int* units;        /**< The units: the owner works at the tail, the thieves at the head. */
+    int head;          /**< Index of the oldest unit. */
+    int tail;          /**< Index after the newest unit. */
+    omp_lock_t lock;   /**< Lock of the deque. */
+    char padding[64];
+} WorkDeque;
+
+/**
+ * @brief Adds a unit at the tail of a deque (by its owner).
+ */
+static void pushUnit(WorkDeque* deque, int unit) {
+    omp_set_lock(&deque->lock);
+    deque->units[deque->tail++] = unit;
+    omp_unset_lock(&deque->lock);
+}
+
+/**
+ * @brief Takes the newest unit of a deque (by its owner).
+ *
+ * @return The unit, -1 if the deque is empty.
+ */
+static int popUnit(WorkDeque* deque) {
+    int unit = -1;
+    omp_set_lock(&deque->lock);
+    if (deque->tail > deque->head)
+        unit = deque->units[--deque->tail];
+    omp_unset_lock(&deque->lock);
+    return unit;
+}
+
+/**
+ * @brief Takes the oldest unit of a deque (by a thief).
+ *
+ * @return The unit, -1 if the deque is empty.
+ */
+static int stealUnit(WorkDeque* deque) {
+    int unit = -1;
+    omp_set_lock(&deque->lock);
+    if (deque->tail > deque->head)
+        unit = deque->units[deque->head++];
+    omp_unset_lock(&deque->lock);
+    return unit;
+}
+
+/**
+ * @brief Computes a block of the distance matrix of a pair from its top and left boundaries.
+ *
+ * The block replaces its top boundary with its last row and its left boundary with its last
+ * column, which are the boundaries of the blocks below and on its right.
+ *
+ * @param pair  The blocks of the pair.
+ * @param side  The side of the blocks.
+ * @param block The index of the block in the pair.
+ */
+static void computeBlock(PairBlocks* pair, int side, int block) {
+    int bi = block / pair->block_cols;
+    int bj = block % pair->block_cols;
+    int r0 = bi * side;
+    int c0 = bj * side;
+    int r1 = (r0 + side < pair->len1) ? r0 + side : pair->len1;
+    int width = (c0 + side < pair->len2) ? side : pair->len2 - c0;
+    int* row = pair->top + c0;
+    const char* strip = pair->str2 + c0 - 1;
+
+    // Cell above and on the left of the block
+    int diagonal;
+    if (r0 == 0)
+        diagonal = c0;
+    else if (c0 == 0)
+        diagonal = r0;
+    else
+        diagonal = pair->corner[block - pair->block_cols - 1];
+
+    for (int i = r0 + 1; i <= r1; ++i) {
+        char a = pair->str1[i - 1];
+        int first = pair->left[i];
+        int left = first;
+        int corner = diagonal;
+
+        // Cells of the row inside the block
+        for (int k = 1; k <= width; ++k) {
+            int up = row[k];
+            int value = corner + (a != strip[k]);
+            if (up + 1 < value)
+                value = up + 1;
+            if (left + 1 < value)
+                value = left + 1;
+            corner = up;
+            row[k] = value;
+            left = value;
+        }
+
+        // Pass the last column of the block to the next one
+        diagonal = first;
+        pair->left[i] = left;
+    }
+
+    pair->corner[block] = pair->left[r1];
+    progressAdd((long long)(r1 - r0) * width, 1);
+}
+
+/**
+ * @brief Marks a predecessor of a block as done, and pushes the block if it is ready.
+ */
+static void releaseBlock(PairBlocks* pair, int block, WorkDeque* deque) {
+    int pending;
+    #pragma omp atomic capture seq_cst
+    pending = --pair->pending[block];
+    if (pending == 0)
+        pushUnit(deque, pair->first_unit + block);
+}
+
+/**
+ * @brief Calculates the Levenshtein distances of many pairs of strings with a work-stealing scheduler.
+ *
+ * The distance matrix of each pair is cut in square blocks, each a work unit, sized from the
+ * cells of all the pairs so that there are about UNITS_PER_THREAD units for each thread (a
+ * longer pair gets more units, not bigger ones). A block is ready when the blocks above and on
+ * its left are done. Each thread has a deque of ready units: it starts from the first block of
+ * its own pairs, pushes the blocks made ready by its units on its deque and takes the newest
+ * one, and when its deque is empty it steals the oldest unit of another thread. The blocks
+ * keep only their boundaries, so the distances are the same as the whole matrix.
+ *
+ * @param str1      The first string of each pair.
+ * @param str2      The second string of each pair.
+ * @param n_pairs   The number of pairs.
+ * @param n_threads The number of OpenMP threads.
+ * @param results   Output parameter: the distance of each pair.
+ * @param balance   Output parameter: the work done by each thread (n_threads elements).
+ *
+ * @return          0 on success, -1 if memory allocation fails.
+ */
+int stealingLevenshtein(char** str1, char** str2, int n_pairs, int n_threads, int* results, ThreadBalance* balance) {
+    memset(balance, 0, n_threads * sizeof(ThreadBalance));
+
+    // Size the blocks from the cells of all the pairs
+    long long total_cells = 0;
+    for (int p = 0; p < n_pairs; p++)
+        total_cells += (long long)strlen(str1[p]) * strlen(str2[p]);
+    int side = (int)ceil(sqrt((double)total_cells / ((double)n_threads * UNITS_PER_THREAD)));
+    if (side < MIN_BLOCK_SIDE)
+        side = MIN_BLOCK_SIDE;
+
+    // Cut the matrix of each pair in blocks
+    PairBlocks* pairs = (PairBlocks*)calloc(n_pairs, sizeof(PairBlocks));
+    WorkDeque* deques = (WorkDeque*)calloc(n_threads, sizeof(WorkDeque));
+    if (pairs == NULL || deques == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(pairs);
+        free(deques);
+        return -1;
+    }
+
+    int total_units = 0, failed = 0;
+    for (int p = 0; p < n_pairs; p++) {
+        PairBlocks* pair = &pairs[p];
+        pair->str1 = str1[p];
+        pair->str2 = str2[p];
+        pair->len1 = strlen(str1[p]);
+        pair->len2 = strlen(str2[p]);
+        pair->first_unit = total_units;
+
+        // An empty string needs no blocks
+        if (pair->len1 == 0 || pair->len2 == 0) {
+            results[p] = pair->len1 + pair->len2;
+            continue;
+        }
+
+        pair->block_rows = (pair->len1 + side - 1) / side;
+        pair->block_cols = (pair->len2 + side - 1) / side;
+        int n_blocks = pair->block_rows * pair->block_cols;
+        total_units += n_blocks;
+
+        pair->top = (int*)malloc((pair->len2 + 1) * sizeof(int));
+        pair->left = (int*)malloc((pair->len1 + 1) * sizeof(int));
+        pair->corner = (int*)malloc(n_blocks * sizeof(int));
+        pair->pending = (int*)malloc(n_blocks * sizeof(int));
+        if (pair->top == NULL || pair->left == NULL || pair->corner == NULL || pair->pending == NULL) {
+            failed = 1;
+            break;
+        }
+
+        // First row and first column of the matrix
+        for (int j = 0; j <= pair->len2; ++j)
+            pair->top[j] = j;
+        for (int i = 0; i <= pair->len1; ++i)
+            pair->left[i] = i;
+        for (int b = 0; b < n_blocks; b++)
+            pair->pending[b] = (b / pair->block_cols > 0) + (b % pair->block_cols > 0);
+    }
+
+    // Owner of each unit
+    int* unit_pair = (!failed) ? (int*)malloc((total_units + 1) * sizeof(int)) : NULL;
+    for (int t = 0; t < n_threads && unit_pair != NULL; t++) {
+        deques[t].units = (int*)malloc((total_units + 1) * sizeof(int));
+        if (deques[t].units == NULL)
+            failed = 1;
+        omp_init_lock(&deques[t].lock);
+    }
+    if (unit_pair == NULL)
+        failed = 1;
+
+    if (!failed) {
+        for (int p = 0; p < n_pairs; p++) {
+            for (int b = 0; b < pairs[p].block_rows * pairs[p].block_cols; b++)
+                unit_pair[pairs[p].first_unit + b] = p;
+
+            // The first block of each pair is ready, on the deque of the thread of the pair
+            if (pairs[p].block_rows > 0)
+                pushUnit(&deques[p % n_threads], pairs[p].first_unit);
+        }
+
+        int remaining = total_units;
+
+        #pragma omp parallel num_threads(n_threads)
+        {
+            int tid = omp_get_thread_num();
+            ThreadBalance local = {0, 0, 0.0, 0.0};
+            double start = omp_get_wtime();
+
+            while (1) {
+                int left;
+                #pragma omp atomic read seq_cst
+                left = remaining;
+                if (left == 0)
+                    break;
+
+                // Take the newest unit of the own deque, or steal the oldest of another one
+                int unit = popUnit(&deques[tid]);
+                for (int v = 1; v < n_threads && unit < 0; v++) {
+                    unit = stealUnit(&deques[(tid + v) % n_threads]);
+                    if (unit >= 0)
+                        local.stolen++;
+                }
+                if (unit < 0) {
+                    sched_yield();
+                    continue;
+                }
+
+                PairBlocks* pair = &pairs[unit_pair[unit]];
+                int block = unit - pair->first_unit;
+
+                double unit_start = omp_get_wtime();
+                computeBlock(pair, side, block);
+                local.busy_time += omp_get_wtime() - unit_start;
+                local.units++;
+
+                // Release the block below, then the one on the right (taken first by this thread)
+                if (block / pair->block_cols + 1 < pair->block_rows)
+                    releaseBlock(pair, block + pair->block_cols, &deques[tid]);
+                if (block % pair->block_cols + 1 < pair->block_cols)
+                    releaseBlock(pair, block + 1, &deques[tid]);
+
+                #pragma omp atomic update seq_cst
+                remaining--;
+            }
+
+            local.idle_time = omp_get_wtime() - start - local.busy_time;
+            balance[tid] = local;
+        }
+
+        // The distance is the last cell of the last block
+        for (int p = 0; p < n_pairs; p++)
+            if (pairs[p].block_rows > 0)
+                results[p] = pairs[p].corner[pairs[p].block_rows * pairs[p].block_cols - 1];
+    } else {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+    }
+
+    // Free allocated memory
+    for (int t = 0; t < n_threads; t++) {
+        if (unit_pair != NULL)
+            omp_destroy_lock(&deques[t].lock);
+        free(deques[t].units);
+    }
+    for (int p = 0; p < n_pairs; p++) {
+        free(pairs[p].top);
+        free(pairs[p].left);
+        free(pairs[p].corner);
+        free(pairs[p].pending);
+    }
+    free(unit_pair);
+    free(deques);
+    free(pairs);
+
+    return failed ? -1 : 0;
+}
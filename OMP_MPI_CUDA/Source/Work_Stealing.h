@@ -0,0 +1,66 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+
+#ifndef WORK_STEALING_H
+#define WORK_STEALING_H
+
+//Number of work units for each thread
+#define UNITS_PER_THREAD 64
+//Smallest side of a block of the distance matrix (a work unit)
+#define MIN_BLOCK_SIDE 64
+
+/**
+ * @brief The work done by a thread of the work-stealing scheduler.
+ */
+typedef struct {
+    int units;         /**< Number of units computed by the thread. */
+    int stolen;        /**< Number of units taken from the deques of the other threads. */
+    double busy_time;  /**< Time spent computing units, in seconds. */
+    double idle_time;  /**< Time spent looking for work, in seconds. */
+} ThreadBalance;
+
+/**
+ * @brief Calculates the Levenshtein distances of many pairs of strings with a work-stealing scheduler.
+ *
+ * The distance matrix of each pair is cut in square blocks, each a work unit, sized from the
+ * cells of all the pairs so that there are about UNITS_PER_THREAD units for each thread (a
+ * longer pair gets more units, not bigger ones). A block is ready when the blocks above and on
+ * its left are done. Each thread has a deque of ready units: it starts from the first block of
+ * its own pairs, pushes the blocks made ready by its units on its deque and takes the newest
+ * one, and when its deque is empty it steals the oldest unit of another thread. The blocks
+ * keep only their boundaries, so the distances are the same as the whole matrix.
+ *
+ * @param str1      The first string of each pair.
+ * @param str2      The second string of each pair.
+ * @param n_pairs   The number of pairs.
+ * @param n_threads The number of OpenMP threads.
+ * @param results   Output parameter: the distance of each pair.
+ * @param balance   Output parameter: the work done by each thread (n_threads elements).
+ *
+ * @return          0 on success, -1 if memory allocation fails.
+ */
+int stealingLevenshtein(char** str1, char** str2, int n_pairs, int n_threads, int* results, ThreadBalance* balance);
+
+#endif
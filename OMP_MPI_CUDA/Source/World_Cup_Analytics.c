@@ -0,0 +1,622 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "World_Cup_Dataset.h"
+//Number of players on the field at the beginning of a match
+#define PLAYERS_ON_FIELD 11
+//Initial capacity of the thread-local hash tables
+#define INITIAL_CAPACITY 1024
+
+/**
+ * @brief Goals scored by a player (only players with at least one goal are stored).
+ */
+typedef struct {
+    const char* name;   /**< Name of the player, pointer into the mapped file (NULL if the slot is empty). */
+    int length;         /**< Length of the name. */
+    unsigned int hash;  /**< Hash of the name. */
+    int goals;          /**< Number of goals and penalties scored. */
+} PlayerEntry;
+
+/**
+ * @brief Partial result of a match: the two teams, their goals and their red cards.
+ */
+typedef struct {
+    int match_id;        /**< MatchID (0 if the slot is empty). */
+    int n_teams;         /**< Number of teams seen so far (at most 2). */
+    char team[2][8];     /**< Initials of the teams. */
+    int goals[2];        /**< Goals of each team (own goals are subtracted from the team of the player). */
+    int red_cards[2];    /**< Red cards of each team. */
+} MatchEntry;
+
+/**
+ * @brief Open addressing hash table of players, keyed by name.
+ */
+typedef struct {
+    PlayerEntry* entries;
+    int capacity;
+    int count;
+} PlayerTable;
+
+/**
+ * @brief Open addressing hash table of matches, keyed by MatchID.
+ */
+typedef struct {
+    MatchEntry* entries;
+    int capacity;
+    int count;
+} MatchTable;
+
+/**
+ * @brief State of each thread: its local tables and the rows where a goal was scored.
+ */
+typedef struct {
+    PlayerTable players;
+    MatchTable matches;
+    const char** goal_rows;
+    long long n_goal_rows;
+    long long goal_rows_capacity;
+    long long rows;
+} ThreadState;
+
+/**
+ * @brief A row where a goal was scored, with the name of the player and the position of the row in the file.
+ */
+typedef struct {
+    const char* row;
+    const char* name;
+    int length;
+    long long order;
+} GoalRow;
+
+/**
+ * @brief Hash of a name (FNV-1a).
+ */
+static unsigned int hashName(const char* name, int length) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++)
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    return hash;
+}
+
+/**
+ * @brief Hash of a MatchID.
+ */
+static unsigned int hashMatch(int match_id) {
+    return (unsigned int)match_id * 2654435761u;
+}
+
+/**
+ * @brief Initializes an empty table of players.
+ */
+static void initPlayerTable(PlayerTable* table, int capacity) {
+    table->entries = (PlayerEntry*)calloc(capacity, sizeof(PlayerEntry));
+    table->capacity = capacity;
+    table->count = 0;
+    if (table->entries == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Initializes an empty table of matches.
+ */
+static void initMatchTable(MatchTable* table, int capacity) {
+    table->entries = (MatchEntry*)calloc(capacity, sizeof(MatchEntry));
+    table->capacity = capacity;
+    table->count = 0;
+    if (table->entries == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void growPlayerTable(PlayerTable* table);
+static void growMatchTable(MatchTable* table);
+
+/**
+ * @brief Adds goals to a player, inserting the player if needed.
+ */
+static void addPlayerGoals(PlayerTable* table, const char* name, int length, unsigned int hash, int goals) {
+    if (2 * (table->count + 1) > table->capacity)
+        growPlayerTable(table);
+
+    int slot = hash & (table->capacity - 1);
+    while (table->entries[slot].name != NULL) {
+        PlayerEntry* entry = &table->entries[slot];
+        if (entry->hash == hash && entry->length == length && memcmp(entry->name, name, length) == 0) {
+            entry->goals += goals;
+            return;
+        }
+        slot = (slot + 1) & (table->capacity - 1);
+    }
+
+    table->entries[slot].name = name;
+    table->entries[slot].length = length;
+    table->entries[slot].hash = hash;
+    table->entries[slot].goals = goals;
+    table->count++;
+}
+
+/**
+ * @brief Doubles the capacity of a table of players.
+ */
+static void growPlayerTable(PlayerTable* table) {
+    PlayerTable grown;
+    initPlayerTable(&grown, 2 * table->capacity);
+    for (int i = 0; i < table->capacity; i++) {
+        PlayerEntry* entry = &table->entries[i];
+        if (entry->name != NULL)
+            addPlayerGoals(&grown, entry->name, entry->length, entry->hash, entry->goals);
+    }
+    free(table->entries);
+    *table = grown;
+}
+
+/**
+ * @brief Returns the entry of a match, inserting an empty one if needed.
+ */
+static MatchEntry* findMatch(MatchTable* table, int match_id) {
+    if (2 * (table->count + 1) > table->capacity)
+        growMatchTable(table);
+
+    int slot = hashMatch(match_id) & (table->capacity - 1);
+    while (table->entries[slot].match_id != 0 && table->entries[slot].match_id != match_id)
+        slot = (slot + 1) & (table->capacity - 1);
+
+    if (table->entries[slot].match_id == 0) {
+        table->entries[slot].match_id = match_id;
+        table->count++;
+    }
+
+    return &table->entries[slot];
+}
+
+/**
+ * @brief Returns the index of a team in a match, adding the team if needed (-1 if the match already has two other teams).
+ */
+static int findTeam(MatchEntry* match, const char* team, int length) {
+    if (length > 7)
+        length = 7;
+
+    for (int t = 0; t < match->n_teams; t++)
+        if ((int)strlen(match->team[t]) == length && memcmp(match->team[t], team, length) == 0)
+            return t;
+
+    if (match->n_teams == 2)
+        return -1;
+
+    int t = match->n_teams++;
+    memcpy(match->team[t], team, length);
+    match->team[t][length] = '\0';
+    return t;
+}
+
+/**
+ * @brief Merges the partial result of a match into a table.
+ */
+static void mergeMatch(MatchTable* table, const MatchEntry* partial) {
+    MatchEntry* match = findMatch(table, partial->match_id);
+    for (int p = 0; p < partial->n_teams; p++) {
+        int t = findTeam(match, partial->team[p], strlen(partial->team[p]));
+        if (t < 0)
+            continue;
+        match->goals[t] += partial->goals[p];
+        match->red_cards[t] += partial->red_cards[p];
+    }
+}
+
+/**
+ * @brief Doubles the capacity of a table of matches.
+ */
+static void growMatchTable(MatchTable* table) {
+    MatchTable grown;
+    initMatchTable(&grown, 2 * table->capacity);
+    for (int i = 0; i < table->capacity; i++)
+        if (table->entries[i].match_id != 0)
+            mergeMatch(&grown, &table->entries[i]);
+    free(table->entries);
+    *table = grown;
+}
+
+/**
+ * @brief Aggregates one row into the local state of the thread.
+ *
+ * Goals (G) and penalties (P) count for both the player and the team, own goals (W) are
+ * subtracted from the team of the player, and red cards (R) remove a player from the team.
+ */
+static void aggregateRow(ThreadState* state, const char* row_start, const PlayerRow* row) {
+    if (row->length[COLUMN_MATCH_ID] == 0)
+        return;
+
+    state->rows++;
+
+    // Every row registers its team in the match, even without events
+    MatchEntry* match = findMatch(&state->matches, fieldToInt(row->field[COLUMN_MATCH_ID], row->length[COLUMN_MATCH_ID]));
+    int team = findTeam(match, row->field[COLUMN_TEAM_INITIALS], row->length[COLUMN_TEAM_INITIALS]);
+
+    // Scan the events, separated by spaces
+    int goals = 0;
+    const char* event = row->field[COLUMN_EVENT];
+    const char* events_end = event + row->length[COLUMN_EVENT];
+    while (event < events_end) {
+        const char* next = findByte(event, events_end, ' ');
+        if (next > event) {
+            if (*event == 'G' || *event == 'P')
+                goals++;
+            else if (*event == 'W' && team >= 0)
+                match->goals[team]--;
+            else if (*event == 'R' && team >= 0)
+                match->red_cards[team]++;
+        }
+        event = next + 1;
+    }
+
+    if (goals == 0)
+        return;
+
+    if (team >= 0)
+        match->goals[team] += goals;
+
+    // Keep the player and the row for the goal lists of the report
+    const char* name = row->field[COLUMN_PLAYER_NAME];
+    int length = row->length[COLUMN_PLAYER_NAME];
+    addPlayerGoals(&state->players, name, length, hashName(name, length), goals);
+
+    if (state->n_goal_rows == state->goal_rows_capacity) {
+        state->goal_rows_capacity = state->goal_rows_capacity > 0 ? 2 * state->goal_rows_capacity : INITIAL_CAPACITY;
+        state->goal_rows = (const char**)realloc(state->goal_rows, state->goal_rows_capacity * sizeof(const char*));
+        if (state->goal_rows == NULL) {
+            fprintf(stderr, "ERROR in memory allocation.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    state->goal_rows[state->n_goal_rows++] = row_start;
+}
+
+/**
+ * @brief Comparison function for qsort: more goals first, then alphabetical order of the name.
+ */
+static int compareScorers(const void* a, const void* b) {
+    const PlayerEntry* x = *(const PlayerEntry* const*)a;
+    const PlayerEntry* y = *(const PlayerEntry* const*)b;
+    if (x->goals != y->goals)
+        return y->goals - x->goals;
+    int shortest = (x->length < y->length) ? x->length : y->length;
+    int result = memcmp(x->name, y->name, shortest);
+    return (result != 0) ? result : x->length - y->length;
+}
+
+/**
+ * @brief Prints the goals of a row in the format of the inverted index ("{MatchID: G3',G21'}; ").
+ */
+static void printGoalRow(FILE* fp, const char* row_start, const char* data_end) {
+    PlayerRow row;
+    parseRow(row_start, data_end, &row);
+
+    fprintf(fp, "{%.*s: ", row.length[COLUMN_MATCH_ID], row.field[COLUMN_MATCH_ID]);
+
+    int first = 1;
+    const char* event = row.field[COLUMN_EVENT];
+    const char* events_end = event + row.length[COLUMN_EVENT];
+    while (event < events_end) {
+        const char* next = findByte(event, events_end, ' ');
+        if (next > event && (*event == 'G' || *event == 'P')) {
+            fprintf(fp, first ? "%.*s" : ",%.*s", (int)(next - event), event);
+            first = 0;
+        }
+        event = next + 1;
+    }
+
+    fprintf(fp, "}; ");
+}
+
+/**
+ * @brief Comparison function for qsort: goal rows grouped by player name, in the order of the file.
+ */
+static int compareGoalRows(const void* a, const void* b) {
+    const GoalRow* x = (const GoalRow*)a;
+    const GoalRow* y = (const GoalRow*)b;
+    int shortest = (x->length < y->length) ? x->length : y->length;
+    int result = memcmp(x->name, y->name, shortest);
+    if (result != 0)
+        return result;
+    if (x->length != y->length)
+        return x->length - y->length;
+    return (x->order < y->order) ? -1 : (x->order > y->order);
+}
+
+/**
+ * @brief Prints a player and all its goals, finding the first goal row of the player with a binary search.
+ */
+static void printScorer(FILE* fp, const PlayerEntry* player, const GoalRow* goal_rows, long long n_goal_rows, const char* data_end) {
+    GoalRow key = { NULL, player->name, player->length, -1 };
+    long long low = 0, high = n_goal_rows;
+    while (low < high) {
+        long long middle = low + (high - low) / 2;
+        if (compareGoalRows(&goal_rows[middle], &key) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    fprintf(fp, "%.*s\t", player->length, player->name);
+    for (long long r = low; r < n_goal_rows && goal_rows[r].length == player->length &&
+         memcmp(goal_rows[r].name, player->name, player->length) == 0; r++)
+        printGoalRow(fp, goal_rows[r].row, data_end);
+    fprintf(fp, "\n");
+}
+
+/**
+ * @brief Main function for the native World Cup analytics engine.
+ *
+ * This program maps the players dataset, parses it in parallel (each OpenMP thread takes a
+ * range of rows and aggregates it in thread-local hash tables), then merges the tables without
+ * locks: each thread owns a shard of the keys and collects it from every local table. It prints
+ * the same results of the cluster jobs: the top-k scorers with their goals (Hadoop) and the team
+ * that won the most matches with the fewest players on the field (Spark). The last line
+ * contains the timing information.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    // Check if the correct number of command line arguments is provided
+    if (argc != 4 && argc != 5) {
+        fprintf(stderr, "Usage: %s <players_csv> <k> <n_threads> [scorers_file]\n", argv[0]);
+        return 1;
+    }
+
+    // Parse command line arguments
+    char* csv_path = argv[1];
+    int k = atoi(argv[2]);
+    int n_threads = atoi(argv[3]);
+    char* scorers_path = (argc == 5) ? argv[4] : NULL;
+
+    // Set the number of OpenMP threads
+    omp_set_num_threads(n_threads);
+
+    double execution_start = omp_get_wtime();
+
+    // Map the dataset
+    MappedFile file;
+    if (mapFile(csv_path, &file) != 0)
+        return 1;
+    const char* data_end = file.data + file.size;
+
+    ThreadState* states = (ThreadState*)calloc(n_threads, sizeof(ThreadState));
+    PlayerTable* player_shards = (PlayerTable*)calloc(n_threads, sizeof(PlayerTable));
+    MatchTable* match_shards = (MatchTable*)calloc(n_threads, sizeof(MatchTable));
+    if (states == NULL || player_shards == NULL || match_shards == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+
+    double parse_time = 0.0, merge_time = 0.0;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        int tid = omp_get_thread_num();
+        ThreadState* state = &states[tid];
+        double start = omp_get_wtime();
+
+        // Parse and aggregate the rows of this thread
+        initPlayerTable(&state->players, INITIAL_CAPACITY);
+        initMatchTable(&state->matches, INITIAL_CAPACITY);
+
+        const char* begin;
+        const char* end;
+        threadRowRange(&file, tid, n_threads, &begin, &end);
+
+        PlayerRow row;
+        while (begin < end) {
+            const char* row_start = begin;
+            begin = parseRow(begin, end, &row);
+            aggregateRow(state, row_start, &row);
+        }
+
+        #pragma omp barrier
+
+        #pragma omp master
+        parse_time = omp_get_wtime() - start;
+
+        double merge_start = omp_get_wtime();
+
+        // Lock-free merge: this thread collects its own shard of keys from every local table
+        initPlayerTable(&player_shards[tid], INITIAL_CAPACITY);
+        initMatchTable(&match_shards[tid], INITIAL_CAPACITY);
+
+        for (int t = 0; t < n_threads; t++) {
+            PlayerTable* local_players = &states[t].players;
+            for (int i = 0; i < local_players->capacity; i++) {
+                PlayerEntry* entry = &local_players->entries[i];
+                if (entry->name != NULL && (int)(entry->hash % n_threads) == tid)
+                    addPlayerGoals(&player_shards[tid], entry->name, entry->length, entry->hash, entry->goals);
+            }
+
+            MatchTable* local_matches = &states[t].matches;
+            for (int i = 0; i < local_matches->capacity; i++) {
+                MatchEntry* entry = &local_matches->entries[i];
+                if (entry->match_id != 0 && (int)(hashMatch(entry->match_id) % n_threads) == tid)
+                    mergeMatch(&match_shards[tid], entry);
+            }
+        }
+
+        #pragma omp barrier
+
+        #pragma omp master
+        merge_time = omp_get_wtime() - merge_start;
+    }
+
+    // Winners of each match: goals decide, then the players left on the field are counted
+    int n_matches = 0;
+    for (int s = 0; s < n_threads; s++)
+        n_matches += match_shards[s].count;
+    char (*winner_team)[8] = malloc((n_matches + 1) * sizeof(*winner_team));
+    int* winner_players = (int*)malloc((n_matches + 1) * sizeof(int));
+    if (winner_team == NULL || winner_players == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+    int n_winners = 0;
+    int min_players = PLAYERS_ON_FIELD + 1;
+
+    for (int s = 0; s < n_threads; s++) {
+        for (int i = 0; i < match_shards[s].capacity; i++) {
+            MatchEntry* match = &match_shards[s].entries[i];
+            if (match->match_id == 0 || match->n_teams != 2 || match->goals[0] == match->goals[1])
+                continue;
+            int w = (match->goals[0] > match->goals[1]) ? 0 : 1;
+            strcpy(winner_team[n_winners], match->team[w]);
+            winner_players[n_winners] = PLAYERS_ON_FIELD - match->red_cards[w];
+            if (winner_players[n_winners] < min_players)
+                min_players = winner_players[n_winners];
+            n_winners++;
+        }
+    }
+
+    // Teams with the most wins among the matches won with the fewest players
+    int max_wins = 0;
+    int* wins = (int*)calloc(n_winners + 1, sizeof(int));
+    if (wins == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+    for (int i = 0; i < n_winners; i++) {
+        if (winner_players[i] != min_players)
+            continue;
+        // Count on the first occurrence of the team
+        int first = i;
+        for (int j = 0; j < i; j++) {
+            if (winner_players[j] == min_players && strcmp(winner_team[j], winner_team[i]) == 0) {
+                first = j;
+                break;
+            }
+        }
+        wins[first]++;
+        if (wins[first] > max_wins)
+            max_wins = wins[first];
+    }
+
+    // Top-k scorers: more goals first, then alphabetical order
+    int n_scorers = 0;
+    for (int s = 0; s < n_threads; s++)
+        n_scorers += player_shards[s].count;
+    PlayerEntry** scorers = (PlayerEntry**)malloc((n_scorers + 1) * sizeof(PlayerEntry*));
+    if (scorers == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+    n_scorers = 0;
+    for (int s = 0; s < n_threads; s++)
+        for (int i = 0; i < player_shards[s].capacity; i++)
+            if (player_shards[s].entries[i].name != NULL)
+                scorers[n_scorers++] = &player_shards[s].entries[i];
+    qsort(scorers, n_scorers, sizeof(PlayerEntry*), compareScorers);
+    if (k > n_scorers)
+        k = n_scorers;
+
+    double report_start = omp_get_wtime();
+
+    // Group the goal rows by player, keeping the order of the file (the ranges of the threads follow it)
+    long long n_goal_rows = 0;
+    for (int t = 0; t < n_threads; t++)
+        n_goal_rows += states[t].n_goal_rows;
+    GoalRow* goal_rows = (GoalRow*)malloc((n_goal_rows + 1) * sizeof(GoalRow));
+    if (goal_rows == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+    n_goal_rows = 0;
+    for (int t = 0; t < n_threads; t++) {
+        for (long long r = 0; r < states[t].n_goal_rows; r++) {
+            PlayerRow row;
+            parseRow(states[t].goal_rows[r], data_end, &row);
+            goal_rows[n_goal_rows].row = states[t].goal_rows[r];
+            goal_rows[n_goal_rows].name = row.field[COLUMN_PLAYER_NAME];
+            goal_rows[n_goal_rows].length = row.length[COLUMN_PLAYER_NAME];
+            goal_rows[n_goal_rows].order = n_goal_rows;
+            n_goal_rows++;
+        }
+    }
+    qsort(goal_rows, n_goal_rows, sizeof(GoalRow), compareGoalRows);
+
+    // Print the top-k scorers with their goals, as the output of the Hadoop job
+    for (int i = 0; i < k; i++)
+        printScorer(stdout, scorers[i], goal_rows, n_goal_rows, data_end);
+
+    // Print the teams, as the output of the Spark job
+    for (int i = 0; i < n_winners; i++)
+        if (wins[i] == max_wins && max_wins > 0)
+            printf("%s wins %d match/es with %d players\n", winner_team[i], max_wins, min_players);
+
+    // Write every scorer with all its goals, as the output of the first Hadoop job
+    if (scorers_path != NULL) {
+        FILE* fp = fopen(scorers_path, "w");
+        if (fp == NULL) {
+            perror("ERROR during the file opening.");
+            fprintf(stderr, "File %s can not be opened.\n", scorers_path);
+        } else {
+            for (int i = 0; i < n_scorers; i++)
+                printScorer(fp, scorers[i], goal_rows, n_goal_rows, data_end);
+            fclose(fp);
+        }
+    }
+
+    double report_time = omp_get_wtime() - report_start;
+    double execution_time = omp_get_wtime() - execution_start;
+
+    long long rows = 0;
+    for (int t = 0; t < n_threads; t++)
+        rows += states[t].rows;
+
+    // Print the timing information
+    printf("Native;%d;%lld;%06f;%06f;%06f;%06f;\n", n_threads, rows, parse_time, merge_time, report_time, execution_time);
+
+    // Free allocated memory
+    for (int t = 0; t < n_threads; t++) {
+        free(states[t].players.entries);
+        free(states[t].matches.entries);
+        free(states[t].goal_rows);
+        free(player_shards[t].entries);
+        free(match_shards[t].entries);
+    }
+    free(states);
+    free(player_shards);
+    free(match_shards);
+    free(winner_team);
+    free(winner_players);
+    free(wins);
+    free(scorers);
+    free(goal_rows);
+    unmapFile(&file);
+
+    return 0;
+}
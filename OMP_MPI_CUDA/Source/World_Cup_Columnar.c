@@ -0,0 +1,512 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "World_Cup_Columnar.h"
+
+/**
+ * @brief Dictionary under construction: open addressing table from strings to codes.
+ */
+typedef struct {
+    const char** string;   /**< First character of each distinct string, pointer into the CSV. */
+    int* length;           /**< Length of each distinct string. */
+    uint32_t* slot;        /**< Table of codes + 1 (0 if the slot is empty). */
+    uint32_t capacity;     /**< Size of the table, a power of 2. */
+    uint32_t count;        /**< Number of distinct strings. */
+    uint32_t pool_size;    /**< Bytes needed by the NUL-terminated strings. */
+} DictionaryBuilder;
+
+/**
+ * @brief A row of the CSV with the key used to sort the rows.
+ */
+typedef struct {
+    const char* start;   /**< First character of the row. */
+    int32_t match_id;    /**< MatchID of the row. */
+    uint32_t order;      /**< Position of the row in the CSV. */
+} RowKey;
+
+/**
+ * @brief Rounds a size up to a multiple of 8 bytes.
+ */
+static size_t align8(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+/**
+ * @brief Calculates the size of the blob of a columnar dataset with the sizes written in the header.
+ */
+static size_t blobSize(const ColumnarHeader* header) {
+    size_t size = align8(sizeof(ColumnarHeader));
+    size += (3 + DICTIONARIES) * align8(header->n_rows * sizeof(int32_t));
+    size += align8((header->n_rows + 1) * sizeof(uint32_t));
+    size += align8(header->n_events * sizeof(MatchEvent));
+    size += align8(header->n_matches * sizeof(int32_t));
+    size += align8((header->n_matches + 1) * sizeof(uint32_t));
+    size += align8(header->n_rows);
+    for (int d = 0; d < DICTIONARIES; d++) {
+        size += align8((header->n_entries[d] + 1) * sizeof(uint32_t));
+        size += align8(header->pool_size[d]);
+    }
+    return size;
+}
+
+/**
+ * @brief Sets the pointers of the columnar dataset to the columns of the blob, following the header.
+ */
+static void layoutColumns(WorldCupColumns* columns, void* blob, size_t size, int mapped) {
+    char* cursor = (char*)blob;
+    const ColumnarHeader* header = (const ColumnarHeader*)cursor;
+    cursor += align8(sizeof(ColumnarHeader));
+
+    columns->header = header;
+    columns->round_id = (const int32_t*)cursor;
+    cursor += align8(header->n_rows * sizeof(int32_t));
+    columns->match_id = (const int32_t*)cursor;
+    cursor += align8(header->n_rows * sizeof(int32_t));
+    columns->shirt_number = (const int32_t*)cursor;
+    cursor += align8(header->n_rows * sizeof(int32_t));
+    for (int d = 0; d < DICTIONARIES; d++) {
+        columns->code[d] = (const uint32_t*)cursor;
+        cursor += align8(header->n_rows * sizeof(uint32_t));
+    }
+    columns->event_start = (const uint32_t*)cursor;
+    cursor += align8((header->n_rows + 1) * sizeof(uint32_t));
+    columns->events = (const MatchEvent*)cursor;
+    cursor += align8(header->n_events * sizeof(MatchEvent));
+    columns->match_key = (const int32_t*)cursor;
+    cursor += align8(header->n_matches * sizeof(int32_t));
+    columns->match_start = (const uint32_t*)cursor;
+    cursor += align8((header->n_matches + 1) * sizeof(uint32_t));
+    columns->line_up = cursor;
+    cursor += align8(header->n_rows);
+    for (int d = 0; d < DICTIONARIES; d++) {
+        columns->dictionary[d].offset = (const uint32_t*)cursor;
+        cursor += align8((header->n_entries[d] + 1) * sizeof(uint32_t));
+        columns->dictionary[d].pool = cursor;
+        cursor += align8(header->pool_size[d]);
+    }
+
+    columns->blob = blob;
+    columns->blob_size = size;
+    columns->mapped = mapped;
+}
+
+/**
+ * @brief Returns the string of a dictionary code.
+ */
+const char* columnString(const WorldCupColumns* columns, int dictionary, uint32_t code) {
+    return columns->dictionary[dictionary].pool + columns->dictionary[dictionary].offset[code];
+}
+
+/**
+ * @brief Hash of a string (FNV-1a).
+ */
+static unsigned int hashString(const char* str, int length) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++)
+        hash = (hash ^ (unsigned char)str[i]) * 16777619u;
+    return hash;
+}
+
+/**
+ * @brief Initializes an empty dictionary able to hold up to max_strings strings.
+ */
+static int initDictionary(DictionaryBuilder* builder, uint32_t max_strings) {
+    builder->capacity = 16;
+    while (builder->capacity < 2 * max_strings)
+        builder->capacity *= 2;
+    builder->string = (const char**)malloc((max_strings + 1) * sizeof(const char*));
+    builder->length = (int*)malloc((max_strings + 1) * sizeof(int));
+    builder->slot = (uint32_t*)calloc(builder->capacity, sizeof(uint32_t));
+    builder->count = 0;
+    builder->pool_size = 0;
+    return (builder->string == NULL || builder->length == NULL || builder->slot == NULL) ? -1 : 0;
+}
+
+/**
+ * @brief Returns the code of a string, adding it to the dictionary if needed.
+ */
+static uint32_t encodeString(DictionaryBuilder* builder, const char* str, int length) {
+    uint32_t slot = hashString(str, length) & (builder->capacity - 1);
+    while (builder->slot[slot] != 0) {
+        uint32_t code = builder->slot[slot] - 1;
+        if (builder->length[code] == length && memcmp(builder->string[code], str, length) == 0)
+            return code;
+        slot = (slot + 1) & (builder->capacity - 1);
+    }
+
+    uint32_t code = builder->count++;
+    builder->string[code] = str;
+    builder->length[code] = length;
+    builder->pool_size += length + 1;
+    builder->slot[slot] = code + 1;
+    return code;
+}
+
+/**
+ * @brief Releases the memory of a dictionary under construction.
+ */
+static void freeDictionary(DictionaryBuilder* builder) {
+    free(builder->string);
+    free(builder->length);
+    free(builder->slot);
+}
+
+/**
+ * @brief Comparison function for qsort, ordering the rows by MatchID and then by position in the CSV.
+ */
+static int compareRowKeys(const void* a, const void* b) {
+    const RowKey* x = (const RowKey*)a;
+    const RowKey* y = (const RowKey*)b;
+    if (x->match_id != y->match_id)
+        return (x->match_id < y->match_id) ? -1 : 1;
+    return (x->order < y->order) ? -1 : (x->order > y->order);
+}
+
+/**
+ * @brief Counts the events (tokens separated by spaces) of an Event field.
+ */
+static uint32_t countEvents(const char* event, int length) {
+    uint32_t count = 0;
+    const char* end = event + length;
+    while (event < end) {
+        const char* next = findByte(event, end, ' ');
+        if (next > event)
+            count++;
+        event = next + 1;
+    }
+    return count;
+}
+
+/**
+ * @brief Parses the events of an Event field into typed events.
+ *
+ * Each token is a type letter followed by the minute ("G21'"); extra time ("G90+2'") is added
+ * to the minute.
+ *
+ * @return The number of events written.
+ */
+static uint32_t parseEvents(const char* event, int length, MatchEvent* events) {
+    uint32_t count = 0;
+    const char* end = event + length;
+    while (event < end) {
+        const char* next = findByte(event, end, ' ');
+        if (next > event) {
+            int minute = 0, part = 0;
+            for (const char* c = event + 1; c < next; c++) {
+                if (*c >= '0' && *c <= '9') {
+                    part = part * 10 + (*c - '0');
+                } else {
+                    minute += part;
+                    part = 0;
+                }
+            }
+            minute += part;
+
+            events[count].type = *event;
+            events[count].reserved = 0;
+            events[count].minute = (int16_t)minute;
+            count++;
+        }
+        event = next + 1;
+    }
+    return count;
+}
+
+/**
+ * @brief Converts the mapped CSV dataset to the columnar layout.
+ *
+ * @param csv     The mapped players dataset (the header line is skipped).
+ * @param columns The columnar dataset to build.
+ *
+ * @return        0 on success, -1 on allocation failure.
+ */
+int buildWorldCupColumns(const MappedFile* csv, WorldCupColumns* columns) {
+    const char* data_end = csv->data + csv->size;
+    const char* begin;
+    const char* end;
+    threadRowRange(csv, 0, 1, &begin, &end);
+
+    // First pass: keep the rows with a MatchID, with their sort key
+    uint32_t n_rows = 0, capacity = 1024, n_events = 0;
+    RowKey* keys = (RowKey*)malloc(capacity * sizeof(RowKey));
+    if (keys == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+
+    PlayerRow row;
+    while (begin < end) {
+        const char* row_start = begin;
+        begin = parseRow(begin, end, &row);
+        if (row.length[COLUMN_MATCH_ID] == 0)
+            continue;
+
+        if (n_rows == capacity) {
+            capacity *= 2;
+            RowKey* grown = (RowKey*)realloc(keys, capacity * sizeof(RowKey));
+            if (grown == NULL) {
+                fprintf(stderr, "ERROR in memory allocation.\n");
+                free(keys);
+                return -1;
+            }
+            keys = grown;
+        }
+        keys[n_rows].start = row_start;
+        keys[n_rows].match_id = fieldToInt(row.field[COLUMN_MATCH_ID], row.length[COLUMN_MATCH_ID]);
+        keys[n_rows].order = n_rows;
+        n_rows++;
+        n_events += countEvents(row.field[COLUMN_EVENT], row.length[COLUMN_EVENT]);
+    }
+
+    // Sort the rows by MatchID, keeping the order of the CSV within a match
+    qsort(keys, n_rows, sizeof(RowKey), compareRowKeys);
+
+    // Second pass: encode the string columns, in the order of the sorted rows
+    static const int encoded_column[DICTIONARIES] = { COLUMN_TEAM_INITIALS, COLUMN_COACH_NAME, COLUMN_PLAYER_NAME, COLUMN_POSITION };
+    DictionaryBuilder builder[DICTIONARIES];
+    uint32_t* codes = (uint32_t*)malloc((size_t)DICTIONARIES * (n_rows + 1) * sizeof(uint32_t));
+    int failed = (codes == NULL);
+    for (int d = 0; d < DICTIONARIES; d++)
+        failed |= initDictionary(&builder[d], n_rows);
+    if (failed) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        for (int d = 0; d < DICTIONARIES; d++)
+            freeDictionary(&builder[d]);
+        free(codes);
+        free(keys);
+        return -1;
+    }
+
+    ColumnarHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = COLUMNAR_MAGIC;
+    header.version = COLUMNAR_VERSION;
+    header.n_rows = n_rows;
+    header.n_events = n_events;
+
+    for (uint32_t r = 0; r < n_rows; r++) {
+        parseRow(keys[r].start, data_end, &row);
+        for (int d = 0; d < DICTIONARIES; d++)
+            codes[(size_t)d * n_rows + r] = encodeString(&builder[d], row.field[encoded_column[d]], row.length[encoded_column[d]]);
+        if (r == 0 || keys[r].match_id != keys[r - 1].match_id)
+            header.n_matches++;
+    }
+    for (int d = 0; d < DICTIONARIES; d++) {
+        header.n_entries[d] = builder[d].count;
+        header.pool_size[d] = builder[d].pool_size;
+    }
+
+    // Allocate the blob and fill the columns
+    size_t size = blobSize(&header);
+    void* blob = calloc(1, size);
+    if (blob == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        for (int d = 0; d < DICTIONARIES; d++)
+            freeDictionary(&builder[d]);
+        free(codes);
+        free(keys);
+        return -1;
+    }
+    memcpy(blob, &header, sizeof(header));
+    layoutColumns(columns, blob, size, 0);
+
+    int32_t* round_id = (int32_t*)columns->round_id;
+    int32_t* match_id = (int32_t*)columns->match_id;
+    int32_t* shirt_number = (int32_t*)columns->shirt_number;
+    uint32_t* event_start = (uint32_t*)columns->event_start;
+    MatchEvent* events = (MatchEvent*)columns->events;
+    int32_t* match_key = (int32_t*)columns->match_key;
+    uint32_t* match_start = (uint32_t*)columns->match_start;
+    char* line_up = (char*)columns->line_up;
+
+    uint32_t event = 0, match = 0;
+    for (uint32_t r = 0; r < n_rows; r++) {
+        parseRow(keys[r].start, data_end, &row);
+        round_id[r] = fieldToInt(row.field[COLUMN_ROUND_ID], row.length[COLUMN_ROUND_ID]);
+        match_id[r] = keys[r].match_id;
+        shirt_number[r] = fieldToInt(row.field[COLUMN_SHIRT_NUMBER], row.length[COLUMN_SHIRT_NUMBER]);
+        line_up[r] = row.length[COLUMN_LINE_UP] > 0 ? row.field[COLUMN_LINE_UP][0] : ' ';
+        for (int d = 0; d < DICTIONARIES; d++)
+            ((uint32_t*)columns->code[d])[r] = codes[(size_t)d * n_rows + r];
+
+        event_start[r] = event;
+        event += parseEvents(row.field[COLUMN_EVENT], row.length[COLUMN_EVENT], events + event);
+
+        if (r == 0 || keys[r].match_id != keys[r - 1].match_id) {
+            match_key[match] = keys[r].match_id;
+            match_start[match] = r;
+            match++;
+        }
+    }
+    event_start[n_rows] = event;
+    match_start[header.n_matches] = n_rows;
+
+    // Write the dictionaries
+    for (int d = 0; d < DICTIONARIES; d++) {
+        uint32_t* offset = (uint32_t*)columns->dictionary[d].offset;
+        char* pool = (char*)columns->dictionary[d].pool;
+        uint32_t position = 0;
+        for (uint32_t code = 0; code < builder[d].count; code++) {
+            offset[code] = position;
+            memcpy(pool + position, builder[d].string[code], builder[d].length[code]);
+            position += builder[d].length[code];
+            pool[position++] = '\0';
+        }
+        offset[builder[d].count] = position;
+    }
+
+    // Free allocated memory
+    for (int d = 0; d < DICTIONARIES; d++)
+        freeDictionary(&builder[d]);
+    free(codes);
+    free(keys);
+
+    return 0;
+}
+
+/**
+ * @brief Writes the columnar dataset to a file.
+ *
+ * @param columns The columnar dataset.
+ * @param path    Path of the file.
+ *
+ * @return        0 on success, -1 if the file cannot be written.
+ */
+int saveWorldCupColumns(const WorldCupColumns* columns, const char* path) {
+    FILE* fp = fopen(path, "wb");
+
+    // Check if the file can be opened
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", path);
+        return -1;
+    }
+
+    size_t written = fwrite(columns->blob, 1, columns->blob_size, fp);
+    fclose(fp);
+
+    if (written != columns->blob_size) {
+        fprintf(stderr, "ERROR while writing %s.\n", path);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Loads a columnar file with mmap.
+ *
+ * @param path    Path of the file.
+ * @param columns The columnar dataset to fill.
+ *
+ * @return        0 on success, -1 if the file cannot be mapped or is not a valid columnar file.
+ */
+int loadWorldCupColumns(const char* path, WorldCupColumns* columns) {
+    int fd = open(path, O_RDONLY);
+
+    // Check if the file can be opened
+    if (fd < 0) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", path);
+        return -1;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(ColumnarHeader)) {
+        fprintf(stderr, "File %s is not a valid columnar file.\n", path);
+        close(fd);
+        return -1;
+    }
+
+    void* blob = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (blob == MAP_FAILED) {
+        perror("ERROR during the file mapping.");
+        return -1;
+    }
+
+    // Validate the header before trusting the sizes
+    const ColumnarHeader* header = (const ColumnarHeader*)blob;
+    if (header->magic != COLUMNAR_MAGIC || header->version != COLUMNAR_VERSION ||
+        blobSize(header) != (size_t)info.st_size) {
+        fprintf(stderr, "File %s is not a valid columnar file.\n", path);
+        munmap(blob, info.st_size);
+        return -1;
+    }
+
+    layoutColumns(columns, blob, info.st_size, 1);
+
+    // Queries read few columns, in order
+    madvise(blob, info.st_size, MADV_SEQUENTIAL);
+
+    return 0;
+}
+
+/**
+ * @brief Releases the memory (or the mapping) of the columnar dataset.
+ *
+ * @param columns The columnar dataset.
+ */
+void freeWorldCupColumns(WorldCupColumns* columns) {
+    if (columns->mapped)
+        munmap(columns->blob, columns->blob_size);
+    else
+        free(columns->blob);
+    columns->blob = NULL;
+}
+
+/**
+ * @brief Finds the rows of a match with a binary search on the MatchIDs.
+ *
+ * @param columns  The columnar dataset.
+ * @param match_id The MatchID.
+ * @param first    Output parameter: first row of the match.
+ * @param last     Output parameter: end of the rows of the match.
+ *
+ * @return         1 if the match exists, 0 otherwise.
+ */
+int findMatchRows(const WorldCupColumns* columns, int32_t match_id, uint32_t* first, uint32_t* last) {
+    uint32_t low = 0, high = columns->header->n_matches;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (columns->match_key[middle] < match_id)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    if (low == columns->header->n_matches || columns->match_key[low] != match_id)
+        return 0;
+
+    *first = columns->match_start[low];
+    *last = columns->match_start[low + 1];
+    return 1;
+}
@@ -0,0 +1,155 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#ifndef WORLD_CUP_COLUMNAR_H
+#define WORLD_CUP_COLUMNAR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "World_Cup_Dataset.h"
+
+//Magic number at the beginning of a columnar file ("WCCL")
+#define COLUMNAR_MAGIC 0x4C434357
+//Version of the columnar file layout
+#define COLUMNAR_VERSION 1
+
+//Dictionary-encoded columns
+#define DICTIONARY_TEAM 0
+#define DICTIONARY_COACH 1
+#define DICTIONARY_PLAYER 2
+#define DICTIONARY_POSITION 3
+#define DICTIONARIES 4
+
+/**
+ * @brief Header of the columnar dataset, at the beginning of the on-disk file.
+ *
+ * The header is followed by the columns, in the order of the fields of WorldCupColumns, so the
+ * file can be used directly from an mmap without any parsing.
+ */
+typedef struct {
+    uint32_t magic;                       /**< COLUMNAR_MAGIC. */
+    uint32_t version;                     /**< COLUMNAR_VERSION. */
+    uint32_t n_rows;                      /**< Number of rows. */
+    uint32_t n_events;                    /**< Number of events of all the rows. */
+    uint32_t n_matches;                   /**< Number of distinct MatchIDs. */
+    uint32_t n_entries[DICTIONARIES];     /**< Number of distinct strings of each dictionary. */
+    uint32_t pool_size[DICTIONARIES];     /**< Size in bytes of the pool of each dictionary. */
+    uint32_t reserved;                    /**< Padding, keeps the columns 8-byte aligned. */
+} ColumnarHeader;
+
+/**
+ * @brief An event of a player, pre-parsed from the Event field ("G21'" is type 'G', minute 21).
+ */
+typedef struct {
+    char type;        /**< Type of the event (G goal, P penalty, W own goal, R red card, Y yellow card, ...). */
+    char reserved;    /**< Padding. */
+    int16_t minute;   /**< Minute of the event. */
+} MatchEvent;
+
+/**
+ * @brief A dictionary: string i is pool + offset[i], NUL-terminated.
+ */
+typedef struct {
+    const uint32_t* offset;  /**< Offset of each string in the pool (n_entries + 1 entries). */
+    const char* pool;        /**< The strings, NUL-terminated. */
+} ColumnDictionary;
+
+/**
+ * @brief The players dataset stored by columns, with the rows sorted by MatchID.
+ *
+ * The events of row r are the range [event_start[r], event_start[r + 1]) of events. The rows of
+ * the i-th match (in increasing MatchID order) are the range [match_start[i], match_start[i + 1]).
+ */
+typedef struct {
+    const ColumnarHeader* header;                  /**< Header of the file. */
+    const int32_t* round_id;                       /**< RoundID of each row. */
+    const int32_t* match_id;                       /**< MatchID of each row. */
+    const int32_t* shirt_number;                   /**< Shirt Number of each row. */
+    const uint32_t* code[DICTIONARIES];            /**< Dictionary code of each row, for each encoded column. */
+    const uint32_t* event_start;                   /**< First event of each row (n_rows + 1 entries). */
+    const MatchEvent* events;                      /**< Events of all the rows. */
+    const int32_t* match_key;                      /**< Distinct MatchIDs, in increasing order. */
+    const uint32_t* match_start;                   /**< First row of each match (n_matches + 1 entries). */
+    const char* line_up;                           /**< Line-up of each row ('S' starter, 'N' substitute). */
+    ColumnDictionary dictionary[DICTIONARIES];     /**< Strings of the encoded columns. */
+    void* blob;                                    /**< Memory holding the whole dataset. */
+    size_t blob_size;                              /**< Size of the blob in bytes. */
+    int mapped;                                    /**< 1 if the blob is an mmap of a file, 0 if allocated. */
+} WorldCupColumns;
+
+/**
+ * @brief Converts the mapped CSV dataset to the columnar layout.
+ *
+ * @param csv     The mapped players dataset (the header line is skipped).
+ * @param columns The columnar dataset to build.
+ *
+ * @return        0 on success, -1 on allocation failure.
+ */
+int buildWorldCupColumns(const MappedFile* csv, WorldCupColumns* columns);
+
+/**
+ * @brief Writes the columnar dataset to a file.
+ *
+ * @param columns The columnar dataset.
+ * @param path    Path of the file.
+ *
+ * @return        0 on success, -1 if the file cannot be written.
+ */
+int saveWorldCupColumns(const WorldCupColumns* columns, const char* path);
+
+/**
+ * @brief Loads a columnar file with mmap.
+ *
+ * @param path    Path of the file.
+ * @param columns The columnar dataset to fill.
+ *
+ * @return        0 on success, -1 if the file cannot be mapped or is not a valid columnar file.
+ */
+int loadWorldCupColumns(const char* path, WorldCupColumns* columns);
+
+/**
+ * @brief Releases the memory (or the mapping) of the columnar dataset.
+ *
+ * @param columns The columnar dataset.
+ */
+void freeWorldCupColumns(WorldCupColumns* columns);
+
+/**
+ * @brief Returns the string of a dictionary code.
+ */
+const char* columnString(const WorldCupColumns* columns, int dictionary, uint32_t code);
+
+/**
+ * @brief Finds the rows of a match with a binary search on the MatchIDs.
+ *
+ * @param columns  The columnar dataset.
+ * @param match_id The MatchID.
+ * @param first    Output parameter: first row of the match.
+ * @param last     Output parameter: end of the rows of the match.
+ *
+ * @return         1 if the match exists, 0 otherwise.
+ */
+int findMatchRows(const WorldCupColumns* columns, int32_t match_id, uint32_t* first, uint32_t* last);
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "World_Cup_Dataset.h"
+
+/**
+ * @brief Finds the first comma or newline in [begin, end), 16 bytes at a time with SSE2.
+ *
+ * @return The position of the delimiter, or end if there is none.
+ */
+const char* findDelimiter(const char* begin, const char* end) {
+#ifdef __SSE2__
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    // Compare 16 bytes with both delimiters at once
+    while (end - begin >= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)begin);
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, comma), _mm_cmpeq_epi8(block, newline));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0)
+            return begin + __builtin_ctz(mask);
+        begin += 16;
+    }
+#endif
+
+    // Scalar tail (or fallback without SSE2)
+    while (begin < end && *begin != ',' && *begin != '\n')
+        begin++;
+
+    return begin;
+}
+
+/**
+ * @brief Finds the first occurrence of a byte in [begin, end), 16 bytes at a time with SSE2.
+ *
+ * @return The position of the byte, or end if there is none.
+ */
+const char* findByte(const char* begin, const char* end, char c) {
+#ifdef __SSE2__
+    const __m128i target = _mm_set1_epi8(c);
+
+    while (end - begin >= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)begin);
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, target));
+        if (mask != 0)
+            return begin + __builtin_ctz(mask);
+        begin += 16;
+    }
+#endif
+
+    while (begin < end && *begin != c)
+        begin++;
+
+    return begin;
+}
+
+/**
+ * @brief Splits the row starting at begin into its fields.
+ *
+ * @param begin First character of the row.
+ * @param end   End of the data.
+ * @param row   The row to fill.
+ *
+ * @return      The first character of the next row.
+ */
+const char* parseRow(const char* begin, const char* end, PlayerRow* row) {
+    int column = 0;
+    const char* cursor = begin;
+
+    while (1) {
+        const char* delimiter = findDelimiter(cursor, end);
+
+        if (column < WORLD_CUP_COLUMNS) {
+            row->field[column] = cursor;
+            row->length[column] = (int)(delimiter - cursor);
+            column++;
+        }
+
+        // End of the row (or of the data)
+        if (delimiter == end || *delimiter == '\n') {
+            // Drop the carriage return of CRLF files
+            if (column > 0 && row->length[column - 1] > 0 && row->field[column - 1][row->length[column - 1] - 1] == '\r')
+                row->length[column - 1]--;
+
+            // Missing fields are empty
+            for (; column < WORLD_CUP_COLUMNS; column++) {
+                row->field[column] = delimiter;
+                row->length[column] = 0;
+            }
+
+            return (delimiter == end) ? end : delimiter + 1;
+        }
+
+        cursor = delimiter + 1;
+    }
+}
+
+/**
+ * @brief Calculates the range of rows parsed by a thread.
+ *
+ * The data after the header line is split in equal byte ranges, each moved forward to the
+ * beginning of a row, so every row belongs to exactly one thread and the ranges follow the
+ * order of the file.
+ *
+ * @param file      The mapped dataset.
+ * @param id        The index of the thread.
+ * @param n_id      The total number of threads.
+ * @param begin     Output parameter: first row of the range.
+ * @param end       Output parameter: end of the range.
+ */
+void threadRowRange(const MappedFile* file, int id, int n_id, const char** begin, const char** end) {
+    const char* data_end = file->data + file->size;
+
+    // Skip the header line
+    const char* start = findByte(file->data, data_end, '\n');
+    if (start < data_end)
+        start++;
+
+    splitRowRange(start, data_end, id, n_id, begin, end);
+}
+
+/**
+ * @brief Calculates the range of rows parsed by a thread in a part of the data.
+ *
+ * Like threadRowRange(), but on the rows in [start, data_end): start must be the beginning of
+ * a row (e.g. the end of the rows already parsed by a previous run).
+ *
+ * @param start     First row of the data to split.
+ * @param data_end  End of the data.
+ * @param id        The index of the thread.
+ * @param n_id      The total number of threads.
+ * @param begin     Output parameter: first row of the range.
+ * @param end       Output parameter: end of the range.
+ */
+void splitRowRange(const char* start, const char* data_end, int id, int n_id, const char** begin, const char** end) {
+    size_t len = data_end - start;
+
+    // Calculate the lengths and starting points of local sections of work
+    size_t local_len = len / n_id;
+    size_t remaining = len % n_id;
+    size_t local_start = id * local_len + ((size_t)id < remaining ? (size_t)id : remaining);
+    size_t local_stop = local_start + local_len + ((size_t)id < remaining ? 1 : 0);
+
+    // Move both ends to the beginning of a row
+    const char* first = start + local_start;
+    const char* last = start + local_stop;
+    if (id > 0 && first[-1] != '\n') {
+        first = findByte(first, data_end, '\n');
+        if (first < data_end)
+            first++;
+    }
+    if (last < data_end && last[-1] != '\n') {
+        last = findByte(last, data_end, '\n');
+        if (last < data_end)
+            last++;
+    }
+
+    *begin = first;
+    *end = (last > first) ? last : first;
+}
+
+/**
+ * @brief Parses a non-negative integer field.
+ */
+int fieldToInt(const char* field, int length) {
+    int value = 0;
+    for (int i = 0; i < length && field[i] >= '0' && field[i] <= '9'; i++)
+        value = value * 10 + (field[i] - '0');
+    return value;
+}
@@ -0,0 +1,113 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#ifndef WORLD_CUP_DATASET_H
+#define WORLD_CUP_DATASET_H
+
+#include <stddef.h>
+#include "Mapped_File.h"
+
+//Number of columns of the players dataset
+#define WORLD_CUP_COLUMNS 9
+
+//Columns of the players dataset
+#define COLUMN_ROUND_ID 0
+#define COLUMN_MATCH_ID 1
+#define COLUMN_TEAM_INITIALS 2
+#define COLUMN_COACH_NAME 3
+#define COLUMN_LINE_UP 4
+#define COLUMN_SHIRT_NUMBER 5
+#define COLUMN_PLAYER_NAME 6
+#define COLUMN_POSITION 7
+#define COLUMN_EVENT 8
+
+/**
+ * @brief A row of the players dataset, as pointers into the mapped file (nothing is copied).
+ */
+typedef struct {
+    const char* field[WORLD_CUP_COLUMNS];  /**< First character of each field. */
+    int length[WORLD_CUP_COLUMNS];         /**< Length of each field (0 for missing fields). */
+} PlayerRow;
+
+/**
+ * @brief Finds the first comma or newline in [begin, end), 16 bytes at a time with SSE2.
+ *
+ * @return The position of the delimiter, or end if there is none.
+ */
+const char* findDelimiter(const char* begin, const char* end);
+
+/**
+ * @brief Finds the first occurrence of a byte in [begin, end), 16 bytes at a time with SSE2.
+ *
+ * @return The position of the byte, or end if there is none.
+ */
+const char* findByte(const char* begin, const char* end, char c);
+
+/**
+ * @brief Splits the row starting at begin into its fields.
+ *
+ * @param begin First character of the row.
+ * @param end   End of the data.
+ * @param row   The row to fill.
+ *
+ * @return      The first character of the next row.
+ */
+const char* parseRow(const char* begin, const char* end, PlayerRow* row);
+
+/**
+ * @brief Calculates the range of rows parsed by a thread.
+ *
+ * The data after the header line is split in equal byte ranges, each moved forward to the
+ * beginning of a row, so every row belongs to exactly one thread and the ranges follow the
+ * order of the file.
+ *
+ * @param file      The mapped dataset.
+ * @param id        The index of the thread.
+ * @param n_id      The total number of threads.
+ * @param begin     Output parameter: first row of the range.
+ * @param end       Output parameter: end of the range.
+ */
+void threadRowRange(const MappedFile* file, int id, int n_id, const char** begin, const char** end);
+
+/**
+ * @brief Calculates the range of rows parsed by a thread in a part of the data.
+ *
+ * Like threadRowRange(), but on the rows in [start, data_end): start must be the beginning of
+ * a row (e.g. the end of the rows already parsed by a previous run).
+ *
+ * @param start     First row of the data to split.
+ * @param data_end  End of the data.
+ * @param id        The index of the thread.
+ * @param n_id      The total number of threads.
+ * @param begin     Output parameter: first row of the range.
+ * @param end       Output parameter: end of the range.
+ */
+void splitRowRange(const char* start, const char* data_end, int id, int n_id, const char** begin, const char** end);
+
+/**
+ * @brief Parses a non-negative integer field.
+ */
+int fieldToInt(const char* field, int length);
+
+#endif
@@ -0,0 +1,585 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <omp.h>
+#include "World_Cup_Dataset.h"
+//Initial capacity of the hash table of the players and of the goal lists of the threads
+#define INITIAL_CAPACITY 1024
+//States of a slot of the concurrent hash table
+#define SLOT_EMPTY 0
+#define SLOT_BUSY 1
+#define SLOT_READY 2
+
+/**
+ * @brief Goals scored by a player, as a slot of the concurrent hash table.
+ */
+typedef struct {
+    const char* name;   /**< Name of the player, pointer into the mapped file or into the snapshot. */
+    int length;         /**< Length of the name. */
+    unsigned int hash;  /**< Hash of the name. */
+    int goals;          /**< Number of goals and penalties scored. */
+    int state;          /**< SLOT_EMPTY, SLOT_BUSY while the name is written, SLOT_READY. */
+    int dirty;          /**< 1 if the goals changed in this run. */
+    int heap_index;     /**< Position in the heap of the top-k scorers (-1 if the player is not in the top-k). */
+} PlayerEntry;
+
+/**
+ * @brief Open addressing hash table of players, keyed by name, sized before the parallel updates (it never grows while they run).
+ */
+typedef struct {
+    PlayerEntry* entries;
+    int capacity;
+    int count;
+} PlayerTable;
+
+/**
+ * @brief Goals scored by a player in a row of the appended data.
+ */
+typedef struct {
+    const char* name;
+    int length;
+    unsigned int hash;
+    int goals;
+} GoalEvent;
+
+/**
+ * @brief State of each thread: the goals of its rows and the players it changed.
+ */
+typedef struct {
+    GoalEvent* events;
+    long long n_events;
+    long long events_capacity;
+    int* dirty;
+    long long n_dirty;
+    long long rows;
+} ThreadState;
+
+/**
+ * @brief Indexed min-heap of the top-k scorers: the root is the worst of them, and each entry knows its position.
+ */
+typedef struct {
+    int* slots;  /**< Slots of the table of players, in heap order. */
+    int size;
+    int k;
+} ScorerHeap;
+
+/**
+ * @brief Hash of a name (FNV-1a).
+ */
+static unsigned int hashName(const char* name, int length) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++)
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    return hash;
+}
+
+/**
+ * @brief Orders two players: more goals first, then alphabetical order of the name.
+ */
+static int compareEntries(const PlayerEntry* x, const PlayerEntry* y) {
+    if (x->goals != y->goals)
+        return y->goals - x->goals;
+    int shortest = (x->length < y->length) ? x->length : y->length;
+    int result = memcmp(x->name, y->name, shortest);
+    return (result != 0) ? result : x->length - y->length;
+}
+
+/**
+ * @brief Comparison function for qsort, on pointers to players.
+ */
+static int compareScorers(const void* a, const void* b) {
+    return compareEntries(*(const PlayerEntry* const*)a, *(const PlayerEntry* const*)b);
+}
+
+/**
+ * @brief Comparison function for qsort: positions of the heap in decreasing order.
+ */
+static int compareDescending(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x < y) - (x > y);
+}
+
+/**
+ * @brief Initializes an empty table of players with a power of two capacity of at least 2 * n_players slots.
+ */
+static void initPlayerTable(PlayerTable* table, long long n_players) {
+    long long capacity = INITIAL_CAPACITY;
+    while (capacity < 2 * n_players)
+        capacity *= 2;
+
+    table->entries = (PlayerEntry*)calloc(capacity, sizeof(PlayerEntry));
+    table->capacity = (int)capacity;
+    table->count = 0;
+    if (table->entries == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Adds goals to a player, inserting the player if needed. It can be called by many threads at the same time.
+ *
+ * An empty slot is claimed with a compare-and-swap, and the other threads wait for its name
+ * before comparing it; the goals are added atomically. The first thread that changes a player
+ * appends its slot to its own list of dirty players.
+ *
+ * @return The slot of the player.
+ */
+static int addPlayerGoals(PlayerTable* table, const char* name, int length, unsigned int hash, int goals, ThreadState* state) {
+    int slot = hash & (table->capacity - 1);
+    while (1) {
+        PlayerEntry* entry = &table->entries[slot];
+
+        // Claim an empty slot for the player
+        if (__atomic_load_n(&entry->state, __ATOMIC_ACQUIRE) == SLOT_EMPTY &&
+            __sync_bool_compare_and_swap(&entry->state, SLOT_EMPTY, SLOT_BUSY)) {
+            entry->name = name;
+            entry->length = length;
+            entry->hash = hash;
+            entry->heap_index = -1;
+            __atomic_store_n(&entry->state, SLOT_READY, __ATOMIC_RELEASE);
+            #pragma omp atomic update
+            table->count++;
+        }
+
+        // Wait for the name of a slot claimed by another thread
+        while (__atomic_load_n(&entry->state, __ATOMIC_ACQUIRE) == SLOT_BUSY)
+            ;
+
+        if (entry->hash == hash && entry->length == length && memcmp(entry->name, name, length) == 0) {
+            #pragma omp atomic update
+            entry->goals += goals;
+            if (state != NULL && __sync_bool_compare_and_swap(&entry->dirty, 0, 1))
+                state->dirty[state->n_dirty++] = slot;
+            return slot;
+        }
+        slot = (slot + 1) & (table->capacity - 1);
+    }
+}
+
+/**
+ * @brief Swaps two positions of the heap, updating the positions stored in the players.
+ */
+static void swapHeap(ScorerHeap* heap, PlayerTable* table, int i, int j) {
+    int slot = heap->slots[i];
+    heap->slots[i] = heap->slots[j];
+    heap->slots[j] = slot;
+    table->entries[heap->slots[i]].heap_index = i;
+    table->entries[heap->slots[j]].heap_index = j;
+}
+
+/**
+ * @brief Moves a player up the heap while it is worse than its parent.
+ */
+static void siftUp(ScorerHeap* heap, PlayerTable* table, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (compareEntries(&table->entries[heap->slots[i]], &table->entries[heap->slots[parent]]) <= 0)
+            break;
+        swapHeap(heap, table, i, parent);
+        i = parent;
+    }
+}
+
+/**
+ * @brief Moves a player down the heap while one of its children is worse.
+ */
+static void siftDown(ScorerHeap* heap, PlayerTable* table, int i) {
+    while (1) {
+        int worst = i;
+        for (int child = 2 * i + 1; child <= 2 * i + 2 && child < heap->size; child++)
+            if (compareEntries(&table->entries[heap->slots[child]], &table->entries[heap->slots[worst]]) > 0)
+                worst = child;
+        if (worst == i)
+            return;
+        swapHeap(heap, table, i, worst);
+        i = worst;
+    }
+}
+
+/**
+ * @brief Offers a player that is not in the heap: it enters if the heap is not full or if it is better than the root.
+ */
+static void offerScorer(ScorerHeap* heap, PlayerTable* table, int slot) {
+    PlayerEntry* entry = &table->entries[slot];
+    if (heap->size < heap->k) {
+        heap->slots[heap->size] = slot;
+        entry->heap_index = heap->size++;
+        siftUp(heap, table, entry->heap_index);
+    } else if (heap->size > 0 && compareEntries(entry, &table->entries[heap->slots[0]]) < 0) {
+        table->entries[heap->slots[0]].heap_index = -1;
+        heap->slots[0] = slot;
+        entry->heap_index = 0;
+        siftDown(heap, table, 0);
+    }
+}
+
+/**
+ * @brief Updates the top-k scorers after the goals of some players increased.
+ *
+ * Goals never decrease, so a player out of the heap that did not change cannot enter it. The
+ * changed players in the heap (of the lists of all the threads) are moved down first, from the
+ * bottom of the heap to the top (as in the construction of a heap, each of them is moved into
+ * subtrees that are already valid), and only then the changed players out of the heap are
+ * offered, with O(log k) work for each of them: the root must be the worst of the top-k before
+ * a player is compared with it, so no list can be offered before all the lists are moved.
+ */
+static void updateScorers(ScorerHeap* heap, PlayerTable* table, const ThreadState* states, int n_threads) {
+    int* positions = (int*)malloc((heap->size + 1) * sizeof(int));
+    if (positions == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Each player is in the list of one thread only, so there is a position for each player in the heap
+    int n_positions = 0;
+    for (int t = 0; t < n_threads; t++)
+        for (long long i = 0; i < states[t].n_dirty; i++)
+            if (table->entries[states[t].dirty[i]].heap_index >= 0)
+                positions[n_positions++] = table->entries[states[t].dirty[i]].heap_index;
+    qsort(positions, n_positions, sizeof(int), compareDescending);
+    for (int i = 0; i < n_positions; i++)
+        siftDown(heap, table, positions[i]);
+
+    for (int t = 0; t < n_threads; t++)
+        for (long long i = 0; i < states[t].n_dirty; i++)
+            if (table->entries[states[t].dirty[i]].heap_index < 0)
+                offerScorer(heap, table, states[t].dirty[i]);
+
+    free(positions);
+}
+
+/**
+ * @brief Collects the goals of one row into the local state of the thread (goals (G) and penalties (P) count).
+ */
+static void collectRow(ThreadState* state, const PlayerRow* row) {
+    if (row->length[COLUMN_MATCH_ID] == 0)
+        return;
+
+    state->rows++;
+
+    // Scan the events, separated by spaces
+    int goals = 0;
+    const char* event = row->field[COLUMN_EVENT];
+    const char* events_end = event + row->length[COLUMN_EVENT];
+    while (event < events_end) {
+        const char* next = findByte(event, events_end, ' ');
+        if (next > event && (*event == 'G' || *event == 'P'))
+            goals++;
+        event = next + 1;
+    }
+
+    if (goals == 0)
+        return;
+
+    if (state->n_events == state->events_capacity) {
+        state->events_capacity = state->events_capacity > 0 ? 2 * state->events_capacity : INITIAL_CAPACITY;
+        state->events = (GoalEvent*)realloc(state->events, state->events_capacity * sizeof(GoalEvent));
+        if (state->events == NULL) {
+            fprintf(stderr, "ERROR in memory allocation.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    GoalEvent* goal = &state->events[state->n_events++];
+    goal->name = row->field[COLUMN_PLAYER_NAME];
+    goal->length = row->length[COLUMN_PLAYER_NAME];
+    goal->hash = hashName(goal->name, goal->length);
+    goal->goals = goals;
+}
+
+/**
+ * @brief Reads a whole file in memory, terminated by '\0'.
+ *
+ * @return The content of the file (to be freed), or NULL if the file cannot be read.
+ */
+static char* readFile(const char* path, long* size) {
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL)
+        return NULL;
+
+    fseek(fp, 0, SEEK_END);
+    *size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    char* data = (char*)malloc(*size + 1);
+    if (data == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (fread(data, 1, *size, fp) != (size_t)*size)
+        *size = 0;
+    data[*size] = '\0';
+    fclose(fp);
+    return data;
+}
+
+/**
+ * @brief Writes the snapshot of the state: the bytes of the dataset already parsed, the players and the top-k.
+ *
+ * The first line is "offset;players;k;heap_size", then each player is a line "goals;name", with
+ * the players of the heap first, in heap order, so the next run restores the heap without work.
+ * The snapshot is written to a temporary file and renamed, so a crash never leaves it half written.
+ *
+ * @return 0 on success, -1 if the snapshot cannot be written.
+ */
+static int saveSnapshot(const char* path, size_t offset, const PlayerTable* table, const ScorerHeap* heap) {
+    char* temp_path = (char*)malloc(strlen(path) + 5);
+    if (temp_path == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        exit(EXIT_FAILURE);
+    }
+    sprintf(temp_path, "%s.tmp", path);
+
+    FILE* fp = fopen(temp_path, "w");
+    if (fp == NULL) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", temp_path);
+        free(temp_path);
+        return -1;
+    }
+
+    fprintf(fp, "%zu;%d;%d;%d\n", offset, table->count, heap->k, heap->size);
+    for (int i = 0; i < heap->size; i++) {
+        const PlayerEntry* entry = &table->entries[heap->slots[i]];
+        fprintf(fp, "%d;%.*s\n", entry->goals, entry->length, entry->name);
+    }
+    for (int i = 0; i < table->capacity; i++) {
+        const PlayerEntry* entry = &table->entries[i];
+        if (entry->state == SLOT_READY && entry->heap_index < 0)
+            fprintf(fp, "%d;%.*s\n", entry->goals, entry->length, entry->name);
+    }
+
+    int result = (fclose(fp) == 0 && rename(temp_path, path) == 0) ? 0 : -1;
+    if (result != 0)
+        perror("ERROR during the snapshot writing.");
+    free(temp_path);
+    return result;
+}
+
+/**
+ * @brief Main function for the incremental top-k scorers of the World Cup dataset.
+ *
+ * This program keeps the goals of every player in a snapshot on disk, together with the number
+ * of bytes of the dataset already parsed, so when new matches are appended to the dataset only
+ * the new rows are read. The rows are parsed in parallel (each OpenMP thread takes a range of
+ * them), then all the threads add their goals to a shared hash table, sized for the new players
+ * before they start, claiming the slots with compare-and-swap. The top-k scorers are kept in an
+ * indexed heap, so only the players whose goals changed are moved: with the hash table loaded,
+ * an update costs O(rows added * log k) instead of a rescan of the whole dataset. It prints the
+ * top-k scorers with their goals, in the order of the Hadoop job, and the last line contains the
+ * timing information.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    // Check if the correct number of command line arguments is provided
+    if (argc != 5) {
+        fprintf(stderr, "Usage: %s <players_csv> <snapshot_file> <k> <n_threads>\n", argv[0]);
+        return 1;
+    }
+
+    // Parse command line arguments
+    char* csv_path = argv[1];
+    char* snapshot_path = argv[2];
+    int k = atoi(argv[3]);
+    int n_threads = atoi(argv[4]);
+
+    // Set the number of OpenMP threads
+    omp_set_num_threads(n_threads);
+
+    double execution_start = omp_get_wtime();
+
+    // Read the snapshot of the previous run, if there is one
+    long snapshot_size = 0;
+    char* snapshot = readFile(snapshot_path, &snapshot_size);
+    if (snapshot == NULL && errno != ENOENT) {
+        perror("ERROR during the file opening.");
+        fprintf(stderr, "File %s can not be opened.\n", snapshot_path);
+        return 1;
+    }
+    size_t offset = 0;
+    int n_players = 0, snapshot_k = 0, heap_size = 0;
+    char* cursor = snapshot;
+    if (snapshot != NULL) {
+        int header_length = 0;
+        if (sscanf(snapshot, "%zu;%d;%d;%d\n%n", &offset, &n_players, &snapshot_k, &heap_size, &header_length) != 4 || header_length == 0) {
+            fprintf(stderr, "File %s is not a snapshot.\n", snapshot_path);
+            return 1;
+        }
+        cursor += header_length;
+    }
+
+    // Map the dataset
+    MappedFile file;
+    if (mapFile(csv_path, &file) != 0)
+        return 1;
+    const char* data_end = file.data + file.size;
+    if (file.size < offset) {
+        fprintf(stderr, "File %s is shorter than the %zu bytes parsed in %s.\n", csv_path, offset, snapshot_path);
+        return 1;
+    }
+
+    // The first run skips the header line, the next ones start after the rows already parsed
+    const char* start = file.data + offset;
+    if (offset == 0) {
+        start = findByte(file.data, data_end, '\n');
+        if (start < data_end)
+            start++;
+    }
+
+    ThreadState* states = (ThreadState*)calloc(n_threads, sizeof(ThreadState));
+    if (states == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+
+    double parse_start = omp_get_wtime();
+
+    // Parse the appended rows and collect their goals
+    #pragma omp parallel num_threads(n_threads)
+    {
+        ThreadState* state = &states[omp_get_thread_num()];
+
+        const char* begin;
+        const char* end;
+        splitRowRange(start, data_end, omp_get_thread_num(), n_threads, &begin, &end);
+
+        PlayerRow row;
+        while (begin < end) {
+            begin = parseRow(begin, end, &row);
+            collectRow(state, &row);
+        }
+
+        state->dirty = (int*)malloc((state->n_events + 1) * sizeof(int));
+        if (state->dirty == NULL) {
+            fprintf(stderr, "ERROR in memory allocation.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    double parse_time = omp_get_wtime() - parse_start;
+    double update_start = omp_get_wtime();
+
+    // Size the table for the players of the snapshot and for a new player in every goal row
+    long long n_events = 0;
+    for (int t = 0; t < n_threads; t++)
+        n_events += states[t].n_events;
+    PlayerTable table;
+    initPlayerTable(&table, n_players + n_events);
+
+    ScorerHeap heap;
+    heap.k = (k > 0) ? k : 0;
+    heap.size = 0;
+    heap.slots = (int*)malloc((heap.k + 1) * sizeof(int));
+    if (heap.slots == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+
+    // Load the players of the snapshot, restoring the heap if it was kept for the same k
+    int restore_heap = (snapshot_k == heap.k);
+    for (int i = 0; i < n_players; i++) {
+        char* separator = strchr(cursor, ';');
+        char* line_end = (separator != NULL) ? strchr(separator, '\n') : NULL;
+        if (line_end == NULL) {
+            fprintf(stderr, "File %s is not a snapshot.\n", snapshot_path);
+            return 1;
+        }
+        int length = (int)(line_end - separator - 1);
+        int slot = addPlayerGoals(&table, separator + 1, length, hashName(separator + 1, length), atoi(cursor), NULL);
+        if (restore_heap && i < heap_size) {
+            heap.slots[heap.size] = slot;
+            table.entries[slot].heap_index = heap.size++;
+        }
+        cursor = line_end + 1;
+    }
+    if (!restore_heap)
+        for (int i = 0; i < table.capacity; i++)
+            if (table.entries[i].state == SLOT_READY)
+                offerScorer(&heap, &table, i);
+
+    // Add the goals of the appended rows to the shared table
+    #pragma omp parallel num_threads(n_threads)
+    {
+        ThreadState* state = &states[omp_get_thread_num()];
+        for (long long e = 0; e < state->n_events; e++) {
+            GoalEvent* goal = &state->events[e];
+            addPlayerGoals(&table, goal->name, goal->length, goal->hash, goal->goals, state);
+        }
+    }
+
+    // Move the changed players of all the threads in the top-k
+    updateScorers(&heap, &table, states, n_threads);
+
+    double update_time = omp_get_wtime() - update_start;
+
+    // Print the top-k scorers with their goals: more goals first, then alphabetical order
+    PlayerEntry** scorers = (PlayerEntry**)malloc((heap.size + 1) * sizeof(PlayerEntry*));
+    if (scorers == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return 1;
+    }
+    for (int i = 0; i < heap.size; i++)
+        scorers[i] = &table.entries[heap.slots[i]];
+    qsort(scorers, heap.size, sizeof(PlayerEntry*), compareScorers);
+    for (int i = 0; i < heap.size; i++)
+        printf("%.*s\t%d\n", scorers[i]->length, scorers[i]->name, scorers[i]->goals);
+
+    // Save the state for the next run
+    double snapshot_start = omp_get_wtime();
+    int result = saveSnapshot(snapshot_path, file.size, &table, &heap);
+    double snapshot_time = omp_get_wtime() - snapshot_start;
+
+    double execution_time = omp_get_wtime() - execution_start;
+
+    long long rows = 0;
+    for (int t = 0; t < n_threads; t++)
+        rows += states[t].rows;
+
+    // Print the timing information
+    printf("Incremental;%d;%lld;%06f;%06f;%06f;%06f;\n", n_threads, rows, parse_time, update_time, snapshot_time, execution_time);
+
+    // Free allocated memory
+    for (int t = 0; t < n_threads; t++) {
+        free(states[t].events);
+        free(states[t].dirty);
+    }
+    free(states);
+    free(table.entries);
+    free(heap.slots);
+    free(scorers);
+    free(snapshot);
+    unmapFile(&file);
+
+    return (result == 0) ? 0 : 1;
+}
@@ -0,0 +1,303 @@
+/*
+ * Course: High Performance Computing 2023/2024
+ *
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Author:
+ * Ciaravola Giosuè		0622702177		g.ciaravola3@studenti.unisa.it
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This file is part of ProjectHPC.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "World_Cup_Columnar.h"
+//Constant for the time conversion
+#define SEC_CONV 1000000
+//Number of players on the field at the beginning of a match
+#define PLAYERS_ON_FIELD 11
+
+//Dictionary of the player names, used by the comparison function of the scorers
+static const WorldCupColumns* ranked_columns;
+//Goals of each player code, used by the comparison function of the scorers
+static const int* ranked_goals;
+
+/**
+ * @brief Calculates the duration between two time points and converts it to seconds.
+ *
+ * This function takes two `struct timeval` time points, calculates the duration between them,
+ * and converts the result to seconds for easier interpretation. It uses a conversion factor
+ * `SEC_CONV` to handle the microsecond part of the time.
+ *
+ * @param start The starting time point.
+ * @param stop  The ending time point.
+ *
+ * @return      The duration between the two time points in seconds.
+ */
+double getTotalTime(struct timeval start, struct timeval stop) {
+    unsigned long long start_time, stop_time;
+
+    // Convert timeval to microseconds
+    start_time = (unsigned long long)start.tv_sec * SEC_CONV + start.tv_usec;
+    stop_time = (unsigned long long)stop.tv_sec * SEC_CONV + stop.tv_usec;
+
+    // Calculate the duration in microseconds and convert it to seconds
+    return (double)(stop_time - start_time) / (double)SEC_CONV;
+}
+
+/**
+ * @brief Tells if an event is a goal for the player (goal or penalty).
+ */
+static int isGoal(const MatchEvent* event) {
+    return event->type == 'G' || event->type == 'P';
+}
+
+/**
+ * @brief Comparison function for qsort: more goals first, then alphabetical order of the name.
+ */
+static int compareScorers(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    if (ranked_goals[x] != ranked_goals[y])
+        return ranked_goals[y] - ranked_goals[x];
+    return strcmp(columnString(ranked_columns, DICTIONARY_PLAYER, x), columnString(ranked_columns, DICTIONARY_PLAYER, y));
+}
+
+/**
+ * @brief Converts the CSV dataset to the columnar format.
+ *
+ * @param csv_path      Path of the players dataset.
+ * @param columnar_path Path of the columnar file.
+ *
+ * @return              0 on success, 1 otherwise.
+ */
+int convertCommand(const char* csv_path, const char* columnar_path) {
+    struct timeval convert_start, convert_stop;
+    gettimeofday(&convert_start, NULL);
+
+    MappedFile csv;
+    if (mapFile(csv_path, &csv) != 0)
+        return 1;
+
+    WorldCupColumns columns;
+    if (buildWorldCupColumns(&csv, &columns) != 0) {
+        unmapFile(&csv);
+        return 1;
+    }
+    int result = saveWorldCupColumns(&columns, columnar_path);
+
+    gettimeofday(&convert_stop, NULL);
+
+    printf("Rows;%u;Matches;%u;Events;%u;Players;%u;CSV_bytes;%zu;Bytes;%zu;Convert_time;%06f\n",
+           columns.header->n_rows, columns.header->n_matches, columns.header->n_events,
+           columns.header->n_entries[DICTIONARY_PLAYER], csv.size, columns.blob_size,
+           getTotalTime(convert_start, convert_stop));
+
+    freeWorldCupColumns(&columns);
+    unmapFile(&csv);
+
+    return result == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Prints the top-k scorers with their goals (as the Hadoop job), reading only the
+ * player, MatchID and event columns.
+ */
+static int topScorers(const WorldCupColumns* columns, int k) {
+    const ColumnarHeader* header = columns->header;
+    uint32_t n_players = header->n_entries[DICTIONARY_PLAYER];
+    const uint32_t* player = columns->code[DICTIONARY_PLAYER];
+
+    // The dictionary codes are dense, so the goals are counted in an array
+    int* goals = (int*)calloc(n_players + 1, sizeof(int));
+    uint32_t* ranking = (uint32_t*)malloc((n_players + 1) * sizeof(uint32_t));
+    if (goals == NULL || ranking == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        free(goals);
+        free(ranking);
+        return -1;
+    }
+
+    for (uint32_t r = 0; r < header->n_rows; r++)
+        for (uint32_t e = columns->event_start[r]; e < columns->event_start[r + 1]; e++)
+            if (isGoal(&columns->events[e]))
+                goals[player[r]]++;
+
+    uint32_t n_scorers = 0;
+    for (uint32_t p = 0; p < n_players; p++)
+        if (goals[p] > 0)
+            ranking[n_scorers++] = p;
+
+    ranked_columns = columns;
+    ranked_goals = goals;
+    qsort(ranking, n_scorers, sizeof(uint32_t), compareScorers);
+    if ((uint32_t)k > n_scorers)
+        k = n_scorers;
+
+    // The goals of the top-k players, in the order of the rows (by MatchID)
+    for (int i = 0; i < k; i++) {
+        printf("%s\t", columnString(columns, DICTIONARY_PLAYER, ranking[i]));
+        for (uint32_t r = 0; r < header->n_rows; r++) {
+            if (player[r] != ranking[i])
+                continue;
+            int first = 1;
+            for (uint32_t e = columns->event_start[r]; e < columns->event_start[r + 1]; e++) {
+                if (!isGoal(&columns->events[e]))
+                    continue;
+                if (first)
+                    printf("{%d: ", columns->match_id[r]);
+                else
+                    printf(",");
+                printf("%c%d'", columns->events[e].type, columns->events[e].minute);
+                first = 0;
+            }
+            if (!first)
+                printf("}; ");
+        }
+        printf("\n");
+    }
+
+    free(goals);
+    free(ranking);
+    return 0;
+}
+
+/**
+ * @brief Prints the teams that won the most matches with the fewest players (as the Spark job),
+ * reading only the match index, team and event columns.
+ */
+static int winningTeams(const WorldCupColumns* columns) {
+    const ColumnarHeader* header = columns->header;
+    uint32_t n_teams = header->n_entries[DICTIONARY_TEAM];
+    const uint32_t* team = columns->code[DICTIONARY_TEAM];
+
+    // Wins of each team, for each number of players left on the field
+    int* wins = (int*)calloc((size_t)(n_teams + 1) * (PLAYERS_ON_FIELD + 1), sizeof(int));
+    if (wins == NULL) {
+        fprintf(stderr, "ERROR in memory allocation.\n");
+        return -1;
+    }
+
+    int min_players = PLAYERS_ON_FIELD + 1;
+    for (uint32_t m = 0; m < header->n_matches; m++) {
+        // The rows of a match are contiguous: collect the two teams, their goals and red cards
+        uint32_t match_team[2];
+        int match_goals[2] = { 0, 0 }, red_cards[2] = { 0, 0 }, teams = 0, valid = 1;
+        for (uint32_t r = columns->match_start[m]; r < columns->match_start[m + 1]; r++) {
+            int t = 0;
+            while (t < teams && match_team[t] != team[r])
+                t++;
+            if (t == teams) {
+                if (teams == 2) {
+                    valid = 0;
+                    continue;
+                }
+                match_team[teams++] = team[r];
+            }
+            for (uint32_t e = columns->event_start[r]; e < columns->event_start[r + 1]; e++) {
+                if (isGoal(&columns->events[e]))
+                    match_goals[t]++;
+                else if (columns->events[e].type == 'W')
+                    match_goals[t]--;
+                else if (columns->events[e].type == 'R')
+                    red_cards[t]++;
+            }
+        }
+
+        if (!valid || teams != 2 || match_goals[0] == match_goals[1])
+            continue;
+        int w = (match_goals[0] > match_goals[1]) ? 0 : 1;
+        int players = PLAYERS_ON_FIELD - red_cards[w];
+        if (players < 0)
+            players = 0;
+        wins[(size_t)match_team[w] * (PLAYERS_ON_FIELD + 1) + players]++;
+        if (players < min_players)
+            min_players = players;
+    }
+
+    if (min_players <= PLAYERS_ON_FIELD) {
+        int max_wins = 0;
+        for (uint32_t t = 0; t < n_teams; t++)
+            if (wins[(size_t)t * (PLAYERS_ON_FIELD + 1) + min_players] > max_wins)
+                max_wins = wins[(size_t)t * (PLAYERS_ON_FIELD + 1) + min_players];
+        for (uint32_t t = 0; t < n_teams; t++)
+            if (wins[(size_t)t * (PLAYERS_ON_FIELD + 1) + min_players] == max_wins)
+                printf("%s wins %d match/es with %d players\n", columnString(columns, DICTIONARY_TEAM, t), max_wins, min_players);
+    }
+
+    free(wins);
+    return 0;
+}
+
+/**
+ * @brief Maps the columnar file and runs the analytical queries on it.
+ *
+ * @param columnar_path Path of the columnar file.
+ * @param k             Number of top scorers.
+ *
+ * @return              0 on success, 1 otherwise.
+ */
+int queryCommand(const char* columnar_path, int k) {
+    struct timeval load_start, load_stop, query_start, query_stop;
+
+    // Map the columnar file
+    gettimeofday(&load_start, NULL);
+    WorldCupColumns columns;
+    if (loadWorldCupColumns(columnar_path, &columns) != 0)
+        return 1;
+    gettimeofday(&load_stop, NULL);
+
+    // Run the queries
+    gettimeofday(&query_start, NULL);
+    int result = topScorers(&columns, k);
+    if (result == 0)
+        result = winningTeams(&columns);
+    gettimeofday(&query_stop, NULL);
+
+    // Print the timing information (in microseconds)
+    printf("Columnar;Load_us;%.0f;Query_us;%.0f\n", getTotalTime(load_start, load_stop) * SEC_CONV,
+           getTotalTime(query_start, query_stop) * SEC_CONV);
+
+    freeWorldCupColumns(&columns);
+
+    return result == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Main function for the columnar World Cup dataset program.
+ *
+ * With "convert" it converts the players dataset to the columnar binary format (dictionary
+ * encoded strings, integer ids, pre-parsed events, rows sorted by MatchID); with "query" it maps
+ * a columnar file and computes the top-k scorers and the winning teams without any parsing.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line argument strings.
+ *
+ * @return Returns 0 on successful execution, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    if (argc == 4 && strcmp(argv[1], "convert") == 0)
+        return convertCommand(argv[2], argv[3]);
+
+    if (argc == 4 && strcmp(argv[1], "query") == 0)
+        return queryCommand(argv[2], atoi(argv[3]));
+
+    fprintf(stderr, "Usage: %s convert <players_csv> <columnar_file>\n", argv[0]);
+    fprintf(stderr, "       %s query <columnar_file> <k>\n", argv[0]);
+    return 1;
+}
@@ -1,32 +1,64 @@
 import os
 import shutil
 
+MEMORY_FIELDS=9#peak RSS (3 phases), allocated bytes (3 phases), thread allocated bytes, allocations, bytes per cell
+ENERGY_FIELDS=8#package joules (3 phases), DRAM joules (3 phases), average watts, cells per joule
+
 def analizeFile(sourceFile,resultFile):#analize the source file and save the information in the result file
     f=open(sourceFile,"r")#open file and read all its lines
     lines=f.readlines()
     data={}
     num={}
+    memory={}
+    memoryNum={}
+    energy={}
+    energyNum={}
     for line in lines:#for each line get the informations
-        type,omp,mpi,creationTime,communicationTime,executionTime,totalTime=line.strip()[:-1].split(";")
+        fields=line.strip()[:-1].split(";")
+        type,omp,mpi,creationTime,communicationTime,executionTime,totalTime=fields[:7]
         if type not in data:
             data[type]={}
             num[type]={}
+            memory[type]={}
+            memoryNum[type]={}
+            energy[type]={}
+            energyNum[type]={}
         if omp not in data[type]:
             data[type][omp]={}
             num[type][omp]={}
+            memory[type][omp]={}
+            memoryNum[type][omp]={}
+            energy[type][omp]={}
+            energyNum[type][omp]={}
         if mpi not in data[type][omp]:
             data[type][omp][mpi]=[float(creationTime),float(communicationTime),float(executionTime),float(totalTime)]
             num[type][omp][mpi]=1
+            memory[type][omp][mpi]=[0.0]*MEMORY_FIELDS
+            memoryNum[type][omp][mpi]=0
+            energy[type][omp][mpi]=[0.0]*ENERGY_FIELDS
+            energyNum[type][omp][mpi]=[0]*ENERGY_FIELDS
         else:
             data[type][omp][mpi][0]+=float(creationTime)
             data[type][omp][mpi][1]+=float(communicationTime)
             data[type][omp][mpi][2]+=float(executionTime)
             data[type][omp][mpi][3]+=float(totalTime)
             num[type][omp][mpi]+=1
+        if len(fields)>=7+MEMORY_FIELDS:#memory columns (the older lines have only the times)
+            for i in range(MEMORY_FIELDS):
+                memory[type][omp][mpi][i]+=float(fields[7+i])
+            memoryNum[type][omp][mpi]+=1
+        for i in range(min(ENERGY_FIELDS,len(fields)-7-MEMORY_FIELDS)):#energy columns, empty when the counters cannot be read
+            if fields[7+MEMORY_FIELDS+i]!="":
+                energy[type][omp][mpi][i]+=float(fields[7+MEMORY_FIELDS+i])
+                energyNum[type][omp][mpi][i]+=1
     f.close()#close the source file and open the result file
     f=open(resultFile,"w")
     
-    f.write("Modality;OMP;MPI;String_generation_time;Communication_time;Edit_distance_time;Program_execution_time;speedup;efficiency\n")
+    f.write("Modality;OMP;MPI;String_generation_time;Communication_time;Edit_distance_time;Program_execution_time;speedup;efficiency;"
+            "Generation_peak_RSS;Partitioning_peak_RSS;Kernel_peak_RSS;Generation_allocated;Partitioning_allocated;"
+            "Kernel_allocated;Kernel_thread_allocated;Allocations;Bytes_per_cell;"
+            "Generation_package_J;Partitioning_package_J;Kernel_package_J;Generation_DRAM_J;Partitioning_DRAM_J;"
+            "Kernel_DRAM_J;Average_W;Cells_per_J\n")
     for typeKey in data.keys():#for each element in the dictionary calculate the mean and save it in the result file
         ompList=list(data[typeKey].keys())
         ompList.sort(key=int)
@@ -39,21 +71,31 @@ def analizeFile(sourceFile,resultFile):#analize the source file and save the inf
                 data[typeKey][ompKey][mpiKey][1]/=it
                 data[typeKey][ompKey][mpiKey][2]/=it
                 data[typeKey][ompKey][mpiKey][3]/= it
-                t_serial = data["Approximate"][ompKey][mpiKey][3]
-                t_parallel_single = data["OMP+MPI"][ompKey][mpiKey][3]
-                speedup = t_serial / data[typeKey][ompKey][mpiKey][3]
-                if typeKey != "Approximate":
-                    efficiency = t_serial/(int(ompKey)*int(mpiKey)*data[typeKey][ompKey][mpiKey][3])*100
-                else:
-                    efficiency = (t_serial/t_serial)*100
                 formatted_line = (
                     f"{typeKey};{ompKey};{mpiKey};"
                     f"{data[typeKey][ompKey][mpiKey][0]:.8f};"
                     f"{data[typeKey][ompKey][mpiKey][1]:.8f};"
                     f"{data[typeKey][ompKey][mpiKey][2]:.8f};"
                     f"{data[typeKey][ompKey][mpiKey][3]:.8f};"
-                    f"{speedup:.8f};{efficiency:.4f}\n"
                 )
+                if mpiKey in data.get("Approximate",{}).get(ompKey,{}):#speedup and efficiency, empty without an Approximate run of the same configuration (e.g. the tuned number of threads)
+                    t_serial = data["Approximate"][ompKey][mpiKey][3]
+                    speedup = t_serial / data[typeKey][ompKey][mpiKey][3]
+                    if typeKey != "Approximate":
+                        efficiency = t_serial/(int(ompKey)*int(mpiKey)*data[typeKey][ompKey][mpiKey][3])*100
+                    else:
+                        efficiency = (t_serial/t_serial)*100
+                    formatted_line+=f"{speedup:.8f};{efficiency:.4f};"
+                else:
+                    formatted_line+=";;"
+                memoryIt=memoryNum[typeKey][ompKey][mpiKey]
+                if memoryIt>0:#mean of the memory columns, empty if there are none
+                    values=[v/memoryIt for v in memory[typeKey][ompKey][mpiKey]]
+                    formatted_line+=";".join(f"{v:.0f}" for v in values[:-1])+f";{values[-1]:.6f};"
+                else:
+                    formatted_line+=";"*MEMORY_FIELDS
+                counts=energyNum[typeKey][ompKey][mpiKey]#mean of each energy column, empty if there are none
+                formatted_line+=";".join(f"{v/c:.6f}" if c>0 else "" for v,c in zip(energy[typeKey][ompKey][mpiKey],counts))+"\n"
                 f.write(formatted_line)
     f.close()#close the result file
 
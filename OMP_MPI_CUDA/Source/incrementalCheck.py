@@ -0,0 +1,83 @@
+import os
+import sys
+import random
+import tempfile
+import subprocess
+
+HEADER="RoundID,MatchID,Team Initials,Coach Name,Line-up,Shirt Number,Player Name,Position,Event\n"
+PLAYERS=30#number of distinct players of the generated rows, few so that the top-k changes often
+EVENTS=["G10'","P20'","OG30'","Y40'","I50'","O60'"]#goals (G) and penalties (P) count, the others do not
+
+def generateRows(rng,n):#random rows of the players dataset
+    rows=[]
+    for r in range(n):
+        events=" ".join(rng.choice(EVENTS) for e in range(rng.randint(0,3)))
+        rows.append(f"201,{1000+r},ITA,COACH,S,{r%23},P{rng.randrange(PLAYERS):02d},,{events}\n")
+    return rows
+
+def countGoals(rows):#full recount of the goals of every player
+    goals={}
+    for row in rows:
+        fields=row.rstrip("\n").split(",")
+        if fields[1]=="":
+            continue
+        scored=sum(1 for event in fields[8].split(" ") if event!="" and event[0] in "GP")
+        if scored>0:
+            goals[fields[6]]=goals.get(fields[6],0)+scored
+    return goals
+
+def topK(goals,k):#more goals first, then the name in byte order, as World_Cup_Incremental
+    return sorted(goals.items(),key=lambda item:(-item[1],item[0].encode()))[:k]
+
+def runTool(tool,csvFile,snapshotFile,k,threads):#top-k printed by the tool, as (name,goals) pairs
+    output=subprocess.run([tool,csvFile,snapshotFile,str(k),str(threads)],capture_output=True,text=True,check=True).stdout
+    scorers=[]
+    for line in output.splitlines():
+        if "\t" in line:
+            name,goals=line.split("\t")
+            scorers.append((name,int(goals)))
+    return scorers
+
+def checkRun(tool,folder,rng,run,k,threadCounts):#append the rows in chunks, comparing each update with a full rescan and a recount
+    rows=generateRows(rng,rng.randint(50,400))
+    cuts=sorted(rng.sample(range(1,len(rows)),rng.randint(0,5)))+[len(rows)]
+    csvFile=os.path.join(folder,f"players{run}.csv")
+    snapshotFile=os.path.join(folder,f"snapshot{run}.txt")
+    rescanFile=os.path.join(folder,f"rescan{run}.txt")
+    f=open(csvFile,"w")
+    f.write(HEADER)
+    f.close()
+    first=0
+    for cut in cuts:
+        f=open(csvFile,"a")
+        f.writelines(rows[first:cut])
+        f.close()
+        first=cut
+        threads=rng.choice(threadCounts)
+        incremental=runTool(tool,csvFile,snapshotFile,k,threads)
+        if os.path.exists(rescanFile):
+            os.remove(rescanFile)
+        rescan=runTool(tool,csvFile,rescanFile,k,threads)
+        expected=topK(countGoals(rows[:cut]),k)
+        if incremental!=expected or rescan!=expected:
+            print(f"Run {run}, {cut} rows, {threads} threads: incremental {incremental}, rescan {rescan}, expected {expected}")
+            return False
+    return True
+
+if len(sys.argv)<5:
+    print("Usage: python3 incrementalCheck.py <incremental_executable> <runs> <k> <n_threads> [n_threads...]")
+    sys.exit(1)
+tool=os.path.abspath(sys.argv[1])
+runs=int(sys.argv[2])
+k=int(sys.argv[3])
+threadCounts=[int(t) for t in sys.argv[4:]]
+rng=random.Random(1)
+failures=0
+with tempfile.TemporaryDirectory() as folder:
+    for run in range(runs):
+        if not checkRun(tool,folder,rng,run,rng.randint(1,k),threadCounts):
+            failures+=1
+if failures>0:
+    print(f"FAILED: {failures} of {runs} runs")
+    sys.exit(1)
+print(f"PASSED: {runs} runs")
@@ -0,0 +1,150 @@
+import os
+import sys
+import math
+import itertools
+
+ALPHA=0.05#significance level of the test
+DEFAULT_THRESHOLD=0.10#maximum accepted drop of the throughput (10%)
+EXACT_LIMIT=20000#maximum number of rank assignments of the exact test
+
+def readInformations(folder):#read the timing lines of an Informations folder (opt*/<characters>.csv) as {(opt,characters,type,omp,mpi): [edit distance times]}
+    samples={}
+    for path, currentDirectory, files in os.walk(folder):
+        opt=os.path.basename(path)
+        if not opt.startswith("opt"):
+            continue
+        for file in sorted(files):
+            if not file.endswith(".csv"):
+                continue
+            characters=file[:-4]
+            f=open(os.path.join(path,file),"r")
+            for line in f.readlines():
+                fields=line.strip().rstrip(";").split(";")
+                if len(fields)<7:
+                    continue
+                key=(opt[3:],characters,fields[0],fields[1],fields[2])
+                samples.setdefault(key,[]).append(float(fields[5]))
+            f.close()
+    return samples
+
+def readBaseline(baselineFile):#read a baseline file written by saveBaseline
+    samples={}
+    f=open(baselineFile,"r")
+    lines=f.readlines()[1:]#skip the header
+    for line in lines:
+        opt,characters,type,omp,mpi,times=line.strip().split(";")
+        samples[(opt,characters,type,omp,mpi)]=[float(t) for t in times.split(",")]
+    f.close()
+    return samples
+
+def saveBaseline(samples,baselineFile):#save all the samples of each configuration, so the test can be repeated on them
+    folder=os.path.dirname(baselineFile)
+    if folder!="" and not(os.path.exists(folder)):
+        os.makedirs(folder)
+    f=open(baselineFile,"w")
+    f.write("Opt;Characters;Modality;OMP;MPI;Edit_distance_times\n")
+    for key in sorted(samples.keys(),key=sortKey):
+        f.write(";".join(key)+";"+",".join(f"{t:.6f}" for t in samples[key])+"\n")
+    f.close()
+
+def sortKey(key):#order the configurations by opt, characters, modality, omp and mpi
+    opt,characters,type,omp,mpi=key
+    return (int(opt),int(characters),type,int(omp),int(mpi))
+
+def median(values):
+    values=sorted(values)
+    n=len(values)
+    return values[n//2] if n%2==1 else (values[n//2-1]+values[n//2])/2
+
+def medianInterval(values):#95% distribution-free confidence interval of the median, from the order statistics
+    values=sorted(values)
+    n=len(values)
+    k=0
+    cumulative=0.0
+    while True:#largest k with P(Binomial(n,1/2) <= k-1) <= alpha/2
+        cumulative+=math.comb(n,k)/2**n
+        if cumulative>ALPHA/2:
+            break
+        k+=1
+    if k==0:#too few samples: the whole range
+        return values[0],values[-1]
+    return values[k-1],values[n-k]
+
+def uStatistic(first,second):#number of pairs where the time of the first sample is greater (ties count one half)
+    u=0.0
+    for a in first:
+        for b in second:
+            if a>b:
+                u+=1
+            elif a==b:
+                u+=0.5
+    return u
+
+def mannWhitney(new,base):#one-sided p-value of the Mann-Whitney U test that the new times are greater than the baseline times
+    n1=len(new)
+    n2=len(base)
+    u=uStatistic(new,base)
+    values=new+base
+    if math.comb(n1+n2,n1)<=EXACT_LIMIT:#exact test: every assignment of the values to the two samples
+        count=0
+        total=0
+        for chosen in itertools.combinations(range(n1+n2),n1):
+            selected=set(chosen)
+            first=[values[i] for i in chosen]
+            second=[values[i] for i in range(n1+n2) if i not in selected]
+            if uStatistic(first,second)>=u:
+                count+=1
+            total+=1
+        return count/total
+    ties={}#normal approximation with the tie correction
+    for v in values:
+        ties[v]=ties.get(v,0)+1
+    n=n1+n2
+    correction=sum(t**3-t for t in ties.values())/(n*(n-1))
+    sd=math.sqrt(n1*n2/12*((n+1)-correction))
+    if sd==0:
+        return 1.0
+    z=(u-n1*n2/2-0.5)/sd
+    return 0.5*math.erfc(z/math.sqrt(2))
+
+def compare(baseline,current,threshold):#compare each configuration and print the report, return the number of regressions
+    print("Opt;Characters;Modality;OMP;MPI;Baseline_median;Baseline_CI;New_median;New_CI;Throughput_change;p_value;Status")
+    regressions=0
+    for key in sorted(set(baseline.keys())|set(current.keys()),key=sortKey):
+        if key not in current or key not in baseline:
+            status="MISSING_NEW" if key not in current else "MISSING_BASELINE"
+            print(";".join(key)+";;;;;;;"+status)
+            continue
+        base=baseline[key]
+        new=current[key]
+        baseMedian=median(base)
+        newMedian=median(new)
+        baseLow,baseHigh=medianInterval(base)
+        newLow,newHigh=medianInterval(new)
+        change=baseMedian/newMedian-1#throughput (characters^2/time) of the new build relative to the baseline
+        p=mannWhitney(new,base)
+        if change<-threshold and p<ALPHA:
+            status="REGRESSION"
+            regressions+=1
+        elif change<-threshold:
+            status="NOT_SIGNIFICANT"
+        else:
+            status="OK"
+        print(";".join(key)+f";{baseMedian:.6f};[{baseLow:.6f}-{baseHigh:.6f}];{newMedian:.6f};[{newLow:.6f}-{newHigh:.6f}];{change*100:+.2f}%;{p:.4f};{status}")
+    return regressions
+
+if len(sys.argv)>=4 and sys.argv[1]=="save":#save the samples of an Informations folder as the baseline
+    samples=readInformations(sys.argv[2])
+    saveBaseline(samples,sys.argv[3])
+    print(f"Baseline {sys.argv[3]} saved with {len(samples)} configurations")
+elif len(sys.argv)>=4 and sys.argv[1]=="check":#compare an Informations folder with the baseline
+    threshold=float(sys.argv[4]) if len(sys.argv)>=5 else DEFAULT_THRESHOLD
+    regressions=compare(readBaseline(sys.argv[3]),readInformations(sys.argv[2]),threshold)
+    if regressions>0:
+        print(f"FAILED: {regressions} configuration/s with a throughput drop over {threshold*100:.0f}% (p < {ALPHA})")
+        sys.exit(1)
+    print("PASSED")
+else:
+    print("Usage: python3 regressionCheck.py save <informations_folder> <baseline_file>")
+    print("       python3 regressionCheck.py check <informations_folder> <baseline_file> [threshold]")
+    sys.exit(1)
@@ -0,0 +1,20 @@
+import sys
+
+def replicateDataset(sourceFile,resultFile,copies):#write the header once and the data rows "copies" times
+    f=open(sourceFile,"r")
+    lines=f.readlines()
+    f.close()
+    f=open(resultFile,"w")
+    f.write(lines[0])
+    for copy in range(copies):#each copy gets its own MatchIDs, so the matches stay distinct
+        for line in lines[1:]:
+            fields=line.split(",")
+            if len(fields)>1 and fields[1].isdigit():
+                fields[1]=str(int(fields[1])+copy*1000000)
+            f.write(",".join(fields).rstrip("\n")+"\n")
+    f.close()
+
+if len(sys.argv)!=4:
+    print("Usage: python replicateDataset.py <players_csv> <output_csv> <copies>")
+    sys.exit(1)
+replicateDataset(sys.argv[1],sys.argv[2],int(sys.argv[3]))
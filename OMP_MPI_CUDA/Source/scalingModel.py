@@ -0,0 +1,204 @@
+import os
+import sys
+import math
+
+MEMORY_FIELDS=9#peak RSS (3 phases), allocated bytes (3 phases), thread allocated bytes, allocations, bytes per cell
+MATRIX_CELL_BYTES=4#bytes of a cell of the distance matrix, used for the memory when the data has no memory columns
+MAX_THREADS=8#default largest number of threads of the recommendation
+MAX_RANKS=4#default largest number of processes of the recommendation
+MAX_MODEL_ERROR=0.5#mean error of the wall time above which the predictions of a model are not trusted
+
+def totalCells(backend,n,omp,mpi):#DP cells computed by all the workers of a run
+    p=omp*mpi
+    if backend.startswith("Exact"):#each partition of the first string against the whole second string
+        return n*n
+    return p*(n/p)**2#OMP+MPI and Approximate: one partition of both strings for each worker
+
+def memoryCells(backend,n,omp,mpi):#DP cells held in memory at the same time by all the workers
+    p=omp*mpi
+    if backend=="Approximate":#one partition at a time
+        return (n/p)**2
+    if backend.startswith("Exact"):#the seaweeds of a partition are linear in the lengths
+        return p*(n/p+n)
+    return p*(n/p)**2
+
+def workers(backend,omp,mpi):#cores used by a run
+    return 1 if backend=="Approximate" else omp*mpi
+
+def readInformations(folder,opt):#read the lines of Informations/<mode>/opt<opt>/<characters>.csv as a list of runs
+    runs=[]
+    optFolder=os.path.join(folder,f"opt{opt}")
+    for file in sorted(os.listdir(optFolder)):
+        if not file.endswith(".csv"):
+            continue
+        n=int(file[:-4])
+        f=open(os.path.join(optFolder,file),"r")
+        for line in f.readlines():
+            fields=line.strip().rstrip(";").split(";")
+            if len(fields)<7:
+                continue
+            run={"backend":fields[0],"n":n,"omp":int(fields[1]),"mpi":int(fields[2]),"create":float(fields[3]),"comm":float(fields[4]),"ed":float(fields[5]),"total":float(fields[6])}
+            if len(fields)>=7+MEMORY_FIELDS:#memory columns (the older lines have only the times)
+                run["rss"]=max(float(fields[7]),float(fields[8]),float(fields[9]))
+            runs.append(run)
+        f.close()
+    return runs
+
+def leastSquares(rows,targets):#solve the normal equations (with a tiny ridge term) by Gaussian elimination
+    k=len(rows[0])
+    a=[[sum(r[i]*r[j] for r in rows)+(1e-12 if i==j else 0.0) for j in range(k)] for i in range(k)]
+    b=[sum(r[i]*t for r,t in zip(rows,targets)) for i in range(k)]
+    for c in range(k):
+        pivot=max(range(c,k),key=lambda r:abs(a[r][c]))
+        a[c],a[pivot]=a[pivot],a[c]
+        b[c],b[pivot]=b[pivot],b[c]
+        if a[c][c]==0:
+            continue
+        for r in range(c+1,k):
+            factor=a[r][c]/a[c][c]
+            for j in range(c,k):
+                a[r][j]-=factor*a[c][j]
+            b[r]-=factor*b[c]
+    x=[0.0]*k
+    for c in range(k-1,-1,-1):
+        x[c]=(b[c]-sum(a[c][j]*x[j] for j in range(c+1,k)))/a[c][c] if a[c][c]!=0 else 0.0
+    return x
+
+def nonNegativeFit(xs,ys):#least squares of y = intercept + slope * x with intercept >= 0 and slope >= 0
+    intercept,slope=leastSquares([[1.0,x] for x in xs],ys)
+    if intercept>=0 and slope>=0:
+        return intercept,slope
+    #otherwise the best fit is on a border: only the intercept or only the slope
+    borders=[(max(0.0,sum(ys)/len(ys)),0.0)]
+    sxx=sum(x*x for x in xs)
+    if sxx>0:
+        borders.append((0.0,max(0.0,sum(x*y for x,y in zip(xs,ys))/sxx)))
+    return min(borders,key=lambda c:sum((c[0]+c[1]*x-y)**2 for x,y in zip(xs,ys)))
+
+def fitBackend(runs):#fit the models of a backend on its runs
+    model={}
+    #cost per cell: time of a single worker divided by its cells (all the sizes)
+    single=[r for r in runs if r["omp"]*r["mpi"]==1]
+    base=single if len(single)>0 else runs
+    model["cell_time"]=sum(r["ed"]-r["comm"] for r in base)/sum(totalCells(r["backend"],r["n"],r["omp"],r["mpi"]) for r in base)
+    model["throughput"]=1/model["cell_time"]
+    #communication: latency and bandwidth terms of a tree with log2(mpi) levels
+    rows=[[math.ceil(math.log2(r["mpi"])),math.ceil(math.log2(r["mpi"]))*r["n"]] for r in runs]
+    model["comm"]=[max(0.0,c) for c in leastSquares(rows,[r["comm"] for r in runs])] if any(r["mpi"]>1 for r in runs) else [0.0,0.0]
+    #generation of the strings, linear in the characters
+    model["create_time"]=sum(r["create"] for r in runs)/sum(r["n"] for r in runs)
+    #Amdahl: 1/speedup = f + (1-f)/p, with the speedup over the time of all the cells on a single core
+    xs=[]
+    ys=[]
+    for r in runs:
+        p=workers(r["backend"],r["omp"],r["mpi"])
+        compute=r["ed"]-r["comm"]
+        if p>1 and compute>0:
+            xs.append(1/p)
+            ys.append(compute/(model["cell_time"]*totalCells(r["backend"],r["n"],r["omp"],r["mpi"])))
+    intercept,slope=nonNegativeFit(xs,ys) if len(xs)>0 else (0.0,0.0)
+    if intercept+slope>0:#a negative scale would predict negative times
+        model["serial_fraction"]=min(1.0,intercept/(intercept+slope))
+        model["amdahl_scale"]=intercept+slope#time of 1 worker over the cell model (1 if the cell cost does not change with p)
+        speedups=[1/y for y in ys]
+        model["gustafson_fraction"]=sum((1/x-s)/(1/x-1) for x,s in zip(xs,speedups))/len(xs)#scaled speedup S = p - f(p-1)
+    else:#no usable parallel runs or no valid fit: the single-worker model with a perfect split
+        model["serial_fraction"]=0.0
+        model["amdahl_scale"]=1.0
+        model["gustafson_fraction"]=0.0
+    #memory: per process and per cell held in memory, when the runs have the memory columns
+    measured=[r for r in runs if "rss" in r]
+    if len(measured)>0:
+        rows=[[r["mpi"],memoryCells(r["backend"],r["n"],r["omp"],r["mpi"])] for r in measured]
+        model["memory"]=[max(0.0,c) for c in leastSquares(rows,[r["rss"] for r in measured])]
+        model["memory_measured"]=True
+    else:
+        model["memory"]=[0.0,MATRIX_CELL_BYTES]
+        model["memory_measured"]=False
+    #mean absolute error of the wall time on the runs
+    errors=[abs(predictTime(model,r["backend"],r["n"],r["omp"],r["mpi"])-r["total"])/r["total"] for r in runs if r["total"]>0]
+    model["error"]=sum(errors)/len(errors) if len(errors)>0 else 0.0
+    model["trusted"]=model["error"]<=MAX_MODEL_ERROR
+    return model
+
+def predictTime(model,backend,n,omp,mpi):#predicted wall time of a run
+    p=workers(backend,omp,mpi)
+    f=model["serial_fraction"]
+    scale=model["amdahl_scale"] if p>1 else 1.0
+    compute=model["cell_time"]*totalCells(backend,n,omp,mpi)*scale*(f+(1-f)/p)
+    levels=math.ceil(math.log2(mpi)) if mpi>1 else 0
+    comm=model["comm"][0]*levels+model["comm"][1]*levels*n
+    return model["create_time"]*n+compute+comm
+
+def predictMemory(model,backend,n,omp,mpi):#predicted peak RSS (bytes, summed over the processes) of a run
+    return model["memory"][0]*mpi+model["memory"][1]*memoryCells(backend,n,omp,mpi)+2*(n+1)*mpi#plus the strings of each process
+
+def fitModels(folder,opt):#fit a model for each backend in the data
+    runs=readInformations(folder,opt)
+    backends={}
+    for r in runs:
+        backends.setdefault(r["backend"],[]).append(r)
+    return {backend:fitBackend(backendRuns) for backend,backendRuns in backends.items()}
+
+def printModels(models):
+    print("Backend;Cell_time_ns;Throughput_Mcells/s;Serial_fraction;Gustafson_fraction;Comm_latency_s;Comm_s/char;Memory_process_B;Memory_B/cell;Memory_measured;Mean_error;Trusted")
+    for backend in sorted(models.keys()):
+        m=models[backend]
+        print(f"{backend};{m['cell_time']*1e9:.4f};{m['throughput']/1e6:.2f};{m['serial_fraction']:.4f};{m['gustafson_fraction']:.4f};{m['comm'][0]:.6f};{m['comm'][1]:.3e};{m['memory'][0]:.0f};{m['memory'][1]:.3f};{m['memory_measured']};{m['error']*100:.1f}%;{m['trusted']}")
+
+def recommend(models,n,deadline,maxThreads,maxRanks,backends):#cheapest configuration (cores x time) that meets the deadline
+    for backend in backends:
+        if not models[backend]["trusted"]:
+            print(f"The model of {backend} has a mean error of {models[backend]['error']*100:.1f}%: its predictions are not trusted")
+    candidates=[]
+    omp=1
+    while omp<=maxThreads:
+        mpi=1
+        while mpi<=maxRanks:
+            for backend in backends:
+                time=predictTime(models[backend],backend,n,omp,mpi)
+                if time<=0:#not a valid prediction
+                    continue
+                cost=workers(backend,omp,mpi)*time
+                candidates.append((cost,time,backend,omp,mpi))
+            mpi*=2
+        omp*=2
+    if len(candidates)==0:
+        print("No configuration has a valid prediction")
+        return 1
+    candidates.sort()
+    print("Backend;OMP;MPI;Predicted_time;Core_seconds;Predicted_memory_MB;Deadline")
+    for cost,time,backend,omp,mpi in candidates:
+        memory=predictMemory(models[backend],backend,n,omp,mpi)/(1024*1024)
+        print(f"{backend};{omp};{mpi};{time:.6f};{cost:.6f};{memory:.1f};{'MET' if time<=deadline else 'MISSED'}")
+    met=[c for c in candidates if c[1]<=deadline and models[c[2]]["trusted"]]#the trusted models first
+    met+=[c for c in candidates if c[1]<=deadline and not models[c[2]]["trusted"]]
+    if len(met)==0:
+        fastest=min(candidates,key=lambda c:c[1])
+        print(f"No configuration meets the deadline of {deadline}s: the fastest is {fastest[2]} with {fastest[3]} threads and {fastest[4]} processes ({fastest[1]:.6f}s)")
+        return 1
+    cost,time,backend,omp,mpi=met[0]
+    print(f"Recommended: {backend} with {omp} threads and {mpi} processes ({time:.6f}s, {cost:.6f} core-seconds){'' if models[backend]['trusted'] else ', from an untrusted model'}")
+    return 0
+
+if len(sys.argv)>=4 and sys.argv[1]=="fit":#print the fitted models of an Informations folder
+    printModels(fitModels(sys.argv[2],int(sys.argv[3])))
+elif len(sys.argv)>=8 and sys.argv[1]=="predict":#predict the time and the memory of a planned run
+    models=fitModels(sys.argv[2],int(sys.argv[3]))
+    n,omp,mpi,backend=int(sys.argv[4]),int(sys.argv[5]),int(sys.argv[6]),sys.argv[7]
+    if backend not in models:
+        print(f"No runs of {backend} in {sys.argv[2]}: {', '.join(sorted(models.keys()))}")
+        sys.exit(1)
+    print("Backend;Characters;OMP;MPI;Predicted_time;Predicted_memory_MB")
+    print(f"{backend};{n};{omp};{mpi};{predictTime(models[backend],backend,n,omp,mpi):.6f};{predictMemory(models[backend],backend,n,omp,mpi)/(1024*1024):.1f}")
+elif len(sys.argv)>=6 and sys.argv[1]=="recommend":#cheapest configuration that meets a deadline
+    models=fitModels(sys.argv[2],int(sys.argv[3]))
+    maxThreads=int(sys.argv[6]) if len(sys.argv)>=7 else MAX_THREADS
+    maxRanks=int(sys.argv[7]) if len(sys.argv)>=8 else MAX_RANKS
+    backends=[sys.argv[8]] if len(sys.argv)>=9 else sorted(models.keys())
+    sys.exit(recommend(models,int(sys.argv[4]),float(sys.argv[5]),maxThreads,maxRanks,backends))
+else:
+    print("Usage: python3 scalingModel.py fit <informations_folder> <opt>")
+    print("       python3 scalingModel.py predict <informations_folder> <opt> <n_characters> <omp_threads> <mpi_process> <backend>")
+    print("       python3 scalingModel.py recommend <informations_folder> <opt> <n_characters> <deadline_s> [max_threads] [max_process] [backend]")
+    sys.exit(1)